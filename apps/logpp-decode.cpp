@@ -0,0 +1,154 @@
+// Renders binary logs written by a BinaryFileSink as text
+//
+//   logpp-decode [--format pattern|logfmt|json] [--pattern PATTERN] [FILE...]
+//
+// Logs are read from the standard input when no file is given
+
+#include "logpp/format/BinaryDecoder.h"
+#include "logpp/format/JsonFormatter.h"
+#include "logpp/format/LogFmtFormatter.h"
+#include "logpp/format/PatternFormatter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr size_t ChunkSize = 64 * 1024;
+
+    void usage(const char* program)
+    {
+        std::cerr << "Usage: " << program << " [--format pattern|logfmt|json] [--pattern PATTERN] [FILE...]\n";
+    }
+
+    std::shared_ptr<logpp::Formatter> createFormatter(std::string_view format, const char* pattern)
+    {
+        if (format == "pattern")
+        {
+            if (pattern)
+                return std::make_shared<logpp::PatternFormatter>(pattern);
+            return std::make_shared<logpp::PatternFormatter>();
+        }
+        if (format == "logfmt")
+            return std::make_shared<logpp::LogFmtFormatter>();
+        if (format == "json")
+            return std::make_shared<logpp::JsonFormatter>();
+
+        return nullptr;
+    }
+
+    bool decode(std::istream& in, std::string_view source, logpp::Formatter& formatter)
+    {
+        logpp::BinaryDecoder decoder;
+        fmt::memory_buffer out;
+
+        auto onEvent = [&](std::string_view name, logpp::LogLevel level, const logpp::EventLogBuffer& buffer) {
+            formatter.format(name, level, buffer, out);
+            out.push_back('\n');
+        };
+
+        // Records can span multiple chunks, undecoded bytes are kept for the next read
+        std::vector<char> data;
+        size_t size = 0;
+
+        try
+        {
+            while (in)
+            {
+                data.resize(size + ChunkSize);
+                in.read(data.data() + size, ChunkSize);
+                size += static_cast<size_t>(in.gcount());
+
+                auto decoded = decoder.decode(data.data(), size, onEvent);
+                std::memmove(data.data(), data.data() + decoded, size - decoded);
+                size -= decoded;
+
+                std::fwrite(out.data(), 1, out.size(), stdout);
+                out.clear();
+            }
+        }
+        catch (const logpp::BinaryFormatError& e)
+        {
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            std::cerr << source << ": " << e.what() << '\n';
+            return false;
+        }
+
+        if (size > 0)
+        {
+            std::cerr << source << ": truncated record at end of log\n";
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string_view format = "pattern";
+    const char* pattern     = nullptr;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if ((arg == "--format" || arg == "--pattern") && i + 1 < argc)
+        {
+            if (arg == "--format")
+                format = argv[++i];
+            else
+                pattern = argv[++i];
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+
+    auto formatter = createFormatter(format, pattern);
+    if (!formatter)
+    {
+        std::cerr << "Unknown format " << format << '\n';
+        usage(argv[0]);
+        return 2;
+    }
+
+    bool ok = true;
+    if (files.empty())
+    {
+        ok = decode(std::cin, "<stdin>", *formatter);
+    }
+    else
+    {
+        for (const auto* file : files)
+        {
+            std::ifstream in(file, std::ios::binary);
+            if (!in)
+            {
+                std::cerr << file << ": could not open file\n";
+                ok = false;
+                continue;
+            }
+
+            ok &= decode(in, file, *formatter);
+        }
+    }
+
+    std::fflush(stdout);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include "logpp/core/Clock.h"
+#include "logpp/core/Logger.h"
+#include "logpp/format/PatternFormatter.h"
+
+// Formats a single flag of a pattern, to track the cost of every built-in flag formatter
+
+static void FlagFormatterBench(benchmark::State& state, const char* pattern)
+{
+    logpp::PatternFormatter formatter(pattern);
+
+    logpp::EventLogBuffer buffer;
+    buffer.writeTime(logpp::Clock::now());
+    buffer.writeThreadId(logpp::thread_utils::getCurrentId());
+    buffer.writeText("Benchmarking flag formatters");
+    buffer.writeSourceLocation(logpp::SourceLocation { __FILE__, __LINE__ });
+    buffer.writeFields(
+        logpp::field("Int", 0xBAD),
+        logpp::field("UInt", 42u),
+        logpp::field("Str", "value"));
+
+    fmt::memory_buffer out;
+    for (auto _ : state)
+    {
+        out.clear();
+        formatter.format("FlagFormatterBench", logpp::LogLevel::Info, buffer, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+BENCHMARK_CAPTURE(FlagFormatterBench, Year, "%Y");
+BENCHMARK_CAPTURE(FlagFormatterBench, Month, "%m");
+BENCHMARK_CAPTURE(FlagFormatterBench, Day, "%d");
+BENCHMARK_CAPTURE(FlagFormatterBench, Hours, "%H");
+BENCHMARK_CAPTURE(FlagFormatterBench, Minutes, "%M");
+BENCHMARK_CAPTURE(FlagFormatterBench, Seconds, "%S");
+BENCHMARK_CAPTURE(FlagFormatterBench, Milliseconds, "%i");
+BENCHMARK_CAPTURE(FlagFormatterBench, Microseconds, "%u");
+BENCHMARK_CAPTURE(FlagFormatterBench, LocalTimestamp, "%L%Y-%m-%d %H:%M:%S");
+BENCHMARK_CAPTURE(FlagFormatterBench, Thread, "%t");
+BENCHMARK_CAPTURE(FlagFormatterBench, Text, "%v");
+BENCHMARK_CAPTURE(FlagFormatterBench, Level, "%l");
+BENCHMARK_CAPTURE(FlagFormatterBench, Name, "%n");
+BENCHMARK_CAPTURE(FlagFormatterBench, SourceFile, "%p");
+BENCHMARK_CAPTURE(FlagFormatterBench, SourceLine, "%o");
+BENCHMARK_CAPTURE(FlagFormatterBench, Fields, "%f");
+BENCHMARK_CAPTURE(FlagFormatterBench, Full, "%+");
+
+BENCHMARK_MAIN();
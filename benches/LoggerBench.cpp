@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include "logpp/core/Logger.h"
+#include "logpp/core/LoggerRegistry.h"
 
 #include "logpp/format/PatternFormatter.h"
 
@@ -11,6 +12,7 @@
 #include "logpp/sinks/Sink.h"
 
 #include <random>
+#include <thread>
 
 class NoopSink : public logpp::sink::Sink
 {
@@ -98,6 +100,18 @@ static void LoggerBench_NoopSink_FormatStr_1(benchmark::State& state)
     }
 }
 
+static void LoggerBench_NoopSink_Interned_1(benchmark::State& state)
+{
+    auto logger    = create<NoopSink>("LoggerBench_NoopSink_Interned_1", logpp::LogLevel::Debug);
+    uint64_t count = 0;
+
+    for (auto _ : state)
+    {
+        logger->debug(logpp::format(LOGPP_INTERN("Looping iteration number {}"), count), logpp::field(LOGPP_INTERN("Iteration"), count));
+        ++count;
+    }
+}
+
 static void LoggerBench_NoopSink_1(benchmark::State& state)
 {
     auto logger    = create<NoopSink>("LoggerBench_NoopSink_1", logpp::LogLevel::Debug);
@@ -177,6 +191,30 @@ static void LoggerBench_FormatSink_FormatStr_3(benchmark::State& state)
     }
 }
 
+static void LoggerBench_FormatSink_Fields_10(benchmark::State& state)
+{
+    auto logger = create<PatternFormatSink>("LoggerBench_FormatSink_Fields_10", logpp::LogLevel::Debug);
+
+    const std::string loggerType = "async";
+    uint64_t i                   = 0;
+
+    for (auto _ : state)
+    {
+        logger->debug("This is a message with many fields",
+                      logpp::field("Iteration", i),
+                      logpp::field("IntField", 0xBAD),
+                      logpp::field("FloatField", M_PI),
+                      logpp::field("StrField", loggerType),
+                      logpp::field("BoolField", true),
+                      logpp::field("CharField", 'x'),
+                      logpp::field("Int8Field", int8_t { -8 }),
+                      logpp::field("UInt16Field", uint16_t { 16 }),
+                      logpp::field("Int64Field", int64_t { -64 }),
+                      logpp::field("LiteralField", "literal"));
+        ++i;
+    }
+}
+
 static void LoggerBench_AsyncNoopSink_FormatStr_3(benchmark::State& state)
 {
     auto poller    = logpp::AsyncQueuePoller::create();
@@ -201,16 +239,109 @@ static void LoggerBench_AsyncNoopSink_FormatStr_3(benchmark::State& state)
     }
 }
 
+template <logpp::sink::AsyncSink::QueueType QueueType>
+static void LoggerBench_AsyncNoopSink_Producers(benchmark::State& state)
+{
+    // Shared by all the producer threads of the benchmark
+    static auto logger = [] {
+        auto poller = logpp::AsyncQueuePoller::create();
+
+        logpp::sink::AsyncSink::QueueOptions queueOptions;
+        queueOptions.type = QueueType;
+        if (QueueType == logpp::sink::AsyncSink::QueueType::Bounded)
+            queueOptions.size = 8192;
+        else
+            queueOptions.size = 1 * 1024 * 1024;
+
+        auto asyncSink = std::make_shared<logpp::sink::AsyncSink>(poller, std::make_shared<NoopSink>(), queueOptions);
+
+        poller->start();
+        asyncSink->start();
+
+        return std::make_shared<logpp::Logger>("LoggerBench_AsyncNoopSink_Producers", logpp::LogLevel::Debug, asyncSink);
+    }();
+
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        logger->debug(logpp::format("This is a log-formatted message {}", i),
+                      logpp::field("IntField", i),
+                      logpp::field("FloatField", M_PI));
+        ++i;
+    }
+}
+
+template <logpp::AsyncQueuePoller::WaitStrategy Strategy>
+static void LoggerBench_AsyncNoopSink_WaitStrategy(benchmark::State& state)
+{
+    auto options         = logpp::AsyncQueuePoller::DefaultOptions;
+    options.waitStrategy = Strategy;
+
+    auto poller    = logpp::AsyncQueuePoller::create(options);
+    auto asyncSink = std::make_shared<logpp::sink::AsyncSink>(poller, std::make_shared<NoopSink>());
+
+    auto logger = std::make_shared<logpp::Logger>("LoggerBench_AsyncNoopSink_WaitStrategy", logpp::LogLevel::Debug, asyncSink);
+
+    poller->start();
+    asyncSink->start();
+
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        logger->debug(logpp::format("This is a log-formatted message {}", i),
+                      logpp::field("IntField", i));
+        ++i;
+    }
+}
+
+static void LoggerBench_Registry_DefaultLogger(benchmark::State& state)
+{
+    auto& registry = logpp::LoggerRegistry::defaultRegistry();
+
+    for (auto _ : state)
+    {
+        logpp::Epoch::Guard guard;
+        benchmark::DoNotOptimize(registry.guardedDefaultLogger());
+    }
+}
+
+static void LoggerBench_Registry_Get(benchmark::State& state)
+{
+    auto& registry = logpp::LoggerRegistry::defaultRegistry();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(registry.get("LoggerBench.Registry.Get"));
+    }
+}
+
+static const int MaxProducers = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
 BENCHMARK(LoggerBench_NoopSink_Empty);
 BENCHMARK(LoggerBench_NoopSink_StringLiteral_1);
 BENCHMARK(LoggerBench_NoopSink_FormatStr_1);
+BENCHMARK(LoggerBench_NoopSink_Interned_1);
 BENCHMARK(LoggerBench_NoopSink_1);
 BENCHMARK(LoggerBench_NoopSink_StringLiteral_2);
 BENCHMARK(LoggerBench_NoopSink_StringLiteral_3);
 BENCHMARK(LoggerBench_NoopSink_StringLiteral_LargeLogBuffer);
 
 BENCHMARK(LoggerBench_FormatSink_FormatStr_3);
+BENCHMARK(LoggerBench_FormatSink_Fields_10);
 
 BENCHMARK(LoggerBench_AsyncNoopSink_FormatStr_3);
 
+BENCHMARK_TEMPLATE(LoggerBench_AsyncNoopSink_Producers, logpp::sink::AsyncSink::QueueType::Bounded)->ThreadRange(1, MaxProducers)->UseRealTime();
+BENCHMARK_TEMPLATE(LoggerBench_AsyncNoopSink_Producers, logpp::sink::AsyncSink::QueueType::Ring)->ThreadRange(1, MaxProducers)->UseRealTime();
+BENCHMARK_TEMPLATE(LoggerBench_AsyncNoopSink_Producers, logpp::sink::AsyncSink::QueueType::PerThreadRing)->ThreadRange(1, MaxProducers)->UseRealTime();
+
+BENCHMARK_TEMPLATE(LoggerBench_AsyncNoopSink_WaitStrategy, logpp::AsyncQueuePoller::WaitStrategy::BusySpin);
+BENCHMARK_TEMPLATE(LoggerBench_AsyncNoopSink_WaitStrategy, logpp::AsyncQueuePoller::WaitStrategy::Hybrid);
+BENCHMARK_TEMPLATE(LoggerBench_AsyncNoopSink_WaitStrategy, logpp::AsyncQueuePoller::WaitStrategy::Blocking);
+
+BENCHMARK(LoggerBench_Registry_DefaultLogger)->ThreadRange(1, MaxProducers)->UseRealTime();
+BENCHMARK(LoggerBench_Registry_Get)->ThreadRange(1, MaxProducers)->UseRealTime();
+
 BENCHMARK_MAIN();
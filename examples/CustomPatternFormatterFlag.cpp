@@ -8,10 +8,10 @@
 using namespace logpp;
 
 // A flag formatter that formats log message fields as JSON
-class JsonFormatter : public FlagFormatter
+class JsonFieldsFormatter : public FlagFormatter
 {
 public:
-    explicit JsonFormatter(std::string prefix)
+    explicit JsonFieldsFormatter(std::string prefix)
         : m_prefix(std::move(prefix))
     { }
 
@@ -178,7 +178,7 @@ private:
 int main()
 {
     // Register our custom flag formatter
-    PatternFormatter::registerFlag<JsonFormatter>('j');
+    PatternFormatter::registerFlag<JsonFieldsFormatter>('j');
 
     // Create a pattern formatter with our custom flag
     auto formatter = std::make_shared<PatternFormatter>("%Y-%m-%d %H:%M:%S [%l] (%n) %v%j[ - ]");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "logpp/config/FileWatcher.h"
+#include "logpp/core/CallSite.h"
 #include "logpp/core/LoggerRegistry.h"
 
 #include <istream>
@@ -85,6 +86,8 @@ namespace logpp
                 TRY(configureLoggers(registry, result.loggers));
 
 #undef TRY
+
+                CallSiteRegistry::instance().setRules(std::move(result.callSites));
             }
             catch (const toml::parse_error& e)
             {
@@ -131,14 +134,16 @@ namespace logpp
         {
             std::vector<Sink> sinks;
             std::vector<Logger> loggers;
+            std::vector<CallSiteRule> callSites;
 
             std::optional<Error> error;
 
-            static ParseResult success(std::vector<Sink> sinks, std::vector<Logger> loggers)
+            static ParseResult success(std::vector<Sink> sinks, std::vector<Logger> loggers, std::vector<CallSiteRule> callSites)
             {
                 return ParseResult {
                     std::move(sinks),
                     std::move(loggers),
+                    std::move(callSites),
                     std::nullopt
                 };
             }
@@ -148,6 +153,7 @@ namespace logpp
                 return ParseResult {
                     std::vector<Sink> {},
                     std::vector<Logger> {},
+                    std::vector<CallSiteRule> {},
                     error
                 };
             }
@@ -161,6 +167,8 @@ namespace logpp
         static std::pair<std::vector<Logger>, std::optional<Error>> parseLoggers(const toml::table& table, const std::vector<Sink>& sinks);
         static std::pair<std::optional<Logger>, std::optional<Error>> parseLogger(std::string tableName, const toml::table& table, const std::vector<Sink>& sinks);
 
+        static std::pair<std::vector<CallSiteRule>, std::optional<Error>> parseCallSites(const toml::table& table);
+
         static std::optional<Logger> findParent(const Logger& logger, const std::vector<Logger>& loggers);
         static std::optional<Error> prepareLoggers(std::vector<Logger>& loggers);
 
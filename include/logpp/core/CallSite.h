@@ -0,0 +1,170 @@
+#pragma once
+
+#include "logpp/core/LogLevel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logpp
+{
+    // Whether the statements of a call site are logged
+    enum class CallSiteState : uint8_t {
+        // Follow the level of the logger
+        Default,
+
+        // Always log, whatever the level of the logger
+        Enabled,
+
+        // Never log
+        Disabled
+    };
+
+    // Static descriptor of a statement of the LOGPP_ macros. Every statement owns one,
+    // registered in the CallSiteRegistry the first time the statement runs.
+    //
+    // Descriptors are constant-initialized: checking the state of a site that has already
+    // been registered is a single relaxed load
+    class CallSite
+    {
+    public:
+        constexpr CallSite(const char* file, size_t line, LogLevel level, const char* text)
+            : m_file(file)
+            , m_line(line)
+            , m_level(level)
+            , m_text(text)
+        { }
+
+        CallSite(const CallSite&) = delete;
+        CallSite& operator=(const CallSite&) = delete;
+
+        CallSiteState state()
+        {
+            auto state = m_state.load(std::memory_order_relaxed);
+            if (state == Unregistered)
+                return registerSite();
+
+            return static_cast<CallSiteState>(state);
+        }
+
+        std::string_view file() const
+        {
+            return m_file;
+        }
+
+        size_t line() const
+        {
+            return m_line;
+        }
+
+        // Level of the statement. For a level only known at runtime, the level of the first
+        // execution of the statement
+        LogLevel level() const
+        {
+            return m_level;
+        }
+
+        // Source text of the text of the statement, e.g `"Request handled"` or
+        // `LOGPP_FORMAT("Request {} handled", id)`
+        std::string_view text() const
+        {
+            return m_text;
+        }
+
+    private:
+        friend class CallSiteRegistry;
+
+        static constexpr uint8_t Unregistered = 0xFF;
+
+        const char* m_file;
+        size_t m_line;
+        LogLevel m_level;
+        const char* m_text;
+
+        std::atomic<uint8_t> m_state { Unregistered };
+
+        // Next site of the registry
+        CallSite* m_next { nullptr };
+
+        CallSiteState registerSite();
+    };
+
+    // A rule setting the state of the sites of a file, or of a single line of a file
+    struct CallSiteRule
+    {
+        // Path of the file, or a trailing part of it made of whole path components:
+        // "Server.cpp" and "net/Server.cpp" both match "src/net/Server.cpp"
+        std::string file;
+
+        // Line of the site, all the sites of the file if not set
+        std::optional<size_t> line;
+
+        CallSiteState state { CallSiteState::Default };
+    };
+
+    // The sites of the process and the rules changing their state.
+    //
+    // Rules apply to the sites that have already been registered as well as to the sites
+    // registered afterwards. When several rules match a site, a rule with a line takes
+    // precedence over a rule for the whole file, and the last rule set wins otherwise
+    class CallSiteRegistry
+    {
+    public:
+        static CallSiteRegistry& instance();
+
+        // Add or replace the rule for the file and the line of `rule`.
+        // Returns the number of registered sites matching the rule
+        size_t setRule(CallSiteRule rule);
+
+        // Replace all the rules
+        void setRules(std::vector<CallSiteRule> rules);
+
+        // Remove the rule for `file` and `line`. Returns whether a rule has been removed
+        bool removeRule(std::string_view file, std::optional<size_t> line = std::nullopt);
+
+        // Remove all the rules, sites go back to their default state
+        void clearRules();
+
+        std::vector<CallSiteRule> rules() const;
+
+        size_t enable(std::string_view file, std::optional<size_t> line = std::nullopt)
+        {
+            return setRule(CallSiteRule { std::string(file), line, CallSiteState::Enabled });
+        }
+
+        size_t disable(std::string_view file, std::optional<size_t> line = std::nullopt)
+        {
+            return setRule(CallSiteRule { std::string(file), line, CallSiteState::Disabled });
+        }
+
+        template <typename SiteFunc>
+        void forEachSite(SiteFunc&& func) const
+        {
+            std::lock_guard guard(m_mutex);
+
+            for (const auto* site = m_head; site != nullptr; site = site->m_next)
+                std::invoke(func, *site);
+        }
+
+        static bool matches(const CallSiteRule& rule, const CallSite& site);
+
+    private:
+        friend class CallSite;
+
+        mutable std::mutex m_mutex;
+
+        CallSite* m_head { nullptr };
+        std::vector<CallSiteRule> m_rules;
+
+        CallSiteState add(CallSite& site);
+
+        CallSiteState resolve(const CallSite& site) const;
+        void apply();
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace logpp
+{
+    // Epoch-based reclamation of objects read through a raw pointer.
+    //
+    // Readers access shared objects inside a `Guard`, which only announces the current
+    // epoch in a slot owned by the thread: no reference count is touched and no cache line
+    // is shared with other readers. Writers replace the object, then `retire` the previous
+    // one. A retired object is destroyed once every thread that was inside a guard when it
+    // was retired has left it: the last of them to leave its guard destroys it
+    class Epoch
+    {
+    public:
+        class Guard
+        {
+        public:
+            Guard()
+            {
+                enter();
+            }
+
+            ~Guard()
+            {
+                exit();
+            }
+
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+        };
+
+        // Defer the destruction of `object` until no reader can still be accessing it.
+        // The object must have been unpublished before being retired
+        static void retire(std::shared_ptr<void> object);
+
+        // Destroy the retired objects that readers can not access anymore.
+        // Returns the number of objects that are still retired
+        static size_t reclaim();
+
+        // Wait for every object retired so far to be destroyed. Must not be called
+        // inside a guard
+        static void synchronize();
+
+    private:
+        // Epoch announced by a thread, 0 when the thread is outside of any guard
+        struct Record
+        {
+            std::atomic<uint64_t> epoch { 0 };
+            std::atomic<bool> inUse { false };
+            Record* next { nullptr };
+        };
+
+        // Record of the calling thread, given back to the registry when the thread exits
+        class LocalRecord
+        {
+        public:
+            LocalRecord();
+            ~LocalRecord();
+
+            Record* record;
+
+            // Guards can be nested, e.g when a sink logs while sinking an event
+            size_t depth { 0 };
+        };
+
+        static inline std::atomic<uint64_t> s_epoch { 1 };
+
+        // Epoch of the oldest object still retired, the maximum value when there is none.
+        // Only threads that entered their guard before it was retired need to reclaim
+        static inline std::atomic<uint64_t> s_oldestRetired { std::numeric_limits<uint64_t>::max() };
+
+        // Records are never freed, threads exiting give them back to be reused
+        static std::atomic<Record*> s_records;
+
+        static LocalRecord& localRecord()
+        {
+            static thread_local LocalRecord local;
+            return local;
+        }
+
+        static void enter()
+        {
+            auto& local = localRecord();
+            if (local.depth++ > 0)
+                return;
+
+            // Sequentially consistent, the announce must be visible before the reads
+            // of the guarded objects, see `retire`
+            local.record->epoch.store(s_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        static void exit()
+        {
+            auto& local = localRecord();
+            if (--local.depth > 0)
+                return;
+
+            auto announced = local.record->epoch.load(std::memory_order_relaxed);
+            local.record->epoch.store(0, std::memory_order_release);
+
+            // This thread may have been the last one preventing a retired object from being
+            // destroyed. A thread leaving while an object is being retired may miss it, the
+            // object is then destroyed by the next guard left or the next retire
+            if (announced <= s_oldestRetired.load(std::memory_order_acquire))
+                reclaim();
+        }
+
+        static Record* acquireRecord();
+        static void releaseRecord(Record* record);
+    };
+}
@@ -89,15 +89,15 @@ namespace logpp
             return writeFormatArgsImpl(buffer, args, std::make_index_sequence<sizeof...(Args)> {});
         }
 
-        template <typename>
+        template <typename FormatStrOffset, typename>
         struct TextBlock;
 
-        template <typename... Args>
-        struct TextBlock<std::tuple<Args...>>
+        template <typename FormatStrOffset, typename... Args>
+        struct TextBlock<FormatStrOffset, std::tuple<Args...>>
         {
             using ArgsOffsets = std::tuple<Args...>;
 
-            TextBlock(StringOffset formatStrOffset, ArgsOffsets argsOffsets)
+            TextBlock(FormatStrOffset formatStrOffset, ArgsOffsets argsOffsets)
                 : formatStrOffset { formatStrOffset }
                 , argsOffsets { argsOffsets }
             { }
@@ -111,10 +111,41 @@ namespace logpp
                     formatImpl(view, buffer, formatStr, std::make_index_sequence<sizeof...(Args)> {});
             }
 
+            std::string_view visit(LogBufferView view, LogFieldVisitor& visitor) const
+            {
+                visitor.visitStart(sizeof...(Args));
+                if constexpr (sizeof...(Args) > 0)
+                    visitImpl(view, visitor, std::make_index_sequence<sizeof...(Args)> {});
+                visitor.visitEnd();
+
+                return formatStrOffset.get(view);
+            }
+
         private:
-            StringOffset formatStrOffset;
+            FormatStrOffset formatStrOffset;
             ArgsOffsets argsOffsets;
 
+            template <size_t... Indexes>
+            void visitImpl(LogBufferView view, LogFieldVisitor& visitor, std::index_sequence<Indexes...>) const
+            {
+                (visitArg(visitor, getArg<Indexes>(view)), ...);
+            }
+
+            // Arguments that can not be visited are visited as their formatted string
+            template <typename Arg>
+            static void visitArg(LogFieldVisitor& visitor, const Arg& arg)
+            {
+                if constexpr (IsVisitable<Arg>)
+                {
+                    visitor.visit(std::string_view {}, arg);
+                }
+                else
+                {
+                    auto str = fmt::format("{}", arg);
+                    visitor.visit(std::string_view {}, std::string_view(str));
+                }
+            }
+
             template <size_t... Indexes>
             void formatImpl(LogBufferView view, fmt::memory_buffer& buffer, std::string_view formatStr, std::index_sequence<Indexes...>) const
             {
@@ -151,6 +182,23 @@ namespace logpp
                 });
             }
 
+            // Decode at most `capacity` fields, starting from the field at index `first`
+            size_t decode(LogBufferView view, size_t first, FieldValue* fields, size_t capacity) const
+            {
+                size_t index = 0;
+                size_t count = 0;
+                tuple_utils::visit(offsets, [&](const auto& fieldOffset) {
+                    if (index++ < first || count == capacity)
+                        return;
+
+                    auto& field = fields[count++];
+                    field.key   = fieldOffset.key.get(view);
+                    field.set(fieldOffset.value.get(view));
+                });
+
+                return count;
+            }
+
             constexpr size_t count() const
             {
                 return sizeof...(Fields);
@@ -167,8 +215,8 @@ namespace logpp
             return { offsets };
         }
 
-        template <typename ArgsOffsets>
-        TextBlock<ArgsOffsets> textBlock(StringOffset textOffset, ArgsOffsets argsOffsets)
+        template <typename TextOffset, typename ArgsOffsets>
+        TextBlock<TextOffset, ArgsOffsets> textBlock(TextOffset textOffset, ArgsOffsets argsOffsets)
         {
             return { textOffset, argsOffsets };
         }
@@ -178,6 +226,34 @@ namespace logpp
             StringLiteralOffset file;
             Offset<size_t> line;
         };
+
+        // Fields stored outside of the buffer
+        struct ExternalFieldsBlock
+        {
+            using VisitFunc = void (*)(const void* data, LogFieldVisitor& visitor);
+
+            VisitFunc visitFunc;
+            const void* data;
+            size_t fieldsCount;
+
+            void visit(LogBufferView, LogFieldVisitor& visitor) const
+            {
+                visitFunc(data, visitor);
+            }
+
+            size_t count() const
+            {
+                return fieldsCount;
+            }
+        };
+
+        template <typename Block, typename = void>
+        struct IsDecodable : std::false_type
+        { };
+
+        template <typename Block>
+        struct IsDecodable<Block, std::void_t<decltype(&Block::decode)>> : std::true_type
+        { };
     }
 
     template <typename KeyOffset, typename OffsetT>
@@ -196,8 +272,13 @@ namespace logpp
     class EventLogBuffer : public LogBuffer<256>
     {
     public:
-        using TextFormatFunc  = void (*)(const LogBufferBase& buffer, OffsetType offsetsIndex, fmt::memory_buffer& formatBuf);
-        using FieldsVisitFunc = void (*)(const LogBufferBase& buffer, OffsetType offsetsIndex, LogFieldVisitor& visitor);
+        using TextFormatFunc   = void (*)(const LogBufferBase& buffer, OffsetType offsetsIndex, fmt::memory_buffer& formatBuf);
+        using FieldsVisitFunc  = void (*)(const LogBufferBase& buffer, OffsetType offsetsIndex, LogFieldVisitor& visitor);
+        using TextVisitFunc    = std::string_view (*)(const LogBufferBase& buffer, OffsetType offsetsIndex, LogFieldVisitor& visitor);
+        using FieldsDecodeFunc = size_t (*)(const LogBufferBase& buffer, OffsetType offsetsIndex, size_t first, FieldValue* fields, size_t capacity);
+
+        // Number of fields decoded at once by `visitFieldsStatic`
+        static constexpr size_t DecodeBatchSize = 16;
 
         static constexpr size_t HeaderOffset = 0;
 
@@ -208,20 +289,26 @@ namespace logpp
 
             OffsetType textBlockIndex;
             TextFormatFunc formatFunc;
+            TextVisitFunc textVisitFunc;
 
             OffsetType sourceLocationBlockIndex;
 
             uint8_t fieldsCount;
             OffsetType fieldsBlockIndex;
             FieldsVisitFunc fieldsVisitFunc;
+            FieldsDecodeFunc fieldsDecodeFunc;
         };
 
         EventLogBuffer()
         {
-            auto* header                     = decodeHeader();
-            header->sourceLocationBlockIndex = 0;
-            header->fieldsCount              = 0;
-            advance(HeaderOffset + sizeof(Header));
+            encode(Header {});
+        }
+
+        // Clear the content of the buffer, keeping its storage
+        void reset()
+        {
+            seek(HeaderOffset);
+            encode(Header {});
         }
 
         void writeTime(TimePoint timePoint)
@@ -245,8 +332,8 @@ namespace logpp
             encodeTextBlock(block, blockOffset);
         }
 
-        template <typename... Args>
-        void writeText(const FormatArgsHolder<Args...>& holder)
+        template <typename Str, typename... Args>
+        void writeText(const BasicFormatArgsHolder<Str, Args...>& holder)
         {
             auto formatStrOffset = this->write(holder.formatStr);
             auto argsOffsets     = details::writeFormatArgs(*this, holder.args);
@@ -280,6 +367,16 @@ namespace logpp
             encodeFieldsBlock(block, blockOffset);
         }
 
+        // Write `count` fields that are visited by `visitFunc` from `data`, which must outlive
+        // the buffer. Used for fields that are only known at runtime, e.g decoded from a binary log
+        void writeExternalFields(size_t count, details::ExternalFieldsBlock::VisitFunc visitFunc, const void* data)
+        {
+            details::ExternalFieldsBlock block { visitFunc, data, count };
+            auto blockOffset = this->encode(block);
+
+            encodeFieldsBlock(block, blockOffset);
+        }
+
         void visitFields(LogFieldVisitor& visitor) const
         {
             const auto* header = decodeHeader();
@@ -287,11 +384,53 @@ namespace logpp
                 std::invoke(header->fieldsVisitFunc, *this, header->fieldsBlockIndex, visitor);
         }
 
+        // Visit the fields with the concrete type of `visitor` instead of through LogFieldVisitor.
+        // Fields are decoded by batches with a single indirect call per batch, and `visitor`
+        // is called directly for every field. Fields that can not be decoded, e.g written
+        // with `writeExternalFields`, are visited through LogFieldVisitor
+        template <typename Visitor>
+        void visitFieldsStatic(Visitor& visitor) const
+        {
+            static_assert(std::is_base_of_v<LogFieldVisitor, Visitor>, "Visitor must be a LogFieldVisitor");
+
+            const auto* header = decodeHeader();
+            if (header->fieldsCount == 0)
+                return;
+
+            if (header->fieldsDecodeFunc == nullptr)
+            {
+                std::invoke(header->fieldsVisitFunc, *this, header->fieldsBlockIndex, visitor);
+                return;
+            }
+
+            visitor.visitStart(header->fieldsCount);
+
+            FieldValue fields[DecodeBatchSize];
+            for (size_t first = 0; first < header->fieldsCount;)
+            {
+                auto count = std::invoke(header->fieldsDecodeFunc, *this, header->fieldsBlockIndex, first, fields, DecodeBatchSize);
+                for (size_t i = 0; i < count; ++i)
+                    visitField(fields[i], visitor);
+
+                first += count;
+            }
+
+            visitor.visitEnd();
+        }
+
         TimePoint time() const
         {
             return decodeHeader()->timePoint;
         }
 
+        // Decode the time of an event from the raw bytes of its buffer
+        static TimePoint decodeTime(const char* data)
+        {
+            Header header;
+            std::memcpy(&header, data + HeaderOffset, sizeof(Header));
+            return header.timePoint;
+        }
+
         thread_utils::id threadId() const
         {
             return decodeHeader()->threadId;
@@ -300,7 +439,19 @@ namespace logpp
         void formatText(fmt::memory_buffer& buffer) const
         {
             const auto* header = decodeHeader();
-            std::invoke(header->formatFunc, *this, header->textBlockIndex, buffer);
+            if (header->formatFunc != nullptr)
+                std::invoke(header->formatFunc, *this, header->textBlockIndex, buffer);
+        }
+
+        // Visit the arguments of the text, with empty keys, and return its format string.
+        // A text without arguments is not a format string and must not be formatted
+        std::optional<std::string_view> visitText(LogFieldVisitor& visitor) const
+        {
+            const auto* header = decodeHeader();
+            if (header->textVisitFunc == nullptr)
+                return std::nullopt;
+
+            return std::invoke(header->textVisitFunc, *this, header->textBlockIndex, visitor);
         }
 
         std::optional<SourceLocation> location() const
@@ -330,6 +481,11 @@ namespace logpp
                 const Block* block = view.overlayAs<Block>(blockIndex);
                 block->formatTo(formatBuf, view);
             };
+            header->textVisitFunc = [](const LogBufferBase& buffer, OffsetType blockIndex, LogFieldVisitor& visitor) {
+                LogBufferView view { buffer };
+                const Block* block = view.overlayAs<Block>(blockIndex);
+                return block->visit(view, visitor);
+            };
         }
 
         template <typename Block>
@@ -346,6 +502,19 @@ namespace logpp
                 block->visit(view, visitor);
                 visitor.visitEnd();
             };
+
+            if constexpr (details::IsDecodable<Block>::value)
+            {
+                header->fieldsDecodeFunc = [](const LogBufferBase& buffer, OffsetType blockIndex, size_t first, FieldValue* fields, size_t capacity) {
+                    LogBufferView view { buffer };
+                    const Block* block = view.overlayAs<Block>(blockIndex);
+                    return block->decode(view, first, fields, capacity);
+                };
+            }
+            else
+            {
+                header->fieldsDecodeFunc = nullptr;
+            }
         }
 
         Header* decodeHeader()
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "logpp/core/EventLogBuffer.h"
+
+#include <atomic>
+#include <memory>
+
+namespace logpp
+{
+    // A pool of reusable EventLogBuffer.
+    //
+    // Every thread owns a cache of free buffers. Acquiring a buffer pops it from
+    // the cache of the calling thread, releasing it pushes it back to the cache it
+    // has been acquired from, even when released from another thread, e.g by an
+    // asynchronous poller.
+    //
+    // Buffers keep their storage when released, which means that after warming up,
+    // encoding an event that does not fit in the inline storage of the buffer
+    // does not allocate anymore.
+    class EventLogBufferPool
+    {
+    public:
+        // Maximum number of free buffers a single thread cache will keep around
+        static constexpr size_t MaxCachedBuffers = 1024;
+
+        class ThreadCache;
+
+        class Node
+        {
+        public:
+            friend class EventLogBufferPool;
+            friend class ThreadCache;
+
+            EventLogBuffer& buffer()
+            {
+                return m_buffer;
+            }
+
+            const EventLogBuffer& buffer() const
+            {
+                return m_buffer;
+            }
+
+        private:
+            explicit Node(ThreadCache* owner)
+                : m_owner(owner)
+            { }
+
+            EventLogBuffer m_buffer;
+
+            ThreadCache* m_owner;
+            Node* m_next { nullptr };
+        };
+
+        struct Deleter
+        {
+            void operator()(Node* node) const
+            {
+                EventLogBufferPool::release(node);
+            }
+        };
+
+        using Ptr = std::unique_ptr<Node, Deleter>;
+
+        // Acquire an empty buffer from the cache of the calling thread
+        static Node* acquire();
+
+        // Return a buffer to the cache it has been acquired from. Can be called
+        // from any thread
+        static void release(Node* node);
+
+        static Ptr acquireScoped()
+        {
+            return Ptr { acquire() };
+        }
+    };
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "logpp/core/StringLiteral.h"
+#include "logpp/core/StringTable.h"
+
 #include <string_view>
 #include <tuple>
 
@@ -7,10 +10,15 @@
 
 namespace logpp
 {
-    template <typename... Args>
-    struct FormatArgsHolder
+    // Holds a format string along with its arguments. Formatting is deferred: the
+    // arguments are encoded as-is in the log buffer and only formatted by the sink.
+    // `Str` is either a std::string_view, in which case the format string is copied
+    // inside the log buffer, a StringLiteral, in which case only its address is, or an
+    // InternedString, in which case only its id is
+    template <typename Str, typename... Args>
+    struct BasicFormatArgsHolder
     {
-        std::string_view formatStr;
+        Str formatStr;
         std::tuple<Args...> args;
 
         void formatTo(fmt::memory_buffer& buffer) const
@@ -19,10 +27,29 @@ namespace logpp
         }
 
     private:
+        std::string_view formatStrView() const
+        {
+            if constexpr (std::is_same_v<Str, StringLiteral>)
+                return std::string_view(formatStr.value);
+            else if constexpr (std::is_same_v<Str, InternedString>)
+                return StringTable::instance().get(formatStr.id);
+            else
+                return formatStr;
+        }
+
         template <size_t... Indexes>
         void formatToImpl(fmt::memory_buffer& buffer, std::index_sequence<Indexes...>) const
         {
-            fmt::format_to(std::back_inserter(buffer), fmt::format_string<Args...>(formatStr), std::get<Indexes>(args)...);
+            fmt::format_to(std::back_inserter(buffer), fmt::runtime(formatStrView()), std::get<Indexes>(args)...);
         }
     };
+
+    template <typename... Args>
+    using FormatArgsHolder = BasicFormatArgsHolder<std::string_view, Args...>;
+
+    template <typename... Args>
+    using LiteralFormatArgsHolder = BasicFormatArgsHolder<StringLiteral, Args...>;
+
+    template <typename... Args>
+    using InternedFormatArgsHolder = BasicFormatArgsHolder<InternedString, Args...>;
 }
@@ -2,6 +2,7 @@
 
 #include "logpp/core/Offset.h"
 #include "logpp/core/StringLiteral.h"
+#include "logpp/core/StringTable.h"
 
 #include <array>
 #include <cstring>
@@ -36,6 +37,9 @@ namespace logpp
 
         StringLiteralOffset write(StringLiteral str);
 
+        // Only the id of an interned string is written, resolved when the buffer is read
+        InternedStringOffset write(InternedString str);
+
         template <typename Return, typename... Args>
         FunctionOffset write(Return (*func)(Args...))
         {
@@ -44,16 +48,53 @@ namespace logpp
 
         size_t size() const;
 
+        const char* data() const
+        {
+            return m_data;
+        }
+
+        // Replace the content of this buffer by the content of `other`, keeping
+        // the current storage if it is large enough
+        void assign(const LogBufferBase& other);
+
+        // Replace the content of this buffer by raw bytes previously copied from
+        // another buffer
+        void assign(const char* bytes, size_t size);
+
     private:
         size_t m_cursor { 0 };
 
         StringOffset writeString(const char* str, size_t size);
-        virtual void reserve(size_t capacity) = 0;
+
+        // Slow path of `reserve`, only called when the buffer needs to grow
+        virtual void grow(size_t capacity) = 0;
 
     protected:
-        virtual char* dataAt(size_t index) = 0;
+        // The storage is owned by the concrete buffer but cached here so that
+        // encoding a value does not go through a virtual call on the hot path
+        char* m_data { nullptr };
+        size_t m_capacity { 0 };
+
+        LogBufferBase(char* data, size_t capacity)
+            : m_data(data)
+            , m_capacity(capacity)
+        { }
 
-        const char* dataAt(size_t index) const;
+        void reserve(size_t capacity)
+        {
+            if (capacity > m_capacity)
+                grow(capacity);
+        }
+
+        char* dataAt(size_t index)
+        {
+            return m_data + index;
+        }
+
+        const char* dataAt(size_t index) const
+        {
+            return m_data + index;
+        }
 
         template <typename T>
         T* overlayAt(size_t offset)
@@ -70,9 +111,9 @@ namespace logpp
         template <typename T>
         size_t encode(T value)
         {
-            reserve(size() + sizeof(value));
-            auto index           = m_cursor;
-            *overlayAt<T>(index) = value;
+            reserve(m_cursor + sizeof(value));
+            auto index = m_cursor;
+            std::memcpy(dataAt(index), &value, sizeof(T));
             m_cursor += sizeof(T);
             return index;
         }
@@ -81,6 +122,7 @@ namespace logpp
         size_t encodeString(const char* str, size_t size);
 
         void advance(size_t size);
+        void seek(size_t cursor);
         size_t cursor() const;
 
         template <typename T>
@@ -95,7 +137,7 @@ namespace logpp
     {
     public:
         LogBuffer()
-            : m_data(&m_inlineData[0])
+            : LogBufferBase(&m_inlineData[0], N)
         { }
 
         ~LogBuffer()
@@ -108,30 +150,30 @@ namespace logpp
         }
 
         LogBuffer(const LogBuffer& other) noexcept
-            : m_data(&m_inlineData[0])
+            : LogBufferBase(&m_inlineData[0], N)
         {
             *this = other;
         }
 
         LogBuffer(LogBuffer&& other) noexcept
-            : m_data(&m_inlineData[0])
+            : LogBufferBase(&m_inlineData[0], N)
         {
             *this = std::move(other);
         }
 
         LogBuffer& operator=(const LogBuffer& other) noexcept
         {
-            reserve(other.size());
-            std::memcpy(m_data, other.m_data, other.size());
-
-            advance(other.cursor());
-            m_capacity = other.m_capacity;
+            if (this != &other)
+                assign(other);
 
             return *this;
         }
 
         LogBuffer& operator=(LogBuffer&& other) noexcept
         {
+            if (this == &other)
+                return *this;
+
             // If the other is not small, let's steal its buffer
             if (!other.isSmall())
             {
@@ -139,69 +181,51 @@ namespace logpp
                 if (!isSmall())
                     std::free(m_data);
 
-                m_data       = other.m_data;
-                other.m_data = nullptr;
+                m_data     = other.m_data;
+                m_capacity = other.m_capacity;
+
+                other.m_data     = &other.m_inlineData[0];
+                other.m_capacity = N;
+
+                seek(other.cursor());
             }
-            // The other is small, which means that we will also be small, so memcpy the bytes
-            // over
+            // The other is small, which means that it will fit in our current storage, so memcpy
+            // the bytes over
             else
             {
-                // Cleanup our buffer if we were not small
-                if (!isSmall())
-                    std::free(m_data);
-
-                m_data = &m_inlineData[0];
-                std::memcpy(m_data, other.m_data, other.size());
+                assign(other);
             }
 
-            advance(other.cursor());
-            m_capacity = other.m_capacity;
-
             return *this;
         }
 
     private:
         using InlineStorage = std::array<char, N>;
 
-        InlineStorage m_inlineData {};
-        char* m_data { nullptr };
-
-        size_t m_capacity { N };
+        // Note that the inline storage is deliberately left uninitialized. Buffers are
+        // created for every log event and only the bytes up to `size()` are ever read.
+        InlineStorage m_inlineData;
 
         bool isSmall() const
         {
             return m_data == &m_inlineData[0];
         }
 
-        void reserve(size_t capacity) override
+        void grow(size_t capacity) override
         {
-            if (capacity <= m_capacity)
-                return;
-
             auto newCapacity = std::max(m_capacity * 2, capacity);
 
             auto* data = static_cast<char*>(malloc(newCapacity * sizeof(char)));
             if (data == nullptr)
                 return;
 
-            if (isSmall())
-            {
-                std::memcpy(data, m_inlineData.data(), size());
-            }
-            else
-            {
-                std::memcpy(data, m_data, size());
+            std::memcpy(data, m_data, size());
+
+            if (!isSmall())
                 free(m_data);
-            }
 
             m_data     = data;
             m_capacity = newCapacity;
         }
-
-    protected:
-        char* dataAt(size_t index) override
-        {
-            return m_data + index;
-        }
     };
 }
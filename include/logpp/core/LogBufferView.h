@@ -1,5 +1,7 @@
 #pragma once
 
+#include "logpp/core/StringTable.h"
+
 #include <cstddef>
 
 namespace logpp
@@ -21,6 +23,12 @@ namespace logpp
             return *reinterpret_cast<const T*>(read(index));
         }
 
+        // Resolve a string interned in the StringTable of the process
+        std::string_view resolve(StringId id) const
+        {
+            return StringTable::instance().get(id);
+        }
+
         template <typename T>
         const T* overlayAs(size_t index) const
         {
@@ -2,6 +2,7 @@
 
 #include "logpp/utils/detect.h"
 
+#include <cstdint>
 #include <string_view>
 
 namespace logpp
@@ -34,6 +35,170 @@ namespace logpp
         virtual void visitEnd() = 0;
     };
 
+    // A field decoded from a log buffer along with the type of its value. Fields can be
+    // visited by a concrete visitor through `visitField`, without a virtual call per field
+    struct FieldValue
+    {
+        enum class Type : uint8_t
+        {
+            String,
+            Char,
+            UInt8,
+            UInt16,
+            UInt32,
+            UInt64,
+            Int8,
+            Int16,
+            Int32,
+            Int64,
+            Bool,
+            Float,
+            Double
+        };
+
+        std::string_view key;
+        Type type;
+
+        union
+        {
+            struct
+            {
+                const char* data;
+                size_t size;
+            } str;
+
+            char c;
+            uint8_t u8;
+            uint16_t u16;
+            uint32_t u32;
+            uint64_t u64;
+            int8_t i8;
+            int16_t i16;
+            int32_t i32;
+            int64_t i64;
+            bool b;
+            float f;
+            double d;
+        };
+
+        // The overloads mirror the ones of LogFieldVisitor, so that a value is stored with
+        // the type it would have been visited with
+        void set(std::string_view value)
+        {
+            type     = Type::String;
+            str.data = value.data();
+            str.size = value.size();
+        }
+
+        void set(char value)
+        {
+            type = Type::Char;
+            c    = value;
+        }
+
+        void set(uint8_t value)
+        {
+            type = Type::UInt8;
+            u8   = value;
+        }
+
+        void set(uint16_t value)
+        {
+            type = Type::UInt16;
+            u16  = value;
+        }
+
+        void set(uint32_t value)
+        {
+            type = Type::UInt32;
+            u32  = value;
+        }
+
+        void set(uint64_t value)
+        {
+            type = Type::UInt64;
+            u64  = value;
+        }
+
+        void set(int8_t value)
+        {
+            type = Type::Int8;
+            i8   = value;
+        }
+
+        void set(int16_t value)
+        {
+            type = Type::Int16;
+            i16  = value;
+        }
+
+        void set(int32_t value)
+        {
+            type = Type::Int32;
+            i32  = value;
+        }
+
+        void set(int64_t value)
+        {
+            type = Type::Int64;
+            i64  = value;
+        }
+
+        void set(bool value)
+        {
+            type = Type::Bool;
+            b    = value;
+        }
+
+        void set(float value)
+        {
+            type = Type::Float;
+            f    = value;
+        }
+
+        void set(double value)
+        {
+            type = Type::Double;
+            d    = value;
+        }
+    };
+
+    // Visit `field` with the concrete type of `visitor`. Visitors declared `final` are
+    // called directly, and their methods can be inlined
+    template <typename Visitor>
+    void visitField(const FieldValue& field, Visitor& visitor)
+    {
+        switch (field.type)
+        {
+        case FieldValue::Type::String:
+            return visitor.visit(field.key, std::string_view(field.str.data, field.str.size));
+        case FieldValue::Type::Char:
+            return visitor.visit(field.key, field.c);
+        case FieldValue::Type::UInt8:
+            return visitor.visit(field.key, field.u8);
+        case FieldValue::Type::UInt16:
+            return visitor.visit(field.key, field.u16);
+        case FieldValue::Type::UInt32:
+            return visitor.visit(field.key, field.u32);
+        case FieldValue::Type::UInt64:
+            return visitor.visit(field.key, field.u64);
+        case FieldValue::Type::Int8:
+            return visitor.visit(field.key, field.i8);
+        case FieldValue::Type::Int16:
+            return visitor.visit(field.key, field.i16);
+        case FieldValue::Type::Int32:
+            return visitor.visit(field.key, field.i32);
+        case FieldValue::Type::Int64:
+            return visitor.visit(field.key, field.i64);
+        case FieldValue::Type::Bool:
+            return visitor.visit(field.key, field.b);
+        case FieldValue::Type::Float:
+            return visitor.visit(field.key, field.f);
+        case FieldValue::Type::Double:
+            return visitor.visit(field.key, field.d);
+        }
+    }
+
     namespace details
     {
         template <typename T>
@@ -5,17 +5,40 @@
 #include <optional>
 #include <string_view>
 
+// Values of the levels, to be used in preprocessor conditions
+#define LOGPP_LEVEL_TRACE 0
+#define LOGPP_LEVEL_DEBUG 1
+#define LOGPP_LEVEL_INFO 2
+#define LOGPP_LEVEL_WARN 3
+#define LOGPP_LEVEL_ERROR 4
+#define LOGPP_LEVEL_OFF 5
+
+// Lowest level of the statements compiled in by the LOGPP_ macros. Statements of a lower
+// level are compiled out, their arguments are thus never evaluated
+#if !defined(LOGPP_ACTIVE_LEVEL)
+  #define LOGPP_ACTIVE_LEVEL LOGPP_LEVEL_TRACE
+#endif
+
 namespace logpp
 {
     enum class LogLevel {
-        Trace,
-        Debug,
-        Info,
-        Warning,
-        Error,
-        Off
+        Trace   = LOGPP_LEVEL_TRACE,
+        Debug   = LOGPP_LEVEL_DEBUG,
+        Info    = LOGPP_LEVEL_INFO,
+        Warning = LOGPP_LEVEL_WARN,
+        Error   = LOGPP_LEVEL_ERROR,
+        Off     = LOGPP_LEVEL_OFF
     };
 
+    // Whether statements of `level` are compiled in with `ActiveLevel` as active level.
+    // The threshold is a template argument rather than read from LOGPP_ACTIVE_LEVEL here,
+    // so that files compiled with different active levels get different functions
+    template <int ActiveLevel>
+    constexpr bool isActive(LogLevel level)
+    {
+        return static_cast<int>(level) >= ActiveLevel;
+    }
+
     constexpr inline std::string_view levelString(LogLevel level)
     {
         using namespace std::string_view_literals;
@@ -57,3 +80,8 @@ namespace logpp
         return std::nullopt;
     }
 }
+
+// Whether statements of `level` are compiled in, against the LOGPP_ACTIVE_LEVEL of the
+// file using the macro
+#define LOGPP_IS_ACTIVE(level) \
+    ::logpp::isActive<LOGPP_ACTIVE_LEVEL>(level)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "logpp/core/Epoch.h"
+#include "logpp/core/EventLogBufferPool.h"
 #include "logpp/core/FormatArgs.h"
 #include "logpp/core/LogFieldVisitor.h"
 #include "logpp/core/LogLevel.h"
@@ -9,6 +11,8 @@
 #include "logpp/utils/thread.h"
 
 #include <atomic>
+#include <mutex>
+#include <utility>
 
 namespace logpp
 {
@@ -46,12 +50,36 @@ namespace logpp
         return { formatStr, std::make_tuple(std::forward<Args>(args)...) };
     }
 
+    // A format string literal has static storage duration, we can thus only keep
+    // its address instead of copying it inside the log buffer
+    template <size_t N, typename... Args>
+    LiteralFormatArgsHolder<std::decay_t<Args>...> format(const char (&formatStr)[N], Args&&... args)
+    {
+        return { StringLiteral { formatStr }, std::make_tuple(std::forward<Args>(args)...) };
+    }
+
+    // A mutable char array is most likely a local buffer that might not outlive
+    // the log event, so fallback to copying it
+    template <size_t N, typename... Args>
+    FormatArgsHolder<std::decay_t<Args>...> format(char (&formatStr)[N], Args&&... args)
+    {
+        return { std::string_view(formatStr), std::make_tuple(std::forward<Args>(args)...) };
+    }
+
+    // An interned format string is written as its id, see LOGPP_INTERN
+    template <typename... Args>
+    InternedFormatArgsHolder<std::decay_t<Args>...> format(InternedString formatStr, Args&&... args)
+    {
+        return { formatStr, std::make_tuple(std::forward<Args>(args)...) };
+    }
+
     class Logger
     {
     public:
         Logger(std::string name, LogLevel level, std::shared_ptr<sink::Sink> sink)
             : m_name(std::move(name))
             , m_level(level)
+            , m_sinkPtr(sink.get())
             , m_sink(std::move(sink))
         { }
 
@@ -61,15 +89,15 @@ namespace logpp
             if (!is(level))
                 return;
 
-            EventLogBuffer buffer;
+            auto node    = EventLogBufferPool::acquireScoped();
+            auto& buffer = node->buffer();
 
             buffer.writeTime(Clock::now());
             buffer.writeThreadId(getThreadId());
             buffer.writeText(text);
             buffer.writeFields(std::forward<Fields>(fields)...);
 
-            auto sink = std::atomic_load_explicit(&m_sink, std::memory_order_acquire);
-            sink->sink(name(), level, buffer);
+            sinkEvent(level, buffer);
         }
 
         template <typename Str, typename... Fields>
@@ -78,7 +106,16 @@ namespace logpp
             if (!is(level))
                 return;
 
-            EventLogBuffer buffer;
+            forceLog(text, level, location, std::forward<Fields>(fields)...);
+        }
+
+        // Log regardless of the level of the logger, e.g for a call site that has been
+        // enabled, see CallSiteRegistry
+        template <typename Str, typename... Fields>
+        void forceLog(const Str& text, LogLevel level, SourceLocation location, Fields&&... fields)
+        {
+            auto node    = EventLogBufferPool::acquireScoped();
+            auto& buffer = node->buffer();
 
             buffer.writeTime(Clock::now());
             buffer.writeThreadId(getThreadId());
@@ -86,8 +123,7 @@ namespace logpp
             buffer.writeSourceLocation(location);
             buffer.writeFields(std::forward<Fields>(fields)...);
 
-            auto sink = std::atomic_load_explicit(&m_sink, std::memory_order_acquire);
-            sink->sink(name(), level, buffer);
+            sinkEvent(level, buffer);
         }
 
         template <typename Str, typename... Args>
@@ -122,7 +158,8 @@ namespace logpp
 
         std::shared_ptr<sink::Sink> sink() const
         {
-            return std::atomic_load_explicit(&m_sink, std::memory_order_acquire);
+            std::lock_guard guard(m_sinkMutex);
+            return m_sink;
         }
 
         std::string_view name() const
@@ -140,9 +177,18 @@ namespace logpp
             m_level.store(level, std::memory_order_relaxed);
         }
 
+        // Events being sunk by other threads keep using the previous sink, which is
+        // destroyed once they are done with it
         void setSink(std::shared_ptr<sink::Sink> sink)
         {
-            std::atomic_exchange(&m_sink, std::move(sink));
+            std::shared_ptr<sink::Sink> previous;
+            {
+                std::lock_guard guard(m_sinkMutex);
+                m_sinkPtr.store(sink.get(), std::memory_order_seq_cst);
+                previous = std::exchange(m_sink, std::move(sink));
+            }
+
+            Epoch::retire(std::move(previous));
         }
 
         bool is(LogLevel lvl) const
@@ -154,8 +200,19 @@ namespace logpp
         std::string m_name;
         std::atomic<LogLevel> m_level;
 
+        // Current sink, read by every event without touching its reference count.
+        // Replaced sinks are reclaimed through Epoch
+        std::atomic<sink::Sink*> m_sinkPtr;
+
+        mutable std::mutex m_sinkMutex;
         std::shared_ptr<sink::Sink> m_sink;
 
+        void sinkEvent(LogLevel level, const EventLogBuffer& buffer)
+        {
+            Epoch::Guard guard;
+            m_sinkPtr.load(std::memory_order_seq_cst)->sink(name(), level, buffer);
+        }
+
         static thread_utils::id getThreadId()
         {
             static thread_local auto tid = thread_utils::getCurrentId();
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "logpp/core/Epoch.h"
 #include "logpp/core/Logger.h"
 #include "logpp/format/Formatter.h"
 #include "logpp/sinks/Sink.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace logpp
 {
@@ -134,11 +139,16 @@ namespace logpp
 
         LoggerRegistry();
 
+        LoggerRegistry(const LoggerRegistry&) = delete;
+        LoggerRegistry& operator=(const LoggerRegistry&) = delete;
+
         static bool matches(const LoggerKey& key, std::string_view name);
 
         bool registerLogger(std::shared_ptr<Logger> logger, bool isDefault = false);
         bool registerLoggerFunc(std::string name, LoggerFactory factory, bool isDefault = false);
 
+        // Loggers that have already been retrieved are found without locking, from a
+        // cache of the calling thread or from a snapshot of the registry
         std::shared_ptr<Logger> get(std::string_view name);
 
         template <typename LoggerFunc>
@@ -152,7 +162,17 @@ namespace logpp
             }
         }
 
-        std::shared_ptr<Logger> defaultLogger();
+        // Return the default logger, without locking
+        std::shared_ptr<Logger> defaultLogger() const;
+
+        // Return the default logger without touching its reference count. The logger is
+        // only guaranteed to stay alive while the calling thread is inside an Epoch::Guard:
+        // a replaced default logger is retired through Epoch
+        Logger* guardedDefaultLogger() const
+        {
+            return m_defaultLoggerPtr.load(std::memory_order_seq_cst);
+        }
+
         void setDefaultLogger(std::shared_ptr<Logger> logger);
         void setDefaultLoggerFunc(LoggerFactory factory);
 
@@ -244,11 +264,33 @@ namespace logpp
             std::shared_ptr<Logger> createInstance(const std::string& name) override;
         };
 
+        // Loggers that have been retrieved so far, published on every change so that
+        // readers never take the mutex. Keys point to the keys of `m_loggers` and
+        // `m_resolvedLoggers`
+        struct Snapshot
+        {
+            std::shared_ptr<Logger> defaultLogger;
+            std::unordered_map<std::string_view, std::shared_ptr<Logger>> loggers;
+        };
+
         mutable std::mutex m_mutex;
 
+        // Read inside an Epoch::Guard, replaced snapshots are retired through Epoch
+        std::atomic<const Snapshot*> m_snapshot { nullptr };
+        std::shared_ptr<Snapshot> m_currentSnapshot;
+
+        // Incremented every time a snapshot is published, used to validate the caches of
+        // the threads. Versions are unique across registries
+        std::atomic<uint64_t> m_version { 0 };
+
+        // Objects replaced while holding `m_mutex`, retired through Epoch once it has been
+        // released since destroying them may destroy loggers and their sinks
+        std::vector<std::shared_ptr<void>> m_retired;
+
         // Default logger used by logpp::info(), logpp::debug(), ... free functions
         // or as a final fallback.
         std::shared_ptr<Logger> m_defaultLogger;
+        std::atomic<Logger*> m_defaultLoggerPtr { nullptr };
 
         // Default factory logger used as a fallback when attempting to get a
         // non-registered logger. Fallback to default logger if null
@@ -266,5 +308,38 @@ namespace logpp
 
         std::map<std::string, std::shared_ptr<Logger>, std::less<>> m_loggers;
         std::map<std::string, std::shared_ptr<sink::Sink>, std::less<>> m_sinks;
+
+        // Names that resolved to the logger of a parent or to the default logger, published
+        // so that retrieving them again does not lock. Dropped when a logger is registered
+        // since names may then resolve differently. Replaced rather than cleared, as retired
+        // snapshots may still point to its keys
+        using ResolvedLoggers = std::map<std::string, std::shared_ptr<Logger>, std::less<>>;
+        std::unique_ptr<ResolvedLoggers> m_resolvedLoggers { std::make_unique<ResolvedLoggers>() };
+
+        // Retrieve a logger that is not in the snapshot yet
+        std::shared_ptr<Logger> create(std::string_view name);
+
+        // The following must be called with `m_mutex` held. Objects they replace are added
+        // to `m_retired`
+
+        // Create or find the logger of `name`, publishing it under `name`
+        std::shared_ptr<Logger> resolve(std::string_view name);
+        std::shared_ptr<Logger> addResolved(std::string_view name, std::shared_ptr<Logger> logger);
+        void resetResolvedLoggers();
+
+        // Publish a new snapshot of the loggers
+        void publish();
+
+        void replaceDefaultLogger(std::shared_ptr<Logger> logger);
+
+        // Retire the objects replaced so far. Must be called once `m_mutex` has been released
+        static void retire(std::vector<std::shared_ptr<void>> objects);
+
+        template <typename Func>
+        auto readSnapshot(Func&& func) const
+        {
+            Epoch::Guard guard;
+            return std::invoke(func, *m_snapshot.load(std::memory_order_seq_cst));
+        }
     };
 }
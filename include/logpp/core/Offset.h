@@ -43,6 +43,9 @@ namespace logpp
         struct StringLiteral
         { };
 
+        struct InternedString
+        { };
+
         template <typename T>
         struct Ptr
         { };
@@ -104,6 +107,26 @@ namespace logpp
         OffsetType offset;
     };
 
+    template <>
+    struct Offset<tag::InternedString>
+    {
+        Offset()
+            : offset { 0 }
+        { }
+
+        explicit Offset(OffsetType offset)
+            : offset { offset }
+        { }
+
+        std::string_view get(LogBufferView buffer) const
+        {
+            return buffer.resolve(buffer.readAs<StringId>(offset));
+        }
+
+    private:
+        OffsetType offset;
+    };
+
     template <typename T>
     struct Offset<tag::Ptr<T>>
     {
@@ -147,8 +170,9 @@ namespace logpp
     };
 
     template <typename T>
-    using PtrOffset           = Offset<tag::Ptr<T>>;
-    using StringOffset        = Offset<tag::String>;
-    using StringLiteralOffset = Offset<tag::StringLiteral>;
-    using FunctionOffset      = Offset<tag::Function>;
+    using PtrOffset            = Offset<tag::Ptr<T>>;
+    using StringOffset         = Offset<tag::String>;
+    using StringLiteralOffset  = Offset<tag::StringLiteral>;
+    using InternedStringOffset = Offset<tag::InternedString>;
+    using FunctionOffset       = Offset<tag::Function>;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "logpp/core/EventLogBuffer.h"
+#include "logpp/format/FormatContext.h"
 #include "logpp/utils/detect.h"
 
 #include <fmt/format.h>
@@ -52,7 +53,8 @@ namespace logpp
         template <typename Buffer>
         auto write(Buffer& buffer, const Key& key, const Value& value)
         {
-            fmt::memory_buffer buf;
+            auto context = FormatContext::acquireScoped();
+            auto& buf    = context->scratch();
             details::MemoryStreamBuf<char> streamBuf(buf);
             std::basic_ostream<char> os(&streamBuf);
 
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace logpp
+{
+#if !defined(LOGPP_STRING_TABLE_CAPACITY)
+  #define LOGPP_STRING_TABLE_CAPACITY 65536
+#endif
+
+    using StringId = uint32_t;
+
+    // A string interned in a StringTable. Only its id is written to log buffers
+    struct InternedString
+    {
+        StringId id;
+    };
+
+    // An append-only table of strings, giving every string a stable 32-bit id.
+    //
+    // Interning is lock-free and resolving an id back to its string is wait-free. Strings
+    // are never removed: the table is meant for strings that repeat across events such as
+    // format strings, field keys or logger names, not for arbitrary runtime values.
+    // Once `capacity` strings have been interned, `intern` returns `InvalidId`
+    //
+    // Interning is opt-in: nothing is interned behind the caller's back, strings only go
+    // through the table when they are passed as an InternedString, typically built with
+    // LOGPP_INTERN at the call site. Plain strings are still copied to log buffers
+    class StringTable
+    {
+    public:
+        static constexpr StringId InvalidId     = 0;
+        static constexpr size_t DefaultCapacity = LOGPP_STRING_TABLE_CAPACITY;
+
+        explicit StringTable(size_t capacity = DefaultCapacity);
+        ~StringTable();
+
+        StringTable(const StringTable&) = delete;
+        StringTable& operator=(const StringTable&) = delete;
+
+        // The table of the process, used by the log buffers to resolve interned strings.
+        // It is never destroyed so that ids can be resolved by sinks until the very end
+        static StringTable& instance();
+
+        // Return the id of `str`, interning a copy of it if it is not known yet
+        StringId intern(std::string_view str);
+
+        // Return the id of `str` if it has been interned
+        std::optional<StringId> find(std::string_view str) const;
+
+        // Return the string of `id`, or an empty string for an unknown id
+        std::string_view get(StringId id) const;
+
+        size_t size() const;
+
+        size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+    private:
+        static constexpr size_t ChunkSize = 1024;
+
+        struct Entry
+        {
+            const char* data;
+            uint32_t size;
+            uint32_t hash;
+        };
+
+        size_t m_capacity;
+
+        // Entries are allocated by chunks the first time one of their ids is used
+        size_t m_chunksCount;
+        std::unique_ptr<std::atomic<Entry*>[]> m_chunks;
+
+        // Open-addressing index from the hash of a string to its id. The index is twice as
+        // large as the table so that probing always ends on an empty slot
+        size_t m_indexMask;
+        std::unique_ptr<std::atomic<StringId>[]> m_index;
+
+        std::atomic<StringId> m_nextId { 1 };
+
+        StringId allocate(std::string_view str, uint32_t hash);
+        const Entry* entry(StringId id) const;
+
+        bool matches(StringId id, std::string_view str, uint32_t hash) const;
+        static uint32_t hashOf(std::string_view str);
+    };
+
+    // Intern `str` in the table of the process.
+    // Throws std::length_error if the table is full
+    InternedString intern(std::string_view str);
+}
+
+// Intern a string once for this call site and return it as an InternedString, to be used
+// in place of a format string, a field key or a text:
+//
+//   logger->info(logpp::format(LOGPP_INTERN("Connected to {}"), host), logpp::field(LOGPP_INTERN("port"), port));
+#define LOGPP_INTERN(str)                                                     \
+    ([]() -> ::logpp::InternedString {                                        \
+        static const ::logpp::InternedString interned = ::logpp::intern(str); \
+        return interned;                                                      \
+    }())
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "logpp/core/EventLogBuffer.h"
+#include "logpp/core/LogLevel.h"
+#include "logpp/format/BinaryFormat.h"
+
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace logpp
+{
+    class BinaryFormatError : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    // Decodes events written by a BinaryFormatter. Decoded events are handed back as
+    // EventLogBuffers, so that they can be rendered by any formatter
+    class BinaryDecoder
+    {
+    public:
+        using OnEvent = std::function<void(std::string_view name, LogLevel level, const EventLogBuffer& buffer)>;
+
+        // Decode the records of [data, data + size), calling `onEvent` for every event.
+        // Returns the number of bytes decoded: a trailing partial record is not decoded and
+        // must be given again, followed by the rest of the log.
+        // Throws BinaryFormatError if the data is not a valid binary log
+        size_t decode(const char* data, size_t size, const OnEvent& onEvent);
+
+    private:
+        struct Value
+        {
+            binary::ValueType type;
+
+            union
+            {
+                char c;
+                uint64_t u;
+                int64_t i;
+                bool b;
+                float f;
+                double d;
+            };
+
+            std::string_view str;
+        };
+
+        struct Field
+        {
+            std::string_view key;
+            Value value;
+        };
+
+        bool m_started { false };
+        std::deque<std::string> m_strings;
+
+        EventLogBuffer m_buffer;
+        fmt::memory_buffer m_text;
+        std::vector<Value> m_args;
+        std::vector<Field> m_fields;
+
+        void decodeSession(const char* data, size_t size);
+        void decodeString(const char* data, size_t size);
+        void decodeEvent(const char* data, size_t size, const OnEvent& onEvent);
+
+        std::string_view string(uint32_t id) const;
+        void formatText(std::string_view formatStr);
+
+        static void visitFields(const void* data, LogFieldVisitor& visitor);
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace logpp::binary
+{
+    // Binary logs are a sequence of records, each made of a type, the size of its payload
+    // and the payload itself. Records of an unknown type are skipped by the decoder.
+    //
+    // A log starts with a Session record. Every string that repeats across events (logger
+    // names, format strings, field keys, source files) is written once in a String record
+    // and referenced afterwards by its id. Ids are only valid until the next Session record,
+    // which is written every time a file is opened.
+    //
+    // All integers are little-endian
+    //
+    //   Session: magic (8 bytes), version (u16)
+    //   String:  id (u32), bytes
+    //   Event:   time (i64, nanoseconds since epoch), thread id (u64), level (u8), logger id (u32),
+    //            text kind (u8), [format id (u32), args count (u8), values... | size (u32), bytes],
+    //            source file id (u32, 0 if none), source line (u32),
+    //            fields count (u8), [key id (u32), value]...
+    //   Value:   type (u8), then a fixed-size payload, or size (u32) and bytes for strings
+
+    static constexpr char Magic[8] = { 'L', 'O', 'G', 'P', 'P', 'B', 'I', 'N' };
+    static constexpr uint16_t Version = 1;
+
+    static constexpr size_t RecordHeaderSize = sizeof(uint8_t) + sizeof(uint32_t);
+
+    enum class RecordType : uint8_t
+    {
+        Session = 1,
+        String  = 2,
+        Event   = 3
+    };
+
+    enum class TextKind : uint8_t
+    {
+        None   = 0,
+        Format = 1,
+        Raw    = 2
+    };
+
+    enum class ValueType : uint8_t
+    {
+        String = 1,
+        Char,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        Bool,
+        Float,
+        Double
+    };
+
+    template <typename T>
+    void encodeLE(char* out, T value)
+    {
+        static_assert(std::is_integral_v<T>, "Only integers can be encoded");
+
+        using Unsigned = std::make_unsigned_t<T>;
+        auto bits      = static_cast<Unsigned>(value);
+        for (size_t i = 0; i < sizeof(T); ++i)
+            out[i] = static_cast<char>((bits >> (i * 8)) & 0xFF);
+    }
+
+    template <typename T>
+    T decodeLE(const char* data)
+    {
+        static_assert(std::is_integral_v<T>, "Only integers can be decoded");
+
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned bits  = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            bits |= static_cast<Unsigned>(static_cast<unsigned char>(data[i])) << (i * 8);
+
+        return static_cast<T>(bits);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "logpp/format/BinaryFormat.h"
+#include "logpp/format/Formatter.h"
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace logpp
+{
+    // Encodes events in the binary format described in BinaryFormat.h, to be rendered later
+    // by a BinaryDecoder, e.g with the `logpp-decode` tool.
+    //
+    // The formatter keeps the dictionary of the strings it has already written. Like the
+    // file sinks it is used by, it must not be used by multiple threads at once
+    class BinaryFormatter : public Formatter
+    {
+    public:
+        BinaryFormatter() = default;
+
+        // Start a new session: the next event is preceded by a Session record and the
+        // strings of the dictionary are written again. Must be called when the output
+        // changes, e.g when a file is opened
+        void reset();
+
+    private:
+        mutable bool m_started { false };
+
+        mutable std::deque<std::string> m_strings;
+        mutable std::unordered_map<std::string_view, uint32_t> m_ids;
+
+        mutable fmt::memory_buffer m_event;
+
+        void doFormat(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override;
+
+        // Return the id of `str`, writing a String record to `out` if it is not known yet
+        uint32_t intern(std::string_view str, fmt::memory_buffer& out) const;
+    };
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "logpp/format/Digits.h"
+#include "logpp/format/Formatter.h"
+#include "logpp/format/flag/FieldsFormatter.h"
+#include "logpp/format/flag/TimeZone.h"
+
+#include "logpp/utils/date.h"
+#include "logpp/utils/file.h"
+#include "logpp/utils/thread.h"
+
+namespace logpp
+{
+    namespace pattern_compiler
+    {
+        // Pattern that `%+` expands to
+        inline constexpr char FullPattern[] = "%Y-%m-%d %H:%M:%S [%l] (%n) %v%f[ - ]";
+
+        enum class TokenKind
+        {
+            End,
+            Literal,
+            Flag,
+            Zone,
+            Full,
+            Invalid
+        };
+
+        // A token of a pattern. For literals and flag parameters, [begin, end) is
+        // the range of characters in the pattern
+        struct Token
+        {
+            TokenKind kind;
+            char flag;
+            size_t begin;
+            size_t end;
+            size_t next;
+        };
+
+        constexpr bool isDateTimeFlag(char flag)
+        {
+            switch (flag)
+            {
+            case 'Y':
+            case 'm':
+            case 'd':
+            case 'H':
+            case 'M':
+            case 'S':
+            case 'i':
+            case 'u':
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        constexpr Token nextToken(const char* pattern, size_t pos)
+        {
+            if (pattern[pos] == '\0')
+                return { TokenKind::End, '\0', pos, pos, pos };
+
+            if (pattern[pos] != '%')
+            {
+                auto end = pos;
+                while (pattern[end] != '\0' && pattern[end] != '%')
+                    ++end;
+
+                return { TokenKind::Literal, '\0', pos, end, end };
+            }
+
+            auto flag = pattern[pos + 1];
+            switch (flag)
+            {
+            // A trailing '%' is ignored, like the runtime parser does
+            case '\0':
+                return { TokenKind::End, '\0', pos + 1, pos + 1, pos + 1 };
+            case 'Y':
+            case 'm':
+            case 'd':
+            case 'H':
+            case 'M':
+            case 'S':
+            case 'i':
+            case 'u':
+            case 't':
+            case 'v':
+            case 'l':
+            case 'n':
+            case 'p':
+            case 'o':
+                return { TokenKind::Flag, flag, pos + 2, pos + 2, pos + 2 };
+            case 'L':
+                return { TokenKind::Zone, flag, pos + 2, pos + 2, pos + 2 };
+            case '+':
+                return { TokenKind::Full, flag, pos + 2, pos + 2, pos + 2 };
+            case 'f': {
+                auto begin = pos + 2;
+                if (pattern[begin] != '[')
+                    return { TokenKind::Flag, flag, begin, begin, begin };
+
+                auto end = begin + 1;
+                while (pattern[end] != '\0' && pattern[end] != ']')
+                    ++end;
+
+                if (pattern[end] == '\0')
+                    return { TokenKind::Invalid, flag, pos, pos, pos };
+
+                return { TokenKind::Flag, flag, begin + 1, end, end + 1 };
+            }
+            default:
+                return { TokenKind::Invalid, flag, pos, pos, pos };
+            }
+        }
+
+        // Returns whether date or time flags of the pattern are expressed in `zone`
+        constexpr bool usesDateTime(const char* pattern, tz::ZoneId zone)
+        {
+            auto current = tz::ZoneId::Utc;
+            size_t pos   = 0;
+
+            for (;;)
+            {
+                auto token = nextToken(pattern, pos);
+                switch (token.kind)
+                {
+                case TokenKind::End:
+                case TokenKind::Invalid:
+                    return false;
+                case TokenKind::Flag:
+                    if (isDateTimeFlag(token.flag) && current == zone)
+                        return true;
+                    break;
+                case TokenKind::Zone:
+                    current = tz::ZoneId::Local;
+                    break;
+                case TokenKind::Full:
+                    if (zone == tz::ZoneId::Utc)
+                        return true;
+                    current = tz::ZoneId::Utc;
+                    break;
+                default:
+                    break;
+                }
+
+                pos = token.next;
+            }
+        }
+
+        // Calendar fields of an event, computed once per event and zone
+        struct DateTime
+        {
+            int year;
+            unsigned month;
+            unsigned day;
+
+            unsigned hours;
+            unsigned minutes;
+            unsigned seconds;
+            unsigned milliseconds;
+            unsigned microseconds;
+
+            // Time zones are offset by whole seconds, sub-second fields are thus taken from `time`
+            static DateTime from(TimePoint time, TimePoint zonedTime)
+            {
+                auto dp  = date::floor<date::days>(zonedTime);
+                auto ymd = date::year_month_day { dp };
+                auto hms = date::make_time(zonedTime - dp);
+
+                auto subseconds = time - std::chrono::floor<std::chrono::seconds>(time);
+                auto ms         = std::chrono::duration_cast<std::chrono::milliseconds>(subseconds);
+                auto us         = std::chrono::duration_cast<std::chrono::microseconds>(subseconds - ms);
+
+                DateTime dateTime {};
+                dateTime.year         = static_cast<int>(ymd.year());
+                dateTime.month        = static_cast<unsigned>(ymd.month());
+                dateTime.day          = static_cast<unsigned>(ymd.day());
+                dateTime.hours        = static_cast<unsigned>(hms.hours().count());
+                dateTime.minutes      = static_cast<unsigned>(hms.minutes().count());
+                dateTime.seconds      = static_cast<unsigned>(hms.seconds().count());
+                dateTime.milliseconds = static_cast<unsigned>(ms.count());
+                dateTime.microseconds = static_cast<unsigned>(us.count());
+                return dateTime;
+            }
+        };
+
+        struct Context
+        {
+            std::string_view name;
+            LogLevel level;
+            const EventLogBuffer& buffer;
+
+            DateTime utc;
+            DateTime local;
+
+            template <tz::ZoneId Zone>
+            const DateTime& dateTime() const
+            {
+                if constexpr (Zone == tz::ZoneId::Local)
+                    return local;
+                else
+                    return utc;
+            }
+        };
+
+        template <char Flag, tz::ZoneId Zone>
+        void formatFlag(const Context& ctx, fmt::memory_buffer& out)
+        {
+            if constexpr (Flag == 'Y')
+                digits::appendPadded<4>(out, ctx.dateTime<Zone>().year);
+            else if constexpr (Flag == 'm')
+                digits::appendPadded<2>(out, ctx.dateTime<Zone>().month);
+            else if constexpr (Flag == 'd')
+                digits::appendPadded<2>(out, ctx.dateTime<Zone>().day);
+            else if constexpr (Flag == 'H')
+                digits::appendPadded<2>(out, ctx.dateTime<Zone>().hours);
+            else if constexpr (Flag == 'M')
+                digits::appendPadded<2>(out, ctx.dateTime<Zone>().minutes);
+            else if constexpr (Flag == 'S')
+                digits::appendPadded<2>(out, ctx.dateTime<Zone>().seconds);
+            else if constexpr (Flag == 'i')
+                digits::appendPadded<3>(out, ctx.dateTime<Zone>().milliseconds);
+            else if constexpr (Flag == 'u')
+                digits::appendPadded<3>(out, ctx.dateTime<Zone>().microseconds);
+            else if constexpr (Flag == 't')
+                digits::appendThreadId(out, ctx.buffer.threadId());
+            else if constexpr (Flag == 'v')
+                ctx.buffer.formatText(out);
+            else if constexpr (Flag == 'l')
+            {
+                auto str = levelString(ctx.level);
+                out.append(str.data(), str.data() + str.size());
+            }
+            else if constexpr (Flag == 'n')
+                out.append(ctx.name.data(), ctx.name.data() + ctx.name.size());
+            else if constexpr (Flag == 'p')
+            {
+                if (auto location = ctx.buffer.location())
+                    out.append(file_utils::fileName(location->file));
+            }
+            else if constexpr (Flag == 'o')
+            {
+                if (auto location = ctx.buffer.location())
+                    digits::appendDecimal(out, location->line);
+            }
+        }
+
+        // Formats the tokens of `Pattern` starting at `Pos`, one token per instantiation,
+        // so that the whole pattern unrolls into a single straight-line function
+        template <const char* Pattern, size_t Pos, tz::ZoneId Zone>
+        struct Compiler
+        {
+            static constexpr Token token = nextToken(Pattern, Pos);
+
+            static_assert(token.kind != TokenKind::Invalid,
+                          "Unknown or malformed flag in pattern. Custom flags are only supported by the runtime PatternFormatter");
+
+            static constexpr tz::ZoneId NextZone = token.kind == TokenKind::Zone ? tz::ZoneId::Local
+                : token.kind == TokenKind::Full                                  ? tz::ZoneId::Utc
+                                                                                 : Zone;
+
+            static void format(const Context& ctx, fmt::memory_buffer& out)
+            {
+                if constexpr (token.kind != TokenKind::End && token.kind != TokenKind::Invalid)
+                {
+                    if constexpr (token.kind == TokenKind::Literal)
+                        out.append(Pattern + token.begin, Pattern + token.end);
+                    else if constexpr (token.kind == TokenKind::Full)
+                        Compiler<FullPattern, 0, tz::ZoneId::Utc>::format(ctx, out);
+                    else if constexpr (token.kind == TokenKind::Flag && token.flag == 'f')
+                        FieldsFormatter::formatFields(std::string_view(Pattern + token.begin, token.end - token.begin), ctx.buffer, out);
+                    else if constexpr (token.kind == TokenKind::Flag)
+                        formatFlag<token.flag, Zone>(ctx, out);
+
+                    Compiler<Pattern, token.next, NextZone>::format(ctx, out);
+                }
+            }
+        };
+    }
+
+    // A PatternFormatter whose pattern has been parsed at compile-time. See PatternFormatter::compile
+    template <const char* Pattern>
+    class CompiledPatternFormatter : public Formatter
+    {
+    private:
+        static constexpr bool UsesUtc   = pattern_compiler::usesDateTime(Pattern, tz::ZoneId::Utc);
+        static constexpr bool UsesLocal = pattern_compiler::usesDateTime(Pattern, tz::ZoneId::Local);
+
+        void doFormat(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
+        {
+            pattern_compiler::Context ctx { name, level, buffer, {}, {} };
+
+            auto time = buffer.time();
+
+            if constexpr (UsesUtc)
+                ctx.utc = pattern_compiler::DateTime::from(time, tz::Utc::apply(time));
+
+            if constexpr (UsesLocal)
+                ctx.local = pattern_compiler::DateTime::from(time, tz::Local::apply(time));
+
+            pattern_compiler::Compiler<Pattern, 0, tz::ZoneId::Utc>::format(ctx, out);
+        }
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "logpp/utils/thread.h"
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace logpp::digits
+{
+    // The decimal rendering of every number in [0, 99], two characters per number
+    inline constexpr char TwoDigits[] = "00010203040506070809"
+                                        "10111213141516171819"
+                                        "20212223242526272829"
+                                        "30313233343536373839"
+                                        "40414243444546474849"
+                                        "50515253545556575859"
+                                        "60616263646566676869"
+                                        "70717273747576777879"
+                                        "80818283848586878889"
+                                        "90919293949596979899";
+
+    // Largest number that fits in `Width` digits
+    template <size_t Width>
+    constexpr uint32_t maxValue()
+    {
+        uint32_t max = 1;
+        for (size_t i = 0; i < Width; ++i)
+            max *= 10;
+        return max - 1;
+    }
+
+    // Write the last `Width` digits of `value` to `dest`, zero-padded, two digits at a time
+    template <size_t Width>
+    void writePadded(char* dest, uint32_t value)
+    {
+        static_assert(Width > 0 && Width <= 9, "Unsupported width");
+
+        auto* it = dest + Width;
+        for (size_t i = 0; i < Width / 2; ++i)
+        {
+            const auto* pair = &TwoDigits[(value % 100) * 2];
+            value /= 100;
+
+            *--it = pair[1];
+            *--it = pair[0];
+        }
+
+        if constexpr (Width % 2 == 1)
+            *--it = static_cast<char>('0' + value % 10);
+    }
+
+    inline void appendTwoDigits(fmt::memory_buffer& out, uint32_t value)
+    {
+        const auto* pair = &TwoDigits[value * 2];
+        out.append(pair, pair + 2);
+    }
+
+    // Append `value` without padding
+    template <typename Integer>
+    void appendDecimal(fmt::memory_buffer& out, Integer value)
+    {
+        if constexpr (std::is_unsigned_v<Integer> && sizeof(Integer) <= sizeof(uint32_t))
+        {
+            if (value < 100)
+            {
+                if (value < 10)
+                    out.push_back(static_cast<char>('0' + value));
+                else
+                    appendTwoDigits(out, value);
+                return;
+            }
+        }
+
+        fmt::format_int str(value);
+        out.append(str.data(), str.data() + str.size());
+    }
+
+    // Append `value` padded with zeros to `Width` digits, like "{:02}" does for a width of 2.
+    // Values larger than `Width` digits are written in full
+    template <size_t Width, typename Integer>
+    void appendPadded(fmt::memory_buffer& out, Integer value)
+    {
+        static_assert(std::is_integral_v<Integer>, "Only integers can be padded");
+
+        if constexpr (std::is_signed_v<Integer>)
+        {
+            if (value < 0)
+            {
+                fmt::format_to(out, "{:0{}}", value, Width);
+                return;
+            }
+        }
+
+        if (static_cast<std::make_unsigned_t<Integer>>(value) > maxValue<Width>())
+        {
+            appendDecimal(out, value);
+            return;
+        }
+
+        char digits[Width];
+        writePadded<Width>(digits, static_cast<uint32_t>(value));
+        out.append(digits, digits + Width);
+    }
+
+    // Append the decimal rendering of a thread id. Events of the same thread usually come
+    // in sequence, the last rendered ids are thus cached by the formatting thread
+    inline void appendThreadId(fmt::memory_buffer& out, thread_utils::id id)
+    {
+        struct Entry
+        {
+            thread_utils::id id;
+            uint8_t size;
+            char digits[23];
+        };
+
+        static constexpr size_t CacheSize = 16;
+        static thread_local Entry cache[CacheSize] = {};
+
+        auto value  = thread_utils::toInteger(id);
+        auto& entry = cache[static_cast<size_t>(value) % CacheSize];
+        if (entry.size == 0 || entry.id != id)
+        {
+            fmt::format_int str(value);
+            std::memcpy(entry.digits, str.data(), str.size());
+            entry.size = static_cast<uint8_t>(str.size());
+            entry.id   = id;
+        }
+
+        out.append(entry.digits, entry.digits + entry.size);
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <memory>
+
+namespace logpp
+{
+    // Reusable buffers to format events into.
+    //
+    // Buffers keep their storage between events, which means that after warming up,
+    // formatting an event larger than the inline capacity of fmt::memory_buffer does
+    // not allocate anymore. A context is owned either by a sink that is never called
+    // concurrently, or by a thread through `acquireScoped`.
+    class FormatContext
+    {
+    public:
+        // Capacity reserved up-front for each buffer
+        static constexpr size_t DefaultCapacity = 4096;
+
+        // Buffers that grew larger than this capacity, e.g to format a whole batch, are
+        // released when the context is given back to its thread
+        static constexpr size_t MaxRetainedCapacity = 1024 * 1024;
+
+        class Scoped;
+
+        explicit FormatContext(size_t capacity = DefaultCapacity)
+        {
+            m_out.reserve(capacity);
+            m_scratch.reserve(capacity);
+        }
+
+        // Return the output buffer, cleared
+        fmt::memory_buffer& out()
+        {
+            m_out.clear();
+            return m_out;
+        }
+
+        // Return a buffer for intermediate results, cleared
+        fmt::memory_buffer& scratch()
+        {
+            m_scratch.clear();
+            return m_scratch;
+        }
+
+        // Release the storage of the buffers that grew past `MaxRetainedCapacity`
+        void trim();
+
+        // Acquire the context of the calling thread. If the context of the thread is
+        // already in use, e.g when an event is logged while formatting another one, a
+        // new context is created for the scope instead
+        static Scoped acquireScoped();
+
+    private:
+        fmt::memory_buffer m_out;
+        fmt::memory_buffer m_scratch;
+    };
+
+    class FormatContext::Scoped
+    {
+    public:
+        friend class FormatContext;
+
+        Scoped(const Scoped&) = delete;
+        Scoped& operator=(const Scoped&) = delete;
+
+        ~Scoped();
+
+        FormatContext* operator->() const
+        {
+            return m_context;
+        }
+
+        FormatContext& operator*() const
+        {
+            return *m_context;
+        }
+
+    private:
+        FormatContext* m_context;
+        std::unique_ptr<FormatContext> m_owned;
+
+        Scoped(FormatContext* context, std::unique_ptr<FormatContext> owned)
+            : m_context(context)
+            , m_owned(std::move(owned))
+        { }
+    };
+}
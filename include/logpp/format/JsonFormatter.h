@@ -0,0 +1,64 @@
+#pragma once
+
+#include "logpp/format/Formatter.h"
+#include "logpp/format/flag/TimeZone.h"
+#include "logpp/format/flag/TimestampFormatter.h"
+
+#include <string>
+
+namespace logpp
+{
+    // Formats events as JSON objects, one per line when used by a sink (NDJSON).
+    // Fields of the event are written as members of the object, after the built-in members
+    //
+    //   {"ts":"2021-01-08T15:20:10.042007Z","lvl":"Info","logger":"MyLogger","msg":"Hello","user":"john"}
+    class JsonFormatter : public Formatter
+    {
+    public:
+        // Names of the built-in members. A member with an empty name is not written
+        struct Keys
+        {
+            std::string time    = "ts";
+            std::string level   = "lvl";
+            std::string logger  = "logger";
+            std::string message = "msg";
+            std::string file    = "file";
+            std::string line    = "line";
+        };
+
+        JsonFormatter();
+        explicit JsonFormatter(Keys keys);
+
+        void setKeys(Keys keys);
+
+        const Keys& keys() const
+        {
+            return m_keys;
+        }
+
+    private:
+        // A key, already quoted, escaped and followed by `:`
+        struct Member
+        {
+            std::string prefix;
+
+            bool enabled() const
+            {
+                return !prefix.empty();
+            }
+        };
+
+        Keys m_keys;
+
+        Member m_time;
+        Member m_level;
+        Member m_logger;
+        Member m_message;
+        Member m_file;
+        Member m_line;
+
+        TimestampFormatter<tz::Utc> m_timestamp;
+
+        void doFormat(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override;
+    };
+}
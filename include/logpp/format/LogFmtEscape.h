@@ -0,0 +1,48 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <string_view>
+
+namespace logpp::logfmt
+{
+    // Instruction sets used to scan values for characters that need quoting or escaping
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    enum class Quoting
+    {
+        IfNeeded,
+        Always
+    };
+
+    // Returns the best instruction set supported by the CPU, detected once at runtime
+    SimdLevel simdLevel();
+
+    // A value needs quoting if it contains a space, a control character, a `=`, a `"` or a `\`
+    bool needsQuoting(std::string_view value);
+
+    // Appends `value` to `out`, quoting it if needed. Inside quotes, `"`, `\` and control
+    // characters are escaped. Escape sequences are valid JSON, `Quoting::Always` thus
+    // writes a JSON string
+    void appendValue(fmt::memory_buffer& out, std::string_view value, Quoting quoting = Quoting::IfNeeded);
+
+    // Same as `appendValue` for a value that has already been written to `out` from `start`.
+    // The value is quoted and escaped in place, without going through a temporary buffer
+    void quoteInPlace(fmt::memory_buffer& out, size_t start, Quoting quoting = Quoting::IfNeeded);
+
+    namespace details
+    {
+        // Returns the index of the first character of [data, data + size) that needs quoting,
+        // or `size` if there is none
+        size_t findQuotable(SimdLevel level, const char* data, size_t size);
+
+        // Returns the index of the first character of [data, data + size) that needs escaping
+        // inside quotes, or `size` if there is none
+        size_t findEscapable(SimdLevel level, const char* data, size_t size);
+    }
+}
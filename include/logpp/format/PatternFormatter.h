@@ -1,5 +1,6 @@
 #pragma once
 
+#include "logpp/format/CompiledPatternFormatter.h"
 #include "logpp/format/Formatter.h"
 #include "logpp/format/flag/Formatter.h"
 #include "logpp/format/flag/TimeZone.h"
@@ -31,6 +32,17 @@ namespace logpp
 
         void setPattern(std::string pattern);
 
+        // Parses `Pattern` at compile-time and returns a formatter that formats it in a single
+        // inlined function, computing calendar fields once per event. Custom flags are not supported.
+        //
+        //   static constexpr char Pattern[] = "%Y-%m-%d %H:%M:%S [%l] %v";
+        //   auto formatter = PatternFormatter::compile<Pattern>();
+        template <const char* Pattern>
+        static std::shared_ptr<CompiledPatternFormatter<Pattern>> compile()
+        {
+            return std::make_shared<CompiledPatternFormatter<Pattern>>();
+        }
+
         template <typename F>
         static bool registerFlag(char flag)
         {
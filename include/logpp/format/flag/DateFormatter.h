@@ -1,5 +1,6 @@
 #pragma once
 
+#include "logpp/format/Digits.h"
 #include "logpp/format/flag/Formatter.h"
 #include "logpp/utils/date.h"
 
@@ -12,7 +13,7 @@ namespace logpp
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
             auto time = Tz::apply(buffer.time());
-            fmt::format_to(out, "{:04}", date_utils::year(time));
+            digits::appendPadded<4>(out, date_utils::year(time));
         }
     };
 
@@ -23,7 +24,7 @@ namespace logpp
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
             auto time = Tz::apply(buffer.time());
-            fmt::format_to(out, "{:02}", date_utils::month(time));
+            digits::appendPadded<2>(out, date_utils::month(time));
         }
     };
 
@@ -34,7 +35,7 @@ namespace logpp
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
             auto time = Tz::apply(buffer.time());
-            fmt::format_to(out, "{:02}", date_utils::day(time));
+            digits::appendPadded<2>(out, date_utils::day(time));
         }
     };
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "logpp/format/Digits.h"
+#include "logpp/format/LogFmtEscape.h"
 #include "logpp/format/flag/Formatter.h"
 
 namespace logpp
@@ -12,11 +14,16 @@ namespace logpp
         { }
 
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
+        {
+            formatFields(m_prefix, buffer, out);
+        }
+
+        static void formatFields(std::string_view prefix, const EventLogBuffer& buffer, fmt::memory_buffer& out)
         {
             Writer writer(out);
-            Visitor visitor(writer, m_prefix);
+            Visitor visitor(writer, prefix);
 
-            buffer.visitFields(visitor);
+            buffer.visitFieldsStatic(visitor);
         }
 
     private:
@@ -34,16 +41,27 @@ namespace logpp
 
             void write(std::string_view key, std::string_view value)
             {
-                if (value.find(' ') != std::string::npos)
-                    writeFmt("{}=\"{}\"", key, value);
-                else
-                    writeFmt("{}={}", key, value);
+                writeKey(key);
+                logfmt::appendValue(m_buf, value);
+            }
+
+            void write(std::string_view key, char value)
+            {
+                write(key, std::string_view(&value, 1));
             }
 
             template <typename Val>
             void write(std::string_view key, Val&& value)
             {
-                writeFmt("{}={}", key, std::forward<Val>(value));
+                if constexpr (std::is_integral_v<std::decay_t<Val>> && !std::is_same_v<std::decay_t<Val>, bool>)
+                {
+                    writeKey(key);
+                    digits::appendDecimal(m_buf, value);
+                }
+                else
+                {
+                    writeFmt("{}={}", key, std::forward<Val>(value));
+                }
             }
 
             template <typename... Args>
@@ -56,6 +74,16 @@ namespace logpp
                 ++m_count;
             }
 
+            void writeKey(std::string_view key)
+            {
+                if (m_count > 0)
+                    m_buf.push_back(' ');
+
+                m_buf.append(key.data(), key.data() + key.size());
+                m_buf.push_back('=');
+                ++m_count;
+            }
+
             const char* data() const
             {
                 return m_buf.data();
@@ -71,7 +99,7 @@ namespace logpp
             size_t m_count = 0;
         };
 
-        class Visitor : public LogFieldVisitor
+        class Visitor final : public LogFieldVisitor
         {
         public:
             Visitor(Writer& writer, std::string_view prefix)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "logpp/format/Digits.h"
 #include "logpp/format/flag/Formatter.h"
 #include "logpp/utils/file.h"
 
@@ -28,7 +29,7 @@ namespace logpp
             if (!location)
                 return;
 
-            fmt::format_to(out, "{}", location->line);
+            digits::appendDecimal(out, location->line);
         }
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "logpp/format/Digits.h"
 #include "logpp/format/flag/Formatter.h"
 #include "logpp/utils/thread.h"
 
@@ -9,7 +10,7 @@ namespace logpp
     {
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
-            fmt::format_to(out, "{}", thread_utils::toInteger(buffer.threadId()));
+            digits::appendThreadId(out, buffer.threadId());
         }
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "logpp/format/Digits.h"
 #include "logpp/format/flag/Formatter.h"
 #include "logpp/utils/date.h"
 
@@ -11,7 +12,7 @@ namespace logpp
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
             auto time = Tz::apply(buffer.time());
-            fmt::format_to(out, "{:02}", date_utils::hours(time));
+            digits::appendPadded<2>(out, date_utils::hours(time));
         }
     };
 
@@ -21,7 +22,7 @@ namespace logpp
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
             auto time = Tz::apply(buffer.time());
-            fmt::format_to(out, "{:02}", date_utils::minutes(time));
+            digits::appendPadded<2>(out, date_utils::minutes(time));
         }
     };
 
@@ -31,21 +32,22 @@ namespace logpp
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
             auto time = Tz::apply(buffer.time());
-            fmt::format_to(out, "{:02}", date_utils::seconds(time));
+            digits::appendPadded<2>(out, date_utils::seconds(time));
         }
     };
 
+    // Time zones are offset by whole seconds, sub-second flags thus do not need to convert the time
+
     template<typename Tz>
     class MillisecondsFormatter : public FlagFormatter
     {
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
-            auto time  = Tz::apply(buffer.time());
-            auto epoch = time.time_since_epoch();
+            auto epoch = buffer.time().time_since_epoch();
 
             epoch -= std::chrono::duration_cast<std::chrono::seconds>(epoch);
             auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(epoch);
-            fmt::format_to(out, "{:03}", ms.count());
+            digits::appendPadded<3>(out, ms.count());
         }
     };
 
@@ -54,14 +56,13 @@ namespace logpp
     {
         void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
         {
-            auto time  = Tz::apply(buffer.time());
-            auto epoch = time.time_since_epoch();
+            auto epoch = buffer.time().time_since_epoch();
 
             epoch -= std::chrono::duration_cast<std::chrono::seconds>(epoch);
             epoch -= std::chrono::duration_cast<std::chrono::milliseconds>(epoch);
 
             auto us = std::chrono::duration_cast<std::chrono::microseconds>(epoch);
-            fmt::format_to(out, "{:03}", us.count());
+            digits::appendPadded<3>(out, us.count());
         }
     };
 }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "logpp/format/Digits.h"
+#include "logpp/format/flag/Formatter.h"
+#include "logpp/utils/date.h"
+
+#include <atomic>
+#include <vector>
+
+namespace logpp
+{
+    // A flag of a TimestampFormatter, or a literal if `flag` is 0
+    struct TimestampPart
+    {
+        char flag;
+        std::string literal;
+    };
+
+    inline bool isTimestampFlag(char flag)
+    {
+        switch (flag)
+        {
+        case 'Y':
+        case 'm':
+        case 'd':
+        case 'H':
+        case 'M':
+        case 'S':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Formats a run of second-resolution date and time flags (%Y %m %d %H %M %S) along with the
+    // literals between them. The rendered bytes are cached and only rendered again when the
+    // second of the event changes, converting the time to the zone once per second.
+    //
+    // The formatter might be shared by multiple threads: every thread keeps its own cache, so
+    // that formatting a timestamp of the same second neither locks nor writes shared memory
+    template <typename Tz>
+    class TimestampFormatter : public FlagFormatter
+    {
+    public:
+        explicit TimestampFormatter(std::vector<TimestampPart> parts)
+            : m_parts(std::move(parts))
+            , m_id(s_nextId.fetch_add(1, std::memory_order_relaxed))
+        { }
+
+        void format(std::string_view, LogLevel, const EventLogBuffer& buffer, fmt::memory_buffer& out) const override
+        {
+            auto second = std::chrono::floor<std::chrono::seconds>(buffer.time());
+
+            auto& cached = cache()[m_id % CacheSize];
+            if (cached.id != m_id || cached.second != second)
+            {
+                cached.rendered.clear();
+                render(second, cached.rendered);
+
+                cached.id     = m_id;
+                cached.second = second;
+            }
+
+            out.append(cached.rendered.data(), cached.rendered.data() + cached.rendered.size());
+        }
+
+    private:
+        using Second = std::chrono::time_point<Clock, std::chrono::seconds>;
+
+        // Timestamp last rendered by a thread for the formatter of id `id`, 0 if none
+        struct CachedSecond
+        {
+            uint64_t id { 0 };
+            Second second;
+            fmt::memory_buffer rendered;
+        };
+
+        // A thread rarely formats with more than a few formatters, the cache is direct-mapped
+        static constexpr size_t CacheSize = 4;
+
+        static CachedSecond* cache()
+        {
+            static thread_local CachedSecond cached[CacheSize];
+            return cached;
+        }
+
+        // Unique across formatters, the address of a destroyed formatter can be reused
+        static inline std::atomic<uint64_t> s_nextId { 1 };
+
+        std::vector<TimestampPart> m_parts;
+        uint64_t m_id;
+
+        void render(Second second, fmt::memory_buffer& out) const
+        {
+            auto time = Tz::apply(second);
+            auto dp   = date::floor<date::days>(time);
+
+            date::year_month_day ymd { dp };
+            auto hms = date::make_time(time - dp);
+
+            for (const auto& part : m_parts)
+            {
+                switch (part.flag)
+                {
+                case 'Y':
+                    digits::appendPadded<4>(out, static_cast<int>(ymd.year()));
+                    break;
+                case 'm':
+                    digits::appendPadded<2>(out, static_cast<unsigned>(ymd.month()));
+                    break;
+                case 'd':
+                    digits::appendPadded<2>(out, static_cast<unsigned>(ymd.day()));
+                    break;
+                case 'H':
+                    digits::appendPadded<2>(out, hms.hours().count());
+                    break;
+                case 'M':
+                    digits::appendPadded<2>(out, hms.minutes().count());
+                    break;
+                case 'S':
+                    digits::appendPadded<2>(out, hms.seconds().count());
+                    break;
+                default:
+                    out.append(part.literal.data(), part.literal.data() + part.literal.size());
+                    break;
+                }
+            }
+        }
+    };
+}
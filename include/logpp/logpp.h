@@ -1,5 +1,6 @@
 #pragma once
 
+#include "logpp/core/CallSite.h"
 #include "logpp/core/Logger.h"
 #include "logpp/core/LoggerRegistry.h"
 
@@ -10,27 +11,86 @@
 
 namespace logpp
 {
-#define LOGPP_LOG(str, level, ...)                                           \
-    do                                                                       \
-    {                                                                        \
-        logpp::log(level, str, logpp::SourceLocation { __FILE__, __LINE__ }, \
-                   __VA_ARGS__);                                             \
+// The level is checked before the text and the fields are evaluated: nothing is
+// formatted nor copied for a statement whose level is disabled.
+//
+// Every statement has a CallSite, that can be enabled or disabled at runtime regardless
+// of the level of the logger, see CallSiteRegistry.
+//
+// `guard` is a declaration placed before `logger` is evaluated, and that keeps it alive.
+// `text` is the statement as written, stringized by the macro the user called
+#define LOGPP_LOGGER_LOG_IMPL(guard, logger, str, text, level, ...)                        \
+    do                                                                                     \
+    {                                                                                      \
+        if (LOGPP_IS_ACTIVE(level))                                                        \
+        {                                                                                  \
+            static logpp::CallSite logppSite_ { __FILE__, __LINE__, level, text };         \
+            auto logppState_ = logppSite_.state();                                         \
+            if (logppState_ != logpp::CallSiteState::Disabled)                             \
+            {                                                                              \
+                guard;                                                                     \
+                const auto& logppLogger_ = (logger);                                       \
+                if (logppLogger_                                                           \
+                    && (logppState_ == logpp::CallSiteState::Enabled                       \
+                        || logppLogger_->is(level)))                                       \
+                    logppLogger_->forceLog(str, level,                                     \
+                                           logpp::SourceLocation { __FILE__, __LINE__ },   \
+                                           __VA_ARGS__);                                   \
+            }                                                                              \
+        }                                                                                  \
     } while (0)
 
-#define LOGPP_TRACE(str, ...) \
-    LOGPP_LOG(str, logpp::LogLevel::Trace, __VA_ARGS__)
+#define LOGPP_LOGGER_LOG(logger, str, level, ...) \
+    LOGPP_LOGGER_LOG_IMPL(, logger, str, #str, level, __VA_ARGS__)
 
-#define LOGPP_DEBUG(str, ...) \
-    LOGPP_LOG(str, logpp::LogLevel::Debug, __VA_ARGS__)
+// The default logger is read without touching its reference count, inside an Epoch guard
+#define LOGPP_LOG_TEXT(str, text, level, ...)                              \
+    LOGPP_LOGGER_LOG_IMPL(logpp::Epoch::Guard logppGuard_,                 \
+                          logpp::defaultRegistry().guardedDefaultLogger(), \
+                          str, text, level, __VA_ARGS__)
 
-#define LOGPP_INFO(str, ...) \
-    LOGPP_LOG(str, logpp::LogLevel::Info, __VA_ARGS__)
+#define LOGPP_LOG(str, level, ...) \
+    LOGPP_LOG_TEXT(str, #str, level, __VA_ARGS__)
 
-#define LOGPP_WARN(str, ...) \
-    LOGPP_LOG(str, logpp::LogLevel::Warning, __VA_ARGS__)
+#define LOGPP_DISABLED_LOG(...) \
+    do                          \
+    {                           \
+    } while (0)
+
+#if LOGPP_ACTIVE_LEVEL <= LOGPP_LEVEL_TRACE
+  #define LOGPP_TRACE(str, ...) \
+      LOGPP_LOG_TEXT(str, #str, logpp::LogLevel::Trace, __VA_ARGS__)
+#else
+  #define LOGPP_TRACE(...) LOGPP_DISABLED_LOG()
+#endif
+
+#if LOGPP_ACTIVE_LEVEL <= LOGPP_LEVEL_DEBUG
+  #define LOGPP_DEBUG(str, ...) \
+      LOGPP_LOG_TEXT(str, #str, logpp::LogLevel::Debug, __VA_ARGS__)
+#else
+  #define LOGPP_DEBUG(...) LOGPP_DISABLED_LOG()
+#endif
 
-#define LOGPP_ERROR(str, ...) \
-    LOGPP_LOG(str, logpp::LogLevel::Error, __VA_ARGS__)
+#if LOGPP_ACTIVE_LEVEL <= LOGPP_LEVEL_INFO
+  #define LOGPP_INFO(str, ...) \
+      LOGPP_LOG_TEXT(str, #str, logpp::LogLevel::Info, __VA_ARGS__)
+#else
+  #define LOGPP_INFO(...) LOGPP_DISABLED_LOG()
+#endif
+
+#if LOGPP_ACTIVE_LEVEL <= LOGPP_LEVEL_WARN
+  #define LOGPP_WARN(str, ...) \
+      LOGPP_LOG_TEXT(str, #str, logpp::LogLevel::Warning, __VA_ARGS__)
+#else
+  #define LOGPP_WARN(...) LOGPP_DISABLED_LOG()
+#endif
+
+#if LOGPP_ACTIVE_LEVEL <= LOGPP_LEVEL_ERROR
+  #define LOGPP_ERROR(str, ...) \
+      LOGPP_LOG_TEXT(str, #str, logpp::LogLevel::Error, __VA_ARGS__)
+#else
+  #define LOGPP_ERROR(...) LOGPP_DISABLED_LOG()
+#endif
 
 #define LOGPP_FORMAT(str, ...) \
     logpp::format(str, __VA_ARGS__)
@@ -135,7 +195,9 @@ namespace logpp
     template <typename Str, typename... Args>
     void log(LogLevel level, Str text, Args&&... args)
     {
-        log(defaultLogger(), level, text, std::forward<Args>(args)...);
+        Epoch::Guard guard;
+        if (auto* logger = defaultRegistry().guardedDefaultLogger())
+            logger->log(text, level, std::forward<Args>(args)...);
     }
 
     template <typename Str, typename... Args>
@@ -4,6 +4,9 @@
 #include "logpp/queue/ITypedAsyncQueue.h"
 #include "logpp/threading/AffinityMask.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <variant>
@@ -17,11 +20,36 @@ namespace logpp
     public:
         static constexpr size_t DefaultInternalQueueSize = 16;
 
+        // How the poller waits when all of its queues are empty
+        enum class WaitStrategy {
+            // Keep polling. Lowest latency, but the poller always consumes a full core
+            BusySpin,
+
+            // Spin for a while, then park until a producer notifies the poller.
+            // Notifying costs producers a seq_cst fence per event
+            Hybrid,
+
+            // Park as soon as the queues are empty. Producers pay the same fence as Hybrid
+            Blocking
+        };
+
+        static constexpr int32_t DefaultHybridSpinCount = 6;
+        static constexpr std::chrono::milliseconds DefaultMaxParkDuration { 100 };
+
         struct Options
         {
             //ThreadHelper::ThreadPriority priority;
             std::optional<threading::AffinityMask> affinity;
             size_t internalQueueSize = DefaultInternalQueueSize;
+
+            WaitStrategy waitStrategy = WaitStrategy::Hybrid;
+
+            // Number of exponential spins before parking with the Hybrid strategy
+            int32_t hybridSpinCount = DefaultHybridSpinCount;
+
+            // Maximum time to stay parked without being notified. Guards against queues
+            // whose producers do not notify the poller
+            std::chrono::milliseconds maxParkDuration = DefaultMaxParkDuration;
         };
 
         static const Options DefaultOptions;
@@ -36,6 +64,8 @@ namespace logpp
         void addQueue(std::shared_ptr<IAsyncQueue> queue) override;
         std::future<size_t> removeQueue(std::shared_ptr<IAsyncQueue> queue) override;
 
+        void notify() override;
+
     private:
         AsyncQueuePoller(Options options);
 
@@ -65,11 +95,23 @@ namespace logpp
 
         std::atomic<bool> m_stopSignal { false };
 
+        // Set by the poller before parking, producers only take the lock to wake it up
+        // when it is set
+        std::atomic<bool> m_sleeping { false };
+
+        std::mutex m_parkMutex;
+        std::condition_variable m_parkCv;
+        bool m_notified { false };
+
         void handleEntry(StopEntry entry);
         void handleEntry(QueueEntry entry);
 
         void handleQueue(QueueEntry entry);
         void run(Options options);
+
+        size_t pollAll();
+        void idleAll();
+        void park(const Options& options);
     };
 
 }
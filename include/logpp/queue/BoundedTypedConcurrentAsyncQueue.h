@@ -2,6 +2,7 @@
 
 #include "logpp/core/config.h"
 
+#include "logpp/queue/EntryDispatcher.h"
 #include "logpp/queue/ITypedAsyncQueue.h"
 // Disable structure padding warning C4324
 #if defined(LOGPP_COMPILER_MSVC)
@@ -14,6 +15,7 @@
 #endif
 
 #include <climits>
+#include <cstdint>
 
 namespace logpp
 {
@@ -22,45 +24,50 @@ namespace logpp
     class BoundedTypedConcurrentAsyncQueue : public ITypedAsyncQueue<Entry>
     {
     public:
-        using Handler = typename ITypedAsyncQueue<Entry>::Handler;
+        using Handler      = typename ITypedAsyncQueue<Entry>::Handler;
+        using BatchHandler = typename ITypedAsyncQueue<Entry>::BatchHandler;
 
         explicit BoundedTypedConcurrentAsyncQueue(size_t size)
             : m_queue(roundNextPowerOfTwo(size))
         { }
 
         size_t poll() override
+        {
+            return pollBatch(SIZE_MAX);
+        }
+
+        size_t pollOne() override
+        {
+            return pollBatch(1);
+        }
+
+        size_t pollBatch(size_t maxCount) override
         {
             size_t totalCount = 0;
 
-            for (;;)
+            while (totalCount < maxCount)
             {
                 Entry entry;
                 auto res = m_queue.try_pop(entry);
                 if (!res)
                     break;
 
-                handleEntry(entry);
+                m_dispatcher.dispatch(entry);
                 ++totalCount;
             }
 
+            m_dispatcher.flush();
             return totalCount;
         }
 
-        size_t pollOne() override
+        void setHandler(const Handler& handler) override
         {
-            Entry entry;
-            if (m_queue.try_pop(entry))
-            {
-                handleEntry(entry);
-                return 1;
-            }
-
-            return 0;
+            m_dispatcher.setHandler(handler);
         }
 
-        void setHandler(const Handler& handler) override
+        void setBatchHandler(const BatchHandler& handler, size_t maxBatchSize) override
         {
-            m_handler = handler;
+            m_dispatcher.setBatchHandler(handler, maxBatchSize);
         }
 
         void push(const Entry& entry) override
@@ -73,17 +80,21 @@ namespace logpp
             m_queue.push(std::move(entry));
         }
 
+        bool tryPush(const Entry& entry) override
+        {
+            return m_queue.try_push(entry);
+        }
+
+        bool tryPop(Entry& entry) override
+        {
+            return m_queue.try_pop(entry);
+        }
+
     private:
         using Queue = rigtorp::MPMCQueue<Entry>;
         Queue m_queue;
 
-        Handler m_handler;
-
-        void handleEntry(const Entry& entry)
-        {
-            if (m_handler)
-                m_handler(entry);
-        }
+        EntryDispatcher<Entry> m_dispatcher;
 
         static size_t roundNextPowerOfTwo(size_t value)
         {
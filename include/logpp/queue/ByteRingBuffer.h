@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace logpp
+{
+    // A contiguous ring of bytes holding variable-length records.
+    //
+    // Writers reserve the exact size of their record (rounded up to the record
+    // alignment), write it in place and then commit it. A record never wraps
+    // around the end of the ring: when it does not fit in the remaining contiguous
+    // space, a padding record is inserted and the record is written at the start
+    // of the ring.
+    //
+    // There can only be a single reader. When `MultiProducer` is false, there
+    // must also only be a single writer and reservation is wait-free.
+    template <bool MultiProducer>
+    class ByteRingBuffer
+    {
+    public:
+        static constexpr size_t CacheLineSize   = 64;
+        static constexpr size_t RecordAlignment = 8;
+
+        explicit ByteRingBuffer(size_t capacity)
+            : m_capacity(roundNextPowerOfTwo(std::clamp(capacity, MinCapacity, MaxCapacity)))
+            , m_mask(m_capacity - 1)
+            , m_data(new uint64_t[m_capacity / sizeof(uint64_t)]())
+        { }
+
+        size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        // Maximum size of a record that can be written in this ring
+        size_t maxRecordSize() const
+        {
+            return m_capacity / 2 - sizeof(RecordHeader);
+        }
+
+        // Try to write a record of `size` bytes. `writer` is called with a pointer
+        // to the reserved bytes. Returns false if there is not enough free space
+        template <typename Writer>
+        bool tryWrite(size_t size, Writer&& writer)
+        {
+            if (size > maxRecordSize())
+                return false;
+
+            const auto recordSize = align(sizeof(RecordHeader) + size);
+
+            uint64_t head    = m_head.load(std::memory_order_relaxed);
+            uint64_t padding = 0;
+            for (;;)
+            {
+                auto contiguous = m_capacity - (head & m_mask);
+                padding         = recordSize > contiguous ? contiguous : 0;
+
+                auto required = padding + recordSize;
+                // The cached tail is shared between writers and must also synchronize with
+                // the reader, which zeroed the free space before moving the tail
+                if (head + required - m_tailCache.load(std::memory_order_acquire) > m_capacity)
+                {
+                    auto tail = m_tail.load(std::memory_order_acquire);
+                    m_tailCache.store(tail, std::memory_order_release);
+
+                    if (head + required - tail > m_capacity)
+                        return false;
+                }
+
+                if constexpr (MultiProducer)
+                {
+                    if (m_head.compare_exchange_weak(head, head + required, std::memory_order_relaxed))
+                        break;
+                }
+                else
+                {
+                    m_head.store(head + required, std::memory_order_relaxed);
+                    break;
+                }
+            }
+
+            if (padding > 0)
+            {
+                commit(head, padding, RecordKind::Padding);
+                head += padding;
+            }
+
+            writer(recordAt(head) + sizeof(RecordHeader));
+            commit(head, recordSize, RecordKind::Data);
+
+            return true;
+        }
+
+        // Write a record of `size` bytes, yielding while the ring is full.
+        // Returns false if the record can never fit in the ring
+        template <typename Writer>
+        bool write(size_t size, Writer&& writer)
+        {
+            if (size > maxRecordSize())
+                return false;
+
+            while (!tryWrite(size, writer))
+                std::this_thread::yield();
+
+            return true;
+        }
+
+        // Read up to `maxCount` committed records in order. `reader` is called with a
+        // pointer to the record and its size, as given to `write`, rounded up to the
+        // record alignment
+        template <typename Reader>
+        size_t read(Reader&& reader, size_t maxCount = SIZE_MAX)
+        {
+            size_t count = 0;
+            while (count < maxCount)
+            {
+                auto* header = headerAt(m_readHead);
+                auto size    = header->size.load(std::memory_order_acquire);
+                if (size == 0)
+                    break;
+
+                if (header->kind == RecordKind::Data)
+                {
+                    reader(recordAt(m_readHead) + sizeof(RecordHeader), size - sizeof(RecordHeader));
+                    ++count;
+                }
+
+                consume(size);
+            }
+
+            return count;
+        }
+
+        // Call `reader` with the next committed record without consuming it.
+        // Returns false if there is no committed record
+        template <typename Reader>
+        bool peek(Reader&& reader)
+        {
+            for (;;)
+            {
+                auto* header = headerAt(m_readHead);
+                auto size    = header->size.load(std::memory_order_acquire);
+                if (size == 0)
+                    return false;
+
+                if (header->kind == RecordKind::Padding)
+                {
+                    consume(size);
+                    continue;
+                }
+
+                reader(recordAt(m_readHead) + sizeof(RecordHeader), size - sizeof(RecordHeader));
+                return true;
+            }
+        }
+
+        bool empty() const
+        {
+            return headerAt(m_readHead)->size.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        static constexpr size_t MinCapacity = 4096;
+
+        // Sizes are stored on 32 bits in the header of a record
+        static constexpr size_t MaxCapacity = size_t(1) << 31;
+
+        enum class RecordKind : uint32_t {
+            Data,
+            Padding
+        };
+
+        struct RecordHeader
+        {
+            std::atomic<uint32_t> size;
+            RecordKind kind;
+        };
+
+        static_assert(sizeof(RecordHeader) == RecordAlignment);
+        static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+        const size_t m_capacity;
+        const size_t m_mask;
+
+        std::unique_ptr<uint64_t[]> m_data;
+
+        alignas(CacheLineSize) std::atomic<uint64_t> m_head { 0 };
+        alignas(CacheLineSize) std::atomic<uint64_t> m_tailCache { 0 };
+
+        alignas(CacheLineSize) std::atomic<uint64_t> m_tail { 0 };
+        uint64_t m_readHead { 0 };
+
+        char* recordAt(uint64_t position) const
+        {
+            return reinterpret_cast<char*>(m_data.get()) + (position & m_mask);
+        }
+
+        RecordHeader* headerAt(uint64_t position) const
+        {
+            return reinterpret_cast<RecordHeader*>(recordAt(position));
+        }
+
+        void consume(size_t size)
+        {
+            // Writers rely on the free space of the ring to be zeroed to detect
+            // whether a record has been committed
+            std::memset(recordAt(m_readHead), 0, size);
+
+            m_readHead += size;
+            m_tail.store(m_readHead, std::memory_order_release);
+        }
+
+        void commit(uint64_t position, size_t size, RecordKind kind)
+        {
+            auto* header = headerAt(position);
+            header->kind = kind;
+            header->size.store(static_cast<uint32_t>(size), std::memory_order_release);
+        }
+
+        static constexpr size_t align(size_t size)
+        {
+            return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+        }
+
+        static size_t roundNextPowerOfTwo(size_t value)
+        {
+            --value;
+            for (size_t i = 1; i < sizeof(size_t) * CHAR_BIT; i *= 2)
+            {
+                value |= value >> i;
+            }
+
+            return value + 1;
+        }
+    };
+}
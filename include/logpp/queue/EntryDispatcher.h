@@ -0,0 +1,75 @@
+#pragma once
+
+#include "logpp/utils/span.h"
+
+#include <functional>
+#include <vector>
+
+namespace logpp
+{
+    // Hands the entries polled from a queue to its handler, either one at a time or
+    // in batches when a batch handler has been set.
+    //
+    // In batch mode, entries are accumulated and dispatched once `maxBatchSize`
+    // entries have been polled or when the queue calls `flush` at the end of a poll
+    template <typename Entry>
+    class EntryDispatcher
+    {
+    public:
+        using Handler      = std::function<void(const Entry&)>;
+        using BatchHandler = std::function<void(Span<const Entry>)>;
+
+        void setHandler(const Handler& handler)
+        {
+            m_handler = handler;
+        }
+
+        void setBatchHandler(const BatchHandler& handler, size_t maxBatchSize)
+        {
+            m_batchHandler = handler;
+            m_maxBatchSize = maxBatchSize > 0 ? maxBatchSize : 1;
+            m_batch.reserve(m_maxBatchSize);
+        }
+
+        bool batching() const
+        {
+            return static_cast<bool>(m_batchHandler);
+        }
+
+        // Index of the next entry in the current batch
+        size_t batchIndex() const
+        {
+            return m_batch.size();
+        }
+
+        void dispatch(const Entry& entry)
+        {
+            if (!m_batchHandler)
+            {
+                if (m_handler)
+                    m_handler(entry);
+                return;
+            }
+
+            m_batch.push_back(entry);
+            if (m_batch.size() == m_maxBatchSize)
+                flush();
+        }
+
+        void flush()
+        {
+            if (m_batch.empty())
+                return;
+
+            m_batchHandler(Span<const Entry>(m_batch));
+            m_batch.clear();
+        }
+
+    private:
+        Handler m_handler;
+        BatchHandler m_batchHandler;
+
+        size_t m_maxBatchSize { 1 };
+        std::vector<Entry> m_batch;
+    };
+}
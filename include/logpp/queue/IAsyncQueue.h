@@ -11,5 +11,9 @@ namespace logpp
 
         virtual size_t pollOne() = 0;
         virtual size_t poll()    = 0;
+
+        // Called by the poller when none of its queues had entries to poll
+        virtual void onIdle()
+        { }
     };
 }
@@ -18,5 +18,9 @@ namespace logpp
 
         virtual void addQueue(std::shared_ptr<IAsyncQueue> queue)                   = 0;
         virtual std::future<size_t> removeQueue(std::shared_ptr<IAsyncQueue> queue) = 0;
+
+        // Signal the poller that an entry has been pushed to one of its queues.
+        // Must be called by producers after pushing to wake up a parked poller
+        virtual void notify() = 0;
     };
 }
@@ -2,6 +2,8 @@
 
 #include "logpp/queue/IAsyncQueue.h"
 
+#include "logpp/utils/span.h"
+
 #include <functional>
 
 namespace logpp
@@ -10,11 +12,52 @@ namespace logpp
     class ITypedAsyncQueue : public IAsyncQueue
     {
     public:
-        using Handler = std::function<void(const Entry&)>;
+        using Handler      = std::function<void(const Entry&)>;
+        using BatchHandler = std::function<void(Span<const Entry>)>;
+        using IdleHandler  = std::function<void()>;
 
         virtual void setHandler(const Handler& handler) = 0;
 
+        // Hand polled entries to `handler` in batches of at most `maxBatchSize` entries
+        // instead of one at a time. Takes precedence over the handler set by setHandler
+        virtual void setBatchHandler(const BatchHandler& handler, size_t maxBatchSize) = 0;
+
+        // Poll at most `maxCount` entries and hand them to the handler
+        virtual size_t pollBatch(size_t maxCount) = 0;
+
         virtual void push(const Entry& entry) = 0;
         virtual void push(Entry&& entry)      = 0;
+
+        // Push an entry if the queue is not full. Returns false otherwise
+        virtual bool tryPush(const Entry& entry) = 0;
+
+        // Remove the oldest entry of the queue without handling it. Only supported by
+        // queues that allow producers to consume entries, returns false otherwise
+        virtual bool tryPop(Entry& /* entry */)
+        {
+            return false;
+        }
+
+        // Whether the queue serializes entries when pushing them. Entries pushed to
+        // such a queue can refer to data that does not outlive the call to push
+        virtual bool serializesEntries() const
+        {
+            return false;
+        }
+
+        // Called from the polling thread when the poller is idle, see IAsyncQueue::onIdle
+        void setIdleHandler(const IdleHandler& handler)
+        {
+            m_idleHandler = handler;
+        }
+
+        void onIdle() override
+        {
+            if (m_idleHandler)
+                m_idleHandler();
+        }
+
+    private:
+        IdleHandler m_idleHandler;
     };
 }
@@ -0,0 +1,336 @@
+#pragma once
+
+#include "logpp/queue/ByteRingBuffer.h"
+#include "logpp/queue/EntryDispatcher.h"
+#include "logpp/queue/ITypedAsyncQueue.h"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace logpp
+{
+    // A queue where every producer thread lazily gets its own single-producer
+    // single-consumer ring of bytes. Producers never contend with each other: a push
+    // only touches the ring of the calling thread.
+    //
+    // `Serializer` must provide the same member functions as for
+    // RingTypedConcurrentAsyncQueue, as well as the following member function:
+    //  - TimePoint time(const char* data, size_t size) const
+    //
+    // When `ordered` is true, entries from different rings are merged by time
+    // while polling.
+    //
+    // Note that ordering is only guaranteed between entries that are visible when
+    // polling. An entry pushed after a later entry from another thread has already
+    // been polled will still be handled after it.
+    template <typename Entry, typename Serializer>
+    class PerThreadRingTypedAsyncQueue : public ITypedAsyncQueue<Entry>
+    {
+    public:
+        using Handler      = typename ITypedAsyncQueue<Entry>::Handler;
+        using BatchHandler = typename ITypedAsyncQueue<Entry>::BatchHandler;
+
+        PerThreadRingTypedAsyncQueue(size_t capacityPerThread, bool ordered, Serializer serializer = Serializer {})
+            : m_id(nextId())
+            , m_capacityPerThread(capacityPerThread)
+            , m_ordered(ordered)
+            , m_serializer(std::move(serializer))
+            , m_sharedRing(capacityPerThread)
+        { }
+
+        ~PerThreadRingTypedAsyncQueue()
+        {
+            std::lock_guard guard(m_mutex);
+            for (auto& producer : m_producers)
+                producer->closed.store(true, std::memory_order_release);
+        }
+
+        size_t poll() override
+        {
+            return pollBatch(SIZE_MAX);
+        }
+
+        size_t pollOne() override
+        {
+            return pollBatch(1);
+        }
+
+        size_t pollBatch(size_t maxCount) override
+        {
+            auto count = m_ordered ? pollOrdered(maxCount) : pollUnordered(maxCount);
+            m_dispatcher.flush();
+            return count;
+        }
+
+        void setHandler(const Handler& handler) override
+        {
+            m_dispatcher.setHandler(handler);
+        }
+
+        void setBatchHandler(const BatchHandler& handler, size_t maxBatchSize) override
+        {
+            m_dispatcher.setBatchHandler(handler, maxBatchSize);
+        }
+
+        void push(const Entry& entry) override
+        {
+            auto size   = m_serializer.size(entry);
+            auto writer = [&](char* dest) {
+                m_serializer.write(entry, dest);
+            };
+
+            if (auto* producer = threadProducer())
+                producer->ring.write(size, writer);
+            else
+                m_sharedRing.write(size, writer);
+        }
+
+        void push(Entry&& entry) override
+        {
+            push(static_cast<const Entry&>(entry));
+        }
+
+        bool tryPush(const Entry& entry) override
+        {
+            auto size   = m_serializer.size(entry);
+            auto writer = [&](char* dest) {
+                m_serializer.write(entry, dest);
+            };
+
+            if (auto* producer = threadProducer())
+                return producer->ring.tryWrite(size, writer);
+
+            return m_sharedRing.tryWrite(size, writer);
+        }
+
+        bool serializesEntries() const override
+        {
+            return true;
+        }
+
+    private:
+        struct Producer
+        {
+            explicit Producer(size_t capacity)
+                : ring(capacity)
+            { }
+
+            ByteRingBuffer<false> ring;
+
+            // Set when the producer thread exited
+            std::atomic<bool> abandoned { false };
+
+            // Set when the queue has been destroyed
+            std::atomic<bool> closed { false };
+        };
+
+        // Producer of the last queue the thread pushed to
+        struct ThreadCache
+        {
+            uint64_t queueId;
+            Producer* producer;
+
+            static ThreadCache& instance()
+            {
+                static thread_local ThreadCache cache { 0, nullptr };
+                return cache;
+            }
+        };
+
+        struct ThreadProducers
+        {
+            std::vector<std::pair<uint64_t, std::shared_ptr<Producer>>> producers;
+
+            ~ThreadProducers()
+            {
+                for (auto& producer : producers)
+                    producer.second->abandoned.store(true, std::memory_order_release);
+
+                ThreadCache::instance() = ThreadCache { 0, nullptr };
+                exited()                = true;
+            }
+
+            static bool& exited()
+            {
+                static thread_local bool value = false;
+                return value;
+            }
+        };
+
+        const uint64_t m_id;
+        const size_t m_capacityPerThread;
+        const bool m_ordered;
+
+        Serializer m_serializer;
+
+        // Used by threads that log while exiting, after their thread-local storage
+        // has been destroyed
+        ByteRingBuffer<true> m_sharedRing;
+
+        std::mutex m_mutex;
+        std::vector<std::shared_ptr<Producer>> m_producers;
+        std::atomic<uint64_t> m_producersVersion { 0 };
+
+        // Only accessed by the polling thread
+        std::vector<Producer*> m_pollProducers;
+        uint64_t m_pollProducersVersion { 0 };
+
+        EntryDispatcher<Entry> m_dispatcher;
+
+        static uint64_t nextId()
+        {
+            static std::atomic<uint64_t> id { 0 };
+            return ++id;
+        }
+
+        Producer* threadProducer()
+        {
+            auto& cache = ThreadCache::instance();
+            if (cache.queueId == m_id)
+                return cache.producer;
+
+            if (ThreadProducers::exited())
+                return nullptr;
+
+            static thread_local ThreadProducers threadProducers;
+            auto& producers = threadProducers.producers;
+
+            // Forget about the rings of destroyed queues
+            producers.erase(std::remove_if(std::begin(producers), std::end(producers),
+                                           [](const auto& producer) {
+                                               return producer.second->closed.load(std::memory_order_acquire);
+                                           }),
+                            std::end(producers));
+
+            auto it = std::find_if(std::begin(producers), std::end(producers), [&](const auto& producer) {
+                return producer.first == m_id;
+            });
+
+            Producer* producer = nullptr;
+            if (it != std::end(producers))
+            {
+                producer = it->second.get();
+            }
+            else
+            {
+                auto newProducer = std::make_shared<Producer>(m_capacityPerThread);
+                producer         = newProducer.get();
+
+                producers.emplace_back(m_id, newProducer);
+                registerProducer(std::move(newProducer));
+            }
+
+            cache = ThreadCache { m_id, producer };
+            return producer;
+        }
+
+        void registerProducer(std::shared_ptr<Producer> producer)
+        {
+            std::lock_guard guard(m_mutex);
+            m_producers.push_back(std::move(producer));
+            m_producersVersion.fetch_add(1, std::memory_order_release);
+        }
+
+        void refreshProducers(bool force = false)
+        {
+            if (!force && m_producersVersion.load(std::memory_order_acquire) == m_pollProducersVersion)
+                return;
+
+            std::lock_guard guard(m_mutex);
+
+            // Rings of exited threads are dropped once they have been drained
+            m_producers.erase(std::remove_if(std::begin(m_producers), std::end(m_producers),
+                                             [](const auto& producer) {
+                                                 return producer->abandoned.load(std::memory_order_acquire) && producer->ring.empty();
+                                             }),
+                              std::end(m_producers));
+
+            m_pollProducers.clear();
+            for (const auto& producer : m_producers)
+                m_pollProducers.push_back(producer.get());
+
+            m_pollProducersVersion = m_producersVersion.load(std::memory_order_relaxed);
+        }
+
+        size_t pollUnordered(size_t maxCount)
+        {
+            refreshProducers();
+
+            auto reader = [&](const char* data, size_t size) {
+                handleEntry(data, size);
+            };
+
+            size_t count = 0;
+            for (auto* producer : m_pollProducers)
+            {
+                count += producer->ring.read(reader, maxCount - count);
+                if (count == maxCount)
+                    return count;
+            }
+
+            count += m_sharedRing.read(reader, maxCount - count);
+            if (count == 0)
+                reclaimAbandoned();
+
+            return count;
+        }
+
+        size_t pollOrdered(size_t maxCount)
+        {
+            refreshProducers();
+
+            using Time = decltype(m_serializer.time(nullptr, 0));
+
+            auto reader = [&](const char* data, size_t size) {
+                handleEntry(data, size);
+            };
+
+            size_t count = 0;
+            while (count < maxCount)
+            {
+                ByteRingBuffer<false>* nextRing = nullptr;
+                std::optional<Time> nextTime;
+
+                for (auto* producer : m_pollProducers)
+                {
+                    producer->ring.peek([&](const char* data, size_t size) {
+                        auto time = m_serializer.time(data, size);
+                        if (!nextTime || time < *nextTime)
+                        {
+                            nextTime = time;
+                            nextRing = &producer->ring;
+                        }
+                    });
+                }
+
+                if (nextRing == nullptr)
+                    break;
+
+                count += nextRing->read(reader, 1);
+            }
+
+            count += m_sharedRing.read(reader, maxCount - count);
+            if (count == 0)
+                reclaimAbandoned();
+
+            return count;
+        }
+
+        void reclaimAbandoned()
+        {
+            auto hasAbandoned = std::any_of(std::begin(m_pollProducers), std::end(m_pollProducers), [](const auto* producer) {
+                return producer->abandoned.load(std::memory_order_acquire);
+            });
+
+            if (hasAbandoned)
+                refreshProducers(true);
+        }
+
+        void handleEntry(const char* data, size_t size)
+        {
+            m_dispatcher.dispatch(m_serializer.read(data, size, m_dispatcher.batchIndex()));
+        }
+    };
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "logpp/queue/ByteRingBuffer.h"
+#include "logpp/queue/EntryDispatcher.h"
+#include "logpp/queue/ITypedAsyncQueue.h"
+
+namespace logpp
+{
+    // A multiple-producers single-consumer queue that serializes entries in a
+    // contiguous ring of bytes, each entry only taking the space it needs.
+    //
+    // `Serializer` must provide the following member functions:
+    //  - size_t size(const Entry& entry) const
+    //  - void write(const Entry& entry, char* dest) const
+    //  - Entry read(const char* data, size_t size, size_t index)
+    //
+    // `read` is only ever called from the polling thread. `index` is the index of the
+    // entry in the current batch: entries read with different indexes must remain
+    // valid until the batch has been handled. Entries that are bigger than half the
+    // capacity of the ring are dropped.
+    template <typename Entry, typename Serializer>
+    class RingTypedConcurrentAsyncQueue : public ITypedAsyncQueue<Entry>
+    {
+    public:
+        using Handler      = typename ITypedAsyncQueue<Entry>::Handler;
+        using BatchHandler = typename ITypedAsyncQueue<Entry>::BatchHandler;
+
+        explicit RingTypedConcurrentAsyncQueue(size_t capacity, Serializer serializer = Serializer {})
+            : m_ring(capacity)
+            , m_serializer(std::move(serializer))
+        { }
+
+        size_t poll() override
+        {
+            return pollBatch(SIZE_MAX);
+        }
+
+        size_t pollOne() override
+        {
+            return pollBatch(1);
+        }
+
+        size_t pollBatch(size_t maxCount) override
+        {
+            auto count = m_ring.read(
+                [&](const char* data, size_t size) {
+                    m_dispatcher.dispatch(m_serializer.read(data, size, m_dispatcher.batchIndex()));
+                },
+                maxCount);
+
+            m_dispatcher.flush();
+            return count;
+        }
+
+        void setHandler(const Handler& handler) override
+        {
+            m_dispatcher.setHandler(handler);
+        }
+
+        void setBatchHandler(const BatchHandler& handler, size_t maxBatchSize) override
+        {
+            m_dispatcher.setBatchHandler(handler, maxBatchSize);
+        }
+
+        void push(const Entry& entry) override
+        {
+            m_ring.write(m_serializer.size(entry), [&](char* dest) {
+                m_serializer.write(entry, dest);
+            });
+        }
+
+        void push(Entry&& entry) override
+        {
+            push(static_cast<const Entry&>(entry));
+        }
+
+        bool tryPush(const Entry& entry) override
+        {
+            return m_ring.tryWrite(m_serializer.size(entry), [&](char* dest) {
+                m_serializer.write(entry, dest);
+            });
+        }
+
+        bool serializesEntries() const override
+        {
+            return true;
+        }
+
+        size_t capacity() const
+        {
+            return m_ring.capacity();
+        }
+
+    private:
+        ByteRingBuffer<true> m_ring;
+        Serializer m_serializer;
+
+        EntryDispatcher<Entry> m_dispatcher;
+    };
+}
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "logpp/queue/EntryDispatcher.h"
 #include "logpp/queue/ITypedAsyncQueue.h"
 
+#include <cstdint>
 #include <deque>
 #include <mutex>
 
@@ -11,43 +13,48 @@ namespace logpp
     class SimpleBlockingQueue : public ITypedAsyncQueue<Entry>
     {
     public:
-        using Handler = typename ITypedAsyncQueue<Entry>::Handler;
+        using Handler      = typename ITypedAsyncQueue<Entry>::Handler;
+        using BatchHandler = typename ITypedAsyncQueue<Entry>::BatchHandler;
 
         size_t poll() override
+        {
+            return pollBatch(SIZE_MAX);
+        }
+
+        size_t pollOne() override
+        {
+            return pollBatch(1);
+        }
+
+        size_t pollBatch(size_t maxCount) override
         {
             size_t totalCount = 0;
 
             std::scoped_lock<std::mutex> guard { m_mutex };
 
-            for (;;)
+            while (totalCount < maxCount)
             {
                 if (m_queue.empty())
                     break;
 
                 auto& entry = m_queue.front();
-                handleEntry(entry);
+                m_dispatcher.dispatch(entry);
                 m_queue.pop_front();
                 ++totalCount;
             }
 
+            m_dispatcher.flush();
             return totalCount;
         }
 
-        size_t pollOne() override
+        void setHandler(const Handler& handler) override
         {
-            std::scoped_lock<std::mutex> guard { m_mutex };
-            if (m_queue.empty())
-                return 0;
-
-            auto& entry = m_queue.front();
-            handleEntry(entry);
-            m_queue.pop_front();
-            return 1;
+            m_dispatcher.setHandler(handler);
         }
 
-        void setHandler(const Handler& handler) override
+        void setBatchHandler(const BatchHandler& handler, size_t maxBatchSize) override
         {
-            m_handler = handler;
+            m_dispatcher.setBatchHandler(handler, maxBatchSize);
         }
 
         void push(const Entry& entry) override
@@ -62,16 +69,16 @@ namespace logpp
             m_queue.push_back(std::move(entry));
         }
 
+        bool tryPush(const Entry& entry) override
+        {
+            push(entry);
+            return true;
+        }
+
     private:
         std::mutex m_mutex;
         std::deque<Entry> m_queue;
 
-        Handler m_handler;
-
-        void handleEntry(const Entry& entry)
-        {
-            if (m_handler)
-                m_handler(entry);
-        }
+        EntryDispatcher<Entry> m_dispatcher;
     };
 }
@@ -1,14 +1,22 @@
 #pragma once
 
+#include "logpp/core/EventLogBufferPool.h"
 #include "logpp/core/LoggerRegistry.h"
 
 #include "logpp/queue/AsyncQueuePoller.h"
 #include "logpp/queue/BoundedTypedConcurrentAsyncQueue.h"
+#include "logpp/queue/PerThreadRingTypedAsyncQueue.h"
+#include "logpp/queue/RingTypedConcurrentAsyncQueue.h"
 
+#include "logpp/sinks/FormatPipeline.h"
 #include "logpp/sinks/MultiSink.h"
 #include "logpp/sinks/Sink.h"
 #include "logpp/utils/string.h"
 
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace logpp::sink
 {
     class AsyncSink : public SinkBase,
@@ -19,11 +27,79 @@ namespace logpp::sink
 
         AsyncSink() = default;
 
+        enum class QueueType {
+            // Fixed-size slots holding a pointer to a pooled buffer, size is a number of entries
+            Bounded,
+
+            // Events serialized in a contiguous ring of bytes, size is a number of bytes
+            Ring,
+
+            // Events serialized in a ring of bytes per producer thread, size is the number of
+            // bytes of every ring
+            PerThreadRing
+        };
+
+        // What to do with an event when the queue is full
+        enum class Backpressure {
+            // Wait for the queue to have room for the event, at most `blockTimeout` if
+            // not zero. The event is dropped if the timeout expires
+            Block,
+
+            // Drop the event
+            DropNewest,
+
+            // Drop the oldest event of the queue to make room for the event. Only supported
+            // by the Bounded queue
+            DropOldest,
+
+            // Sink the event synchronously from the calling thread
+            Sync
+        };
+
+        static constexpr size_t DefaultBoundedQueueSize       = 512;
+        static constexpr size_t DefaultRingQueueSize          = 1 * 1024 * 1024;
+        static constexpr size_t DefaultPerThreadRingQueueSize = 256 * 1024;
+
+        static constexpr std::chrono::seconds DefaultDropReportInterval { 1 };
+
+        static constexpr size_t DefaultBatchSize = 64;
+
+        // Name of the logger of the event reporting dropped events
+        static constexpr std::string_view DropReportLoggerName = "logpp";
+
+        struct QueueOptions
+        {
+            QueueType type = QueueType::Bounded;
+            size_t size    = DefaultBoundedQueueSize;
+
+            // Merge events of all producers by time, only used by PerThreadRing
+            bool ordered = false;
+
+            Backpressure backpressure = Backpressure::Block;
+            std::chrono::nanoseconds blockTimeout { 0 };
+
+            // Minimum interval between two events reporting the number of dropped events
+            std::chrono::nanoseconds dropReportInterval { DefaultDropReportInterval };
+
+            // Maximum number of events handed to the inner sink at once
+            size_t batchSize = DefaultBatchSize;
+
+            // Number of threads formatting batches in parallel, 0 to format them on the
+            // polling thread. Batches are still written in order by a single thread. Requires
+            // an inner sink that can format concurrently, see FormattedSink
+            size_t formatThreads = 0;
+        };
+
         AsyncSink(std::shared_ptr<IAsyncQueuePoller> queuePoller, std::shared_ptr<sink::Sink> innerSink)
+            : AsyncSink(std::move(queuePoller), std::move(innerSink), QueueOptions {})
+        { }
+
+        AsyncSink(std::shared_ptr<IAsyncQueuePoller> queuePoller, std::shared_ptr<sink::Sink> innerSink, const QueueOptions& queueOptions)
             : m_queuePoller(std::move(queuePoller))
-            , m_queue(std::make_shared<BoundedTypedConcurrentAsyncQueue<Entry>>(512))
+            , m_queue(createQueue(queueOptions))
+            , m_queueOptions(queueOptions)
             , m_innerSink(std::move(innerSink))
-
+            , m_pipeline(createPipeline(m_innerSink, queueOptions))
         { }
 
         void activateOptions(const Options& options) override
@@ -53,6 +129,8 @@ namespace logpp::sink
             auto innerSink = innerSinks.size() == 1 ? innerSinks[0] : std::make_shared<MultiSink>(std::move(innerSinks));
 
             std::shared_ptr<ITypedAsyncQueue<Entry>> queue;
+            QueueOptions queueConfig;
+
             auto queueOptions = options.tryGet("queue");
             if (queueOptions)
             {
@@ -60,38 +138,20 @@ namespace logpp::sink
                 if (!queueOptionsDict)
                     raiseConfigurationError("queue: expected table");
 
-                auto queueTypeIt = queueOptionsDict->find("type");
-                if (queueTypeIt == std::end(*queueOptionsDict))
-                    raiseConfigurationError("queue: expected `type` parameter");
-
-                if (string_utils::iequals(queueTypeIt->second, "bounded"))
-                {
-                    auto queueSizeIt = queueOptionsDict->find("size");
-                    size_t queueSize = 512;
-                    if (queueSizeIt != std::end(*queueOptionsDict))
-                    {
-                        auto size = string_utils::parseSize(queueSizeIt->second);
-                        if (!size)
-                            raiseConfigurationError("queue: invalid size `{}`", queueSizeIt->second);
-
-                        queueSize = *size;
-                    }
-
-                    queue = std::make_shared<BoundedTypedConcurrentAsyncQueue<Entry>>(queueSize);
-                }
-                else
-                {
-                    raiseConfigurationError("queue: unknown type `{}`", queueTypeIt->second);
-                }
+                queueConfig = parseQueueOptions(*queueOptionsDict);
+                queue       = createQueue(queueConfig);
             }
 
             if (!queue)
                 raiseConfigurationError("queue: unexpected error");
 
+            // The queue is configured from the parsed options, batch size included
+            m_queueOptions = queueConfig;
             configureQueue(queue);
 
             m_queue     = queue;
             m_innerSink = std::move(innerSink);
+            m_pipeline     = createPipeline(m_innerSink, m_queueOptions);
 
             m_queuePoller = AsyncQueuePoller::create();
             m_queuePoller->addQueue(m_queue);
@@ -100,7 +160,20 @@ namespace logpp::sink
 
         void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
         {
-            m_queue->push(Entry::create(name, level, buffer));
+            if (m_queue->serializesEntries())
+            {
+                push(Entry::borrow(name, level, buffer));
+            }
+            else
+            {
+                auto* node     = EventLogBufferPool::acquire();
+                node->buffer() = buffer;
+
+                if (!push(Entry::create(name, level, node)))
+                    EventLogBufferPool::release(node);
+            }
+
+            m_queuePoller->notify();
         }
 
         void start()
@@ -119,33 +192,411 @@ namespace logpp::sink
             return m_innerSink;
         }
 
+        // Total number of events dropped because the queue was full
+        uint64_t droppedCount() const
+        {
+            return m_droppedCount.load(std::memory_order_relaxed);
+        }
+
     private:
+        // When the queue does not serialize entries, only a pointer to a pooled buffer
+        // goes through the queue. The buffer is given back to the pool of the producer
+        // once the inner sink has run
         struct Entry
         {
-            static Entry create(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+            static Entry create(std::string_view name, LogLevel level, EventLogBufferPool::Node* node)
             {
-                return Entry { name, level, buffer };
+                return Entry { name, level, &node->buffer(), node };
+            }
+
+            static Entry borrow(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+            {
+                return Entry { name, level, &buffer, nullptr };
             }
 
             std::string_view name;
             LogLevel level;
-            EventLogBuffer logBuffer;
+
+            const EventLogBuffer* buffer;
+            EventLogBufferPool::Node* node;
+        };
+
+        class EntrySerializer
+        {
+        public:
+            size_t size(const Entry& entry) const
+            {
+                return sizeof(Prefix) + entry.buffer->size();
+            }
+
+            void write(const Entry& entry, char* dest) const
+            {
+                Prefix prefix { entry.name.data(), entry.name.size(), entry.level, entry.buffer->size() };
+                std::memcpy(dest, &prefix, sizeof(Prefix));
+                std::memcpy(dest + sizeof(Prefix), entry.buffer->data(), entry.buffer->size());
+            }
+
+            TimePoint time(const char* data, size_t) const
+            {
+                return EventLogBuffer::decodeTime(data + sizeof(Prefix));
+            }
+
+            Entry read(const char* data, size_t, size_t index)
+            {
+                // Buffers are kept from one batch to the other and never move
+                while (m_buffers.size() <= index)
+                    m_buffers.emplace_back();
+
+                Prefix prefix;
+                std::memcpy(&prefix, data, sizeof(Prefix));
+
+                auto& buffer = m_buffers[index];
+                buffer.assign(data + sizeof(Prefix), prefix.bufferSize);
+
+                return Entry::borrow(std::string_view(prefix.name, prefix.nameSize), prefix.level, buffer);
+            }
+
+        private:
+            struct Prefix
+            {
+                const char* name;
+                size_t nameSize;
+                LogLevel level;
+                size_t bufferSize;
+            };
+
+            std::deque<EventLogBuffer> m_buffers;
         };
 
         std::shared_ptr<IAsyncQueuePoller> m_queuePoller;
         std::shared_ptr<ITypedAsyncQueue<Entry>> m_queue;
+        QueueOptions m_queueOptions;
+
         std::shared_ptr<sink::Sink> m_innerSink;
 
+        // Serializes calls to the inner sink when events can also be sunk by producers
+        std::mutex m_syncMutex;
+
+        std::atomic<uint64_t> m_droppedCount { 0 };
+
+        // Only accessed by the polling thread
+        uint64_t m_reportedDroppedCount { 0 };
+        TimePoint m_lastDropReport {};
+        std::vector<EventRecord> m_records;
+
+        // Declared last to be stopped before the members its threads use are destroyed
+        std::unique_ptr<FormatPipeline> m_pipeline;
+
         void configureQueue(const std::shared_ptr<ITypedAsyncQueue<Entry>>& queue)
         {
-            queue->setHandler([self = shared_from_this()](const Entry& entry) {
-                self->handleEntry(entry);
+            queue->setBatchHandler(
+                [self = shared_from_this()](Span<const Entry> entries) {
+                    self->handleBatch(entries);
+                    self->reportDropped();
+                },
+                m_queueOptions.batchSize);
+
+            queue->setIdleHandler([self = shared_from_this()] {
+                self->handleIdle();
             });
         }
 
+        // Push an entry to the queue according to the backpressure policy.
+        // Returns false if the entry has been dropped
+        bool push(const Entry& entry)
+        {
+            switch (m_queueOptions.backpressure)
+            {
+            case Backpressure::Block:
+                if (m_queueOptions.blockTimeout.count() == 0)
+                {
+                    m_queue->push(entry);
+                    return true;
+                }
+                return pushBlocking(entry);
+            case Backpressure::DropNewest:
+                if (m_queue->tryPush(entry))
+                    return true;
+                break;
+            case Backpressure::DropOldest:
+                while (!m_queue->tryPush(entry))
+                {
+                    Entry oldest;
+                    if (m_queue->tryPop(oldest))
+                    {
+                        EventLogBufferPool::release(oldest.node);
+                        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                return true;
+            case Backpressure::Sync:
+                if (!m_queue->tryPush(entry))
+                    handleEntry(entry);
+                return true;
+            }
+
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        bool pushBlocking(const Entry& entry)
+        {
+            if (m_queue->tryPush(entry))
+                return true;
+
+            auto deadline = std::chrono::steady_clock::now() + m_queueOptions.blockTimeout;
+            do
+            {
+                std::this_thread::yield();
+                if (m_queue->tryPush(entry))
+                    return true;
+            } while (std::chrono::steady_clock::now() < deadline);
+
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
         void handleEntry(const Entry& entry)
         {
-            m_innerSink->sink(entry.name, entry.level, entry.logBuffer);
+            EventLogBufferPool::Ptr node { entry.node };
+            sinkInner(entry.name, entry.level, *entry.buffer);
+        }
+
+        void handleBatch(Span<const Entry> entries)
+        {
+            // Give the buffers back to the pool even if the inner sink throws
+            struct NodesGuard
+            {
+                Span<const Entry> entries;
+
+                ~NodesGuard()
+                {
+                    for (const auto& entry : entries)
+                        EventLogBufferPool::release(entry.node);
+                }
+            } nodesGuard { entries };
+
+            m_records.clear();
+            for (const auto& entry : entries)
+                m_records.push_back(EventRecord { entry.name, entry.level, entry.buffer });
+
+            sinkBatchInner(m_records);
+        }
+
+        void sinkBatchInner(Span<const EventRecord> records)
+        {
+            if (m_pipeline)
+            {
+                m_pipeline->submit(records);
+            }
+            else if (m_queueOptions.backpressure == Backpressure::Sync)
+            {
+                std::lock_guard guard(m_syncMutex);
+                m_innerSink->sinkBatch(records);
+            }
+            else
+            {
+                m_innerSink->sinkBatch(records);
+            }
+        }
+
+        void handleIdle()
+        {
+            // Formatted batches are written by the pipeline, the inner sink must not be used
+            // by both threads at once
+            if (m_pipeline)
+                m_pipeline->drain();
+
+            if (m_queueOptions.backpressure == Backpressure::Sync)
+            {
+                std::lock_guard guard(m_syncMutex);
+                m_innerSink->onIdle();
+            }
+            else
+            {
+                m_innerSink->onIdle();
+            }
+        }
+
+        void sinkInner(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+        {
+            if (m_queueOptions.backpressure == Backpressure::Sync)
+            {
+                std::lock_guard guard(m_syncMutex);
+                m_innerSink->sink(name, level, buffer);
+            }
+            else
+            {
+                m_innerSink->sink(name, level, buffer);
+            }
+        }
+
+        void reportDropped()
+        {
+            auto droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+            if (droppedCount == m_reportedDroppedCount)
+                return;
+
+            auto now = Clock::now();
+            if (now - m_lastDropReport < m_queueOptions.dropReportInterval)
+                return;
+
+            auto dropped = droppedCount - m_reportedDroppedCount;
+
+            EventLogBuffer buffer;
+            buffer.writeTime(now);
+            buffer.writeThreadId(thread_utils::getCurrentId());
+            buffer.writeText(logpp::format("{} events dropped", dropped));
+            buffer.writeFields(logpp::field("dropped", dropped));
+
+            EventRecord record { DropReportLoggerName, LogLevel::Warning, &buffer };
+            sinkBatchInner(Span<const EventRecord>(&record, 1));
+
+            m_reportedDroppedCount = droppedCount;
+            m_lastDropReport       = now;
+        }
+
+        static QueueOptions parseQueueOptions(const Options::Dict& options)
+        {
+            QueueOptions queueOptions;
+
+            auto typeIt = options.find("type");
+            if (typeIt == std::end(options))
+                raiseConfigurationError("queue: expected `type` parameter");
+
+            if (string_utils::iequals(typeIt->second, "ring"))
+            {
+                queueOptions.type = QueueType::Ring;
+                queueOptions.size = DefaultRingQueueSize;
+            }
+            else if (string_utils::iequals(typeIt->second, "per_thread_ring"))
+            {
+                queueOptions.type = QueueType::PerThreadRing;
+                queueOptions.size = DefaultPerThreadRingQueueSize;
+            }
+            else if (!string_utils::iequals(typeIt->second, "bounded"))
+            {
+                raiseConfigurationError("queue: unknown type `{}`", typeIt->second);
+            }
+
+            auto sizeIt = options.find("size");
+            if (sizeIt != std::end(options))
+            {
+                auto size = string_utils::parseSize(sizeIt->second);
+                if (!size)
+                    raiseConfigurationError("queue: invalid size `{}`", sizeIt->second);
+
+                queueOptions.size = *size;
+            }
+
+            auto orderedIt = options.find("ordered");
+            if (orderedIt != std::end(options))
+            {
+                auto ordered = string_utils::parseBool(orderedIt->second);
+                if (!ordered)
+                    raiseConfigurationError("queue: invalid ordered `{}`", orderedIt->second);
+
+                queueOptions.ordered = *ordered;
+            }
+
+            auto backpressureIt = options.find("backpressure");
+            if (backpressureIt != std::end(options))
+            {
+                const auto& backpressure = backpressureIt->second;
+                if (string_utils::iequals(backpressure, "block"))
+                    queueOptions.backpressure = Backpressure::Block;
+                else if (string_utils::iequals(backpressure, "drop_newest"))
+                    queueOptions.backpressure = Backpressure::DropNewest;
+                else if (string_utils::iequals(backpressure, "drop_oldest"))
+                    queueOptions.backpressure = Backpressure::DropOldest;
+                else if (string_utils::iequals(backpressure, "sync"))
+                    queueOptions.backpressure = Backpressure::Sync;
+                else
+                    raiseConfigurationError("queue: unknown backpressure `{}`", backpressure);
+            }
+
+            auto parseDurationOption = [&](std::string_view key, std::chrono::nanoseconds& value) {
+                auto it = options.find(std::string(key));
+                if (it == std::end(options))
+                    return;
+
+                auto ok = string_utils::parseDuration(it->second, [&](auto duration) {
+                    value = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+                });
+
+                if (!ok)
+                    raiseConfigurationError("queue: invalid {} `{}`", key, it->second);
+            };
+
+            auto batchSizeIt = options.find("batch_size");
+            if (batchSizeIt != std::end(options))
+            {
+                auto batchSize = string_utils::parseSize(batchSizeIt->second);
+                if (!batchSize || *batchSize == 0)
+                    raiseConfigurationError("queue: invalid batch_size `{}`", batchSizeIt->second);
+
+                queueOptions.batchSize = *batchSize;
+            }
+
+            auto formatThreadsIt = options.find("format_threads");
+            if (formatThreadsIt != std::end(options))
+            {
+                auto formatThreads = string_utils::parseSize(formatThreadsIt->second);
+                if (!formatThreads)
+                    raiseConfigurationError("queue: invalid format_threads `{}`", formatThreadsIt->second);
+
+                queueOptions.formatThreads = *formatThreads;
+            }
+
+            parseDurationOption("timeout", queueOptions.blockTimeout);
+            parseDurationOption("drop_report_interval", queueOptions.dropReportInterval);
+
+            return queueOptions;
+        }
+
+        std::unique_ptr<FormatPipeline> createPipeline(const std::shared_ptr<Sink>& innerSink, const QueueOptions& options)
+        {
+            if (options.formatThreads == 0)
+                return nullptr;
+
+            auto formattedSink = std::dynamic_pointer_cast<FormattedSink>(innerSink);
+            if (!formattedSink || !formattedSink->canFormatConcurrently())
+                raiseConfigurationError("queue: `format_threads` requires a sink that can format events concurrently");
+
+            return std::make_unique<FormatPipeline>(
+                options.formatThreads,
+                [formattedSink](Span<const EventRecord> records, fmt::memory_buffer& out) {
+                    formattedSink->formatBatch(records, out);
+                },
+                [this, formattedSink](std::string_view data, LogLevel maxLevel) {
+                    if (m_queueOptions.backpressure == Backpressure::Sync)
+                    {
+                        std::lock_guard guard(m_syncMutex);
+                        formattedSink->writeFormatted(data, maxLevel);
+                    }
+                    else
+                    {
+                        formattedSink->writeFormatted(data, maxLevel);
+                    }
+                });
+        }
+
+        static std::shared_ptr<ITypedAsyncQueue<Entry>> createQueue(const QueueOptions& options)
+        {
+            if (options.backpressure == Backpressure::DropOldest && options.type != QueueType::Bounded)
+                raiseConfigurationError("queue: `drop_oldest` backpressure is only supported by bounded queue");
+
+            switch (options.type)
+            {
+            case QueueType::Bounded:
+                return std::make_shared<BoundedTypedConcurrentAsyncQueue<Entry>>(options.size);
+            case QueueType::Ring:
+                return std::make_shared<RingTypedConcurrentAsyncQueue<Entry, EntrySerializer>>(options.size);
+            case QueueType::PerThreadRing:
+                return std::make_shared<PerThreadRingTypedAsyncQueue<Entry, EntrySerializer>>(options.size, options.ordered);
+            }
+
+            return nullptr;
         }
     };
 }
@@ -1,5 +1,6 @@
 #include "logpp/sinks/FormatSink.h"
 
+#include "logpp/format/FormatContext.h"
 #include "logpp/format/PatternFormatter.h"
 
 #include "logpp/utils/rang.hpp"
@@ -151,7 +152,8 @@ namespace logpp::sink
 
         void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
         {
-            fmt::memory_buffer formatBuf;
+            auto context    = FormatContext::acquireScoped();
+            auto& formatBuf = context->out();
             format(name, level, buffer, formatBuf);
 
             std::lock_guard guard(m_mutex);
@@ -1,3 +1,4 @@
+#include "logpp/format/FormatContext.h"
 #include "logpp/format/PatternFormatter.h"
 #include "logpp/sinks/FormatSink.h"
 
@@ -21,7 +22,8 @@ namespace logpp::sink
 
         void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
         {
-            fmt::memory_buffer formatBuf;
+            auto context    = FormatContext::acquireScoped();
+            auto& formatBuf = context->out();
             format(name, level, buffer, formatBuf);
 
             std::lock_guard guard(m_mutex);
@@ -29,6 +31,20 @@ namespace logpp::sink
             m_os.put('\n');
         }
 
+        void sinkBatch(Span<const EventRecord> records) override
+        {
+            auto context    = FormatContext::acquireScoped();
+            auto& formatBuf = context->out();
+            for (const auto& record : records)
+            {
+                format(record.name, record.level, *record.buffer, formatBuf);
+                formatBuf.push_back('\n');
+            }
+
+            std::lock_guard guard(m_mutex);
+            m_os.write(formatBuf.data(), formatBuf.size());
+        }
+
     private:
         std::mutex m_mutex;
         std::ostream& m_os;
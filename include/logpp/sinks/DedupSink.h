@@ -0,0 +1,104 @@
+#pragma once
+
+#include "logpp/format/FormatContext.h"
+#include "logpp/sinks/FilterSink.h"
+
+#include "logpp/utils/hash.h"
+#include "logpp/utils/thread.h"
+
+#include <atomic>
+
+namespace logpp::sink
+{
+    // Collapses identical consecutive events into a single one, followed by an event
+    // reporting how many times it has been repeated once a different event is logged.
+    //
+    // Events are identical when they have the same logger, level and text, fields are not
+    // compared. Only a hash of the last event is kept, in an atomic: when events of several
+    // threads are interleaved, repetitions are collapsed as they are observed and the
+    // counts reported are approximate
+    class DedupSink : public FilterSink
+    {
+    public:
+        static constexpr std::string_view Name = "Dedup";
+
+        // Name of the logger of the event reporting repetitions
+        static constexpr std::string_view ReportLoggerName = "logpp";
+
+        DedupSink() = default;
+
+        explicit DedupSink(std::shared_ptr<Sink> inner)
+            : FilterSink(std::move(inner))
+        { }
+
+        // Number of events collapsed so far
+        uint64_t repeatedCount() const
+        {
+            return m_repeatedCount.load(std::memory_order_relaxed);
+        }
+
+    protected:
+        bool accept(const EventRecord& record, Reporter& reporter) override
+        {
+            auto key  = keyOf(record);
+            auto last = m_last.load(std::memory_order_relaxed);
+            if (last == key)
+            {
+                m_repeated.fetch_add(1, std::memory_order_relaxed);
+                m_repeatedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // The thread replacing the last event reports its repetitions
+            if (m_last.compare_exchange_strong(last, key, std::memory_order_relaxed))
+            {
+                if (auto repeated = m_repeated.exchange(0, std::memory_order_relaxed))
+                    reportRepeated(record, levelOf(last), repeated, reporter);
+            }
+
+            return true;
+        }
+
+    private:
+        // Hash of the logger and the text of the last event, its level in the top byte
+        std::atomic<uint64_t> m_last { 0 };
+
+        // Repetitions of the last event not reported yet
+        std::atomic<uint64_t> m_repeated { 0 };
+
+        std::atomic<uint64_t> m_repeatedCount { 0 };
+
+        static constexpr int LevelShift = 56;
+
+        static uint64_t keyOf(const EventRecord& record)
+        {
+            auto context = FormatContext::acquireScoped();
+
+            auto& text = context->scratch();
+            record.buffer->formatText(text);
+
+            auto hash = hash_utils::fnv1a(record.name);
+            hash      = hash_utils::fnv1a(std::string_view(text.data(), text.size()), hash);
+
+            // 0 stands for no event, and is never the key of an event
+            auto level = static_cast<uint64_t>(record.level) + 1;
+            return (hash >> 8) | (level << LevelShift);
+        }
+
+        static LogLevel levelOf(uint64_t key)
+        {
+            return static_cast<LogLevel>((key >> LevelShift) - 1);
+        }
+
+        static void reportRepeated(const EventRecord& record, LogLevel level, uint64_t repeated, Reporter& reporter)
+        {
+            EventLogBuffer buffer;
+            buffer.writeTime(record.buffer->time());
+            buffer.writeThreadId(thread_utils::getCurrentId());
+            buffer.writeText(logpp::format("Last message repeated {} times", repeated));
+            buffer.writeFields(logpp::field("repeated", repeated));
+
+            reporter.report(ReportLoggerName, level, buffer);
+        }
+    };
+}
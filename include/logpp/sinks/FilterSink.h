@@ -0,0 +1,121 @@
+#pragma once
+
+#include "logpp/core/LoggerRegistry.h"
+
+#include "logpp/sinks/MultiSink.h"
+#include "logpp/sinks/Sink.h"
+
+#include <vector>
+
+namespace logpp::sink
+{
+    // Base of the sinks forwarding to an inner sink the events they let through.
+    //
+    // Filters are called by the logging threads concurrently, and must thus only rely on
+    // lock-free state. They are cheap enough to be placed in front of an AsyncSink, and drop
+    // events before they are enqueued
+    class FilterSink : public SinkBase
+    {
+    public:
+        FilterSink() = default;
+
+        explicit FilterSink(std::shared_ptr<Sink> inner)
+            : m_inner(std::move(inner))
+        { }
+
+        // Resolve the `sinks` parameter, the names of the sinks to forward events to
+        void activateOptions(const Options& options) override
+        {
+            auto sinksOptions = options.tryGet("sinks");
+            if (!sinksOptions)
+                raiseConfigurationError("expected `sinks` parameter");
+
+            auto sinksArray = sinksOptions->asArray();
+            if (!sinksArray)
+                raiseConfigurationError("sinks: expected array");
+
+            if (sinksArray->empty())
+                raiseConfigurationError("sinks: got empty array");
+
+            auto& registry = LoggerRegistry::defaultRegistry();
+
+            std::vector<std::shared_ptr<Sink>> innerSinks;
+            for (const auto& sinkName : *sinksArray)
+            {
+                auto sink = registry.findSink(sinkName);
+                if (sink == nullptr)
+                    raiseConfigurationError("sinks: unknown sink `{}`", sinkName);
+
+                innerSinks.push_back(std::move(sink));
+            }
+
+            m_inner = innerSinks.size() == 1 ? innerSinks[0] : std::make_shared<MultiSink>(std::move(innerSinks));
+        }
+
+        void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
+        {
+            Reporter reporter(*m_inner, nullptr);
+            if (accept(EventRecord { name, level, &buffer }, reporter))
+                m_inner->sink(name, level, buffer);
+        }
+
+        void sinkBatch(Span<const EventRecord> records) override
+        {
+            std::vector<EventRecord> accepted;
+            accepted.reserve(records.size());
+
+            Reporter reporter(*m_inner, &accepted);
+            for (const auto& record : records)
+            {
+                if (accept(record, reporter))
+                    accepted.push_back(record);
+            }
+
+            if (!accepted.empty())
+                m_inner->sinkBatch(accepted);
+        }
+
+        void onIdle() override
+        {
+            m_inner->onIdle();
+        }
+
+        const std::shared_ptr<Sink>& innerSink() const
+        {
+            return m_inner;
+        }
+
+    protected:
+        // Forwards the events generated by a filter, e.g to report the events it dropped,
+        // in order with the events the filter let through
+        class Reporter
+        {
+        public:
+            Reporter(Sink& inner, std::vector<EventRecord>* accepted)
+                : m_inner(inner)
+                , m_accepted(accepted)
+            { }
+
+            void report(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+            {
+                if (m_accepted && !m_accepted->empty())
+                {
+                    m_inner.sinkBatch(*m_accepted);
+                    m_accepted->clear();
+                }
+
+                m_inner.sink(name, level, buffer);
+            }
+
+        private:
+            Sink& m_inner;
+            std::vector<EventRecord>* m_accepted;
+        };
+
+        // Whether the event is forwarded to the inner sink. Called concurrently
+        virtual bool accept(const EventRecord& record, Reporter& reporter) = 0;
+
+    private:
+        std::shared_ptr<Sink> m_inner;
+    };
+}
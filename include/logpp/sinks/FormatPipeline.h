@@ -0,0 +1,89 @@
+#pragma once
+
+#include "logpp/sinks/Sink.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace logpp::sink
+{
+    // Formats batches of events on a pool of threads, and writes them from a single
+    // thread in the order they have been submitted.
+    //
+    // Events are copied when submitted, their buffers can thus be reused as soon as
+    // `submit` returns. Submitting blocks when all the batches in flight are still being
+    // formatted or written, which pushes backpressure back to the queue being drained
+    class FormatPipeline
+    {
+    public:
+        // Format a batch of events into `out`. Called concurrently by the format threads
+        using FormatFunc = std::function<void(Span<const EventRecord> records, fmt::memory_buffer& out)>;
+
+        // Write a formatted batch, `maxLevel` being the highest level of its events
+        using WriteFunc = std::function<void(std::string_view data, LogLevel maxLevel)>;
+
+        // Number of batches in flight per format thread
+        static constexpr size_t BatchesPerThread = 2;
+
+        FormatPipeline(size_t formatThreads, FormatFunc format, WriteFunc write);
+        ~FormatPipeline();
+
+        FormatPipeline(const FormatPipeline&) = delete;
+        FormatPipeline& operator=(const FormatPipeline&) = delete;
+
+        // Hand a batch of events to the pipeline. Must always be called by the same thread
+        void submit(Span<const EventRecord> records);
+
+        // Wait for all the batches submitted so far to be written
+        void drain();
+
+        size_t formatThreads() const;
+
+    private:
+        enum class State {
+            Free,
+            Submitted,
+            Formatted
+        };
+
+        struct Batch
+        {
+            State state { State::Free };
+
+            // Buffers never move when the deque grows, records can point to them
+            std::deque<EventLogBuffer> buffers;
+            std::vector<EventRecord> records;
+            LogLevel maxLevel { LogLevel::Trace };
+
+            fmt::memory_buffer out;
+        };
+
+        FormatFunc m_format;
+        WriteFunc m_write;
+
+        // Batch of sequence number `n` lives in slot `n % m_batches.size()`
+        std::vector<Batch> m_batches;
+
+        std::mutex m_mutex;
+        std::condition_variable m_submittedCond;
+        std::condition_variable m_formattedCond;
+        std::condition_variable m_writtenCond;
+
+        uint64_t m_submitted { 0 };
+        uint64_t m_nextToFormat { 0 };
+        uint64_t m_written { 0 };
+        bool m_stopping { false };
+
+        std::vector<std::thread> m_formatThreads;
+        std::thread m_writeThread;
+
+        Batch& slot(uint64_t sequence);
+
+        void formatLoop();
+        void writeLoop();
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "logpp/format/Formatter.h"
+#include "logpp/format/JsonFormatter.h"
 #include "logpp/format/LogFmtFormatter.h"
 #include "logpp/format/PatternFormatter.h"
 
@@ -30,6 +31,8 @@ namespace logpp::sink
                             setFormatter(std::make_shared<PatternFormatter>());
                         else if (string_utils::iequals(*formatStr, "logfmt"))
                             setFormatter(std::make_shared<LogFmtFormatter>());
+                        else if (string_utils::iequals(*formatStr, "json"))
+                            setFormatter(std::make_shared<JsonFormatter>());
                         else
                             raiseConfigurationError("format: unknown formatter {}", *formatStr);
                     }
@@ -45,6 +48,8 @@ namespace logpp::sink
                             setFormatter(std::make_shared<PatternFormatter>(std::move(pattern)));
                         else if (string_utils::iequals(typeIt->second, "logfmt"))
                             setFormatter(std::make_shared<LogFmtFormatter>(std::move(pattern)));
+                        else if (string_utils::iequals(typeIt->second, "json"))
+                            setFormatter(std::make_shared<JsonFormatter>(parseJsonKeys(*opts)));
                         else
                             raiseConfigurationError("format: invalid `type` {}", typeIt->second);
                     }
@@ -75,6 +80,26 @@ namespace logpp::sink
             return defaultValue;
         }
 
+        JsonFormatter::Keys parseJsonKeys(const Options::Dict& opts)
+        {
+            JsonFormatter::Keys keys;
+
+            auto parseKey = [&](const char* name, std::string& key) {
+                auto it = opts.find(name);
+                if (it != std::end(opts))
+                    key = it->second;
+            };
+
+            parseKey("time_key", keys.time);
+            parseKey("level_key", keys.level);
+            parseKey("logger_key", keys.logger);
+            parseKey("message_key", keys.message);
+            parseKey("file_key", keys.file);
+            parseKey("line_key", keys.line);
+
+            return keys;
+        }
+
         virtual void configureFormatter(const std::shared_ptr<Formatter>&) { }
 
     protected:
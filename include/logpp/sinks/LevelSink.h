@@ -3,6 +3,9 @@
 #include "logpp/core/LogLevel.h"
 #include "logpp/sinks/Sink.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace logpp::sink
 {
     class LevelSink : public SinkBase
@@ -26,6 +29,26 @@ namespace logpp::sink
             m_inner->sink(name, level, buffer);
         }
 
+        void sinkBatch(Span<const EventRecord> records) override
+        {
+            auto isEnabled = [&](const EventRecord& record) { return is(record.level); };
+            if (std::all_of(std::begin(records), std::end(records), isEnabled))
+            {
+                m_inner->sinkBatch(records);
+                return;
+            }
+
+            std::vector<EventRecord> enabled;
+            std::copy_if(std::begin(records), std::end(records), std::back_inserter(enabled), isEnabled);
+            if (!enabled.empty())
+                m_inner->sinkBatch(enabled);
+        }
+
+        void onIdle() override
+        {
+            m_inner->onIdle();
+        }
+
         bool is(LogLevel level) const
         {
             return static_cast<int>(level) >= static_cast<int>(m_level);
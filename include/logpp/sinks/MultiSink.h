@@ -34,6 +34,22 @@ namespace logpp::sink
             }
         }
 
+        void sinkBatch(Span<const EventRecord> records) override
+        {
+            for (auto& sink : m_innerSinks)
+            {
+                sink->sinkBatch(records);
+            }
+        }
+
+        void onIdle() override
+        {
+            for (auto& sink : m_innerSinks)
+            {
+                sink->onIdle();
+            }
+        }
+
     private:
         std::vector<SinkPtr> m_innerSinks;
     };
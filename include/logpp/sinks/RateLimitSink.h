@@ -0,0 +1,224 @@
+#pragma once
+
+#include "logpp/sinks/FilterSink.h"
+
+#include "logpp/utils/hash.h"
+#include "logpp/utils/string.h"
+#include "logpp/utils/thread.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace logpp::sink
+{
+    // Lets through at most `rate` events per period, plus bursts of up to `burst` events,
+    // with a separate budget for every logger, level or call site.
+    //
+    // Budgets are token buckets implemented as a single atomic per key (GCRA), updated with
+    // a compare-and-swap. Keys are hashed into a fixed number of buckets, keys colliding
+    // share the same budget. Time is taken from the events themselves.
+    //
+    // The first event let through after some events of its bucket have been dropped is
+    // preceded by a warning reporting the number of dropped events
+    class RateLimitSink : public FilterSink
+    {
+    public:
+        static constexpr std::string_view Name = "RateLimit";
+
+        static constexpr size_t BucketCount = 256;
+
+        // What a budget is shared by
+        enum class Key {
+            Global,
+            Logger,
+            Level,
+            CallSite
+        };
+
+        struct Limit
+        {
+            // Number of events per period
+            size_t rate = 0;
+            std::chrono::nanoseconds period { std::chrono::seconds(1) };
+
+            // Maximum number of events let through at once, `rate` if 0
+            size_t burst = 0;
+        };
+
+        RateLimitSink() = default;
+
+        RateLimitSink(std::shared_ptr<Sink> inner, const Limit& limit, Key key = Key::Logger)
+            : FilterSink(std::move(inner))
+        {
+            setLimit(limit, key);
+        }
+
+        void activateOptions(const Options& options) override
+        {
+            FilterSink::activateOptions(options);
+
+            Limit limit;
+
+            auto rateOption = options.tryGet("rate");
+            if (!rateOption)
+                raiseConfigurationError("expected `rate` parameter");
+
+            auto rateStr = rateOption->asString();
+            auto rate    = rateStr ? string_utils::parseSize(*rateStr) : std::nullopt;
+            if (!rate || *rate == 0)
+                raiseConfigurationError("rate: expected positive integer");
+
+            limit.rate = *rate;
+
+            if (auto periodOption = options.tryGet("period"))
+            {
+                auto periodStr = periodOption->asString();
+                auto ok        = periodStr && string_utils::parseDuration(*periodStr, [&](auto duration) {
+                    limit.period = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+                });
+
+                if (!ok || limit.period.count() <= 0)
+                    raiseConfigurationError("period: invalid duration");
+            }
+
+            if (auto burstOption = options.tryGet("burst"))
+            {
+                auto burstStr = burstOption->asString();
+                auto burst    = burstStr ? string_utils::parseSize(*burstStr) : std::nullopt;
+                if (!burst || *burst == 0)
+                    raiseConfigurationError("burst: expected positive integer");
+
+                limit.burst = *burst;
+            }
+
+            auto key = Key::Logger;
+            if (auto keyOption = options.tryGet("key"))
+            {
+                auto keyStr = keyOption->asString();
+                if (!keyStr)
+                    raiseConfigurationError("key: expected string");
+
+                if (string_utils::iequals(*keyStr, "global"))
+                    key = Key::Global;
+                else if (string_utils::iequals(*keyStr, "logger"))
+                    key = Key::Logger;
+                else if (string_utils::iequals(*keyStr, "level"))
+                    key = Key::Level;
+                else if (string_utils::iequals(*keyStr, "call_site"))
+                    key = Key::CallSite;
+                else
+                    raiseConfigurationError("key: unknown key `{}`", *keyStr);
+            }
+
+            setLimit(limit, key);
+        }
+
+        // Number of events dropped so far
+        uint64_t droppedCount() const
+        {
+            uint64_t dropped = 0;
+            for (const auto& bucket : m_buckets)
+                dropped += bucket.dropped.load(std::memory_order_relaxed);
+
+            return dropped;
+        }
+
+    protected:
+        bool accept(const EventRecord& record, Reporter& reporter) override
+        {
+            auto& bucket = m_buckets[bucketIndex(record)];
+            auto now     = std::chrono::duration_cast<std::chrono::nanoseconds>(record.buffer->time().time_since_epoch()).count();
+
+            // Theoretical arrival time: when the bucket would be full again
+            auto tat = bucket.tat.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto next = std::max(tat, now);
+                if (next - now > m_tolerance)
+                {
+                    bucket.suppressed.fetch_add(1, std::memory_order_relaxed);
+                    bucket.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                if (bucket.tat.compare_exchange_weak(tat, next + m_interval, std::memory_order_relaxed))
+                    break;
+            }
+
+            if (bucket.suppressed.load(std::memory_order_relaxed) != 0)
+            {
+                if (auto suppressed = bucket.suppressed.exchange(0, std::memory_order_relaxed))
+                    reportSuppressed(record, suppressed, reporter);
+            }
+
+            return true;
+        }
+
+    private:
+        struct alignas(64) Bucket
+        {
+            std::atomic<int64_t> tat { 0 };
+
+            // Dropped since the last report
+            std::atomic<uint64_t> suppressed { 0 };
+
+            std::atomic<uint64_t> dropped { 0 };
+        };
+
+        std::array<Bucket, BucketCount> m_buckets;
+
+        Key m_key { Key::Logger };
+
+        // Nanoseconds between two events at the sustained rate
+        int64_t m_interval { 0 };
+
+        // How far ahead of time events can be let through, allowing bursts
+        int64_t m_tolerance { 0 };
+
+        void setLimit(const Limit& limit, Key key)
+        {
+            auto rate  = std::max<size_t>(limit.rate, 1);
+            auto burst = limit.burst == 0 ? rate : limit.burst;
+
+            m_key       = key;
+            m_interval  = std::max<int64_t>(limit.period.count() / static_cast<int64_t>(rate), 1);
+            m_tolerance = m_interval * static_cast<int64_t>(burst - 1);
+        }
+
+        size_t bucketIndex(const EventRecord& record) const
+        {
+            switch (m_key)
+            {
+            case Key::Global:
+                return 0;
+            case Key::Level:
+                return static_cast<size_t>(record.level);
+            case Key::CallSite:
+                if (auto location = record.buffer->location())
+                {
+                    // Files are string literals, their address identifies them
+                    auto hash = hash_utils::fnv1a(reinterpret_cast<uintptr_t>(location->file.data()));
+                    return hash_utils::fnv1a(location->line, hash) % BucketCount;
+                }
+                [[fallthrough]];
+            case Key::Logger:
+                break;
+            }
+
+            return hash_utils::fnv1a(record.name) % BucketCount;
+        }
+
+        static void reportSuppressed(const EventRecord& record, uint64_t suppressed, Reporter& reporter)
+        {
+            EventLogBuffer buffer;
+            buffer.writeTime(record.buffer->time());
+            buffer.writeThreadId(thread_utils::getCurrentId());
+            buffer.writeText(logpp::format("{} events suppressed by rate limit", suppressed));
+            buffer.writeFields(logpp::field("suppressed", suppressed));
+
+            reporter.report(record.name, LogLevel::Warning, buffer);
+        }
+    };
+}
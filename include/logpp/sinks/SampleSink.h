@@ -0,0 +1,160 @@
+#pragma once
+
+#include "logpp/sinks/FilterSink.h"
+
+#include "logpp/utils/string.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+namespace logpp::sink
+{
+    // Let through one event out of `every`
+    struct SampleEvery
+    {
+        size_t every;
+    };
+
+    // Let through every event with the given probability, between 0 and 1
+    struct SampleProbability
+    {
+        double probability;
+    };
+
+    // Lets through a sample of the events: one event out of `every`, or every event with
+    // a given probability.
+    //
+    // Counting is spread over a few counters picked by thread to keep the logging threads
+    // from contending on a single cache line. Each counter lets through one event out of
+    // `every`, the overall rate is thus the same while the events of a thread are evenly
+    // sampled. Probabilistic sampling draws from a per-thread generator and shares no state
+    class SampleSink : public FilterSink
+    {
+    public:
+        static constexpr std::string_view Name = "Sample";
+
+        static constexpr size_t CounterCount = 16;
+
+        SampleSink() = default;
+
+        SampleSink(std::shared_ptr<Sink> inner, SampleEvery every)
+            : FilterSink(std::move(inner))
+        {
+            setEvery(every.every);
+        }
+
+        SampleSink(std::shared_ptr<Sink> inner, SampleProbability probability)
+            : FilterSink(std::move(inner))
+        {
+            setProbability(probability.probability);
+        }
+
+        void activateOptions(const Options& options) override
+        {
+            FilterSink::activateOptions(options);
+
+            auto everyOption       = options.tryGet("every");
+            auto probabilityOption = options.tryGet("probability");
+            if (everyOption && probabilityOption)
+                raiseConfigurationError("expected either `every` or `probability` parameter, not both");
+
+            if (everyOption)
+            {
+                auto everyStr = everyOption->asString();
+                auto every    = everyStr ? string_utils::parseSize(*everyStr) : std::nullopt;
+                if (!every || *every == 0)
+                    raiseConfigurationError("every: expected positive integer");
+
+                setEvery(*every);
+            }
+            else if (probabilityOption)
+            {
+                auto probabilityStr = probabilityOption->asString();
+                if (!probabilityStr)
+                    raiseConfigurationError("probability: expected number");
+
+                char* endptr     = nullptr;
+                auto probability = std::strtod(probabilityStr->c_str(), &endptr);
+                if (endptr == probabilityStr->c_str() || *endptr != '\0' || probability < 0.0 || probability > 1.0)
+                    raiseConfigurationError("probability: expected number between 0 and 1, got `{}`", *probabilityStr);
+
+                setProbability(probability);
+            }
+            else
+            {
+                raiseConfigurationError("expected `every` or `probability` parameter");
+            }
+        }
+
+    protected:
+        bool accept(const EventRecord&, Reporter&) override
+        {
+            if (m_every != 0)
+            {
+                auto& counter = m_counters[counterIndex()].value;
+                return counter.fetch_add(1, std::memory_order_relaxed) % m_every == 0;
+            }
+
+            return m_threshold == Always || nextRandom() < m_threshold;
+        }
+
+    private:
+        struct alignas(64) Counter
+        {
+            std::atomic<uint64_t> value { 0 };
+        };
+
+        static constexpr uint64_t Always = ~uint64_t { 0 };
+
+        std::array<Counter, CounterCount> m_counters;
+
+        // One event out of `m_every`, probabilistic sampling if 0
+        size_t m_every { 1 };
+
+        // Events are let through when a random number is below the threshold
+        uint64_t m_threshold { Always };
+
+        void setEvery(size_t every)
+        {
+            m_every = std::max<size_t>(every, 1);
+        }
+
+        void setProbability(double probability)
+        {
+            m_every = 0;
+            if (probability >= 1.0)
+                m_threshold = Always;
+            else if (probability <= 0.0)
+                m_threshold = 0;
+            else
+            {
+                // Probabilities just below 1 round up to 2^64, which does not fit in the threshold
+                static constexpr double Range = 18446744073709551616.0;
+
+                auto threshold = probability * Range;
+                m_threshold    = threshold >= Range ? Always : static_cast<uint64_t>(threshold);
+            }
+        }
+
+        static size_t counterIndex()
+        {
+            static thread_local const size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % CounterCount;
+            return index;
+        }
+
+        // xorshift64*
+        static uint64_t nextRandom()
+        {
+            static thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+    };
+}
@@ -5,6 +5,7 @@
 #include "logpp/core/Offset.h"
 
 #include "logpp/utils/detect.h"
+#include "logpp/utils/span.h"
 
 #include <fmt/format.h>
 
@@ -117,6 +118,14 @@ namespace logpp::sink
         { }
     };
 
+    // An event handed to a sink as part of a batch
+    struct EventRecord
+    {
+        std::string_view name;
+        LogLevel level;
+        const EventLogBuffer* buffer;
+    };
+
     class Sink
     {
     public:
@@ -124,6 +133,40 @@ namespace logpp::sink
 
         virtual void activateOptions(const Options& options)                                   = 0;
         virtual void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) = 0;
+
+        // Sink a batch of events. Sinks that can amortize work over several events,
+        // like writing to a file, should override it
+        virtual void sinkBatch(Span<const EventRecord> records)
+        {
+            for (const auto& record : records)
+                sink(record.name, record.level, *record.buffer);
+        }
+
+        // Called by the thread sinking the events of an AsyncSink when there is no event to
+        // sink, at least every AsyncQueuePoller::Options::maxParkDuration. Lets sinks do
+        // time-driven work, like flushing buffered content
+        virtual void onIdle()
+        { }
+    };
+
+    // A sink whose formatting can be split from its output. Batches of events can then be
+    // formatted by multiple threads, and written by a single one in order
+    class FormattedSink
+    {
+    public:
+        virtual ~FormattedSink() = default;
+
+        // Whether `formatBatch` can be called by multiple threads at once
+        virtual bool canFormatConcurrently() const
+        {
+            return true;
+        }
+
+        // Format a batch of events into `out`, the way `sinkBatch` would write them
+        virtual void formatBatch(Span<const EventRecord> records, fmt::memory_buffer& out) = 0;
+
+        // Write a batch formatted by `formatBatch`. `maxLevel` is the highest level of its events
+        virtual void writeFormatted(std::string_view data, LogLevel maxLevel) = 0;
     };
 
     class SinkBase : public Sink
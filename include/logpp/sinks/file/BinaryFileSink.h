@@ -0,0 +1,35 @@
+#pragma once
+
+#include "logpp/format/BinaryFormatter.h"
+#include "logpp/sinks/file/FileSink.h"
+
+namespace logpp::sink
+{
+    // A FileSink writing events in the binary format of BinaryFormatter instead of text.
+    // Binary logs are rendered offline with the `logpp-decode` tool.
+    //
+    // Every time the file is opened, a new session starts so that the file can be decoded
+    // even when appended to by multiple runs
+    class BinaryFileSink : public FileSink
+    {
+    public:
+        static constexpr std::string_view Name = "BinaryFile";
+
+        BinaryFileSink();
+        BinaryFileSink(std::string_view filePath);
+
+        void activateOptions(const Options& options) override;
+
+        // Strings are only written the first time they are seen, events must thus be
+        // formatted in the order they are written
+        bool canFormatConcurrently() const override
+        {
+            return false;
+        }
+
+    protected:
+        void formatEvent(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out) override;
+
+        void onAfterOpened(const std::unique_ptr<File>& file) override;
+    };
+}
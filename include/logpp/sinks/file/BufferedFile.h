@@ -0,0 +1,64 @@
+#pragma once
+
+#include "logpp/sinks/file/File.h"
+
+#include <memory>
+
+namespace logpp::sink
+{
+    // A File writing directly to a file descriptor through a user-space buffer.
+    //
+    // Writes are accumulated in the buffer and only handed to the system when
+    // the buffer is full or when the file is flushed, coalescing many small writes
+    // in a single system call
+    class BufferedFile : public File
+    {
+    public:
+        static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+        explicit BufferedFile(size_t bufferSize = DefaultBufferSize);
+        BufferedFile(std::string_view filePath, size_t bufferSize = DefaultBufferSize);
+
+        ~BufferedFile();
+
+        BufferedFile(const BufferedFile&) = delete;
+        BufferedFile& operator=(const BufferedFile&) = delete;
+
+        // Open the file in append mode, creating it along with its directories if needed
+        bool open(std::string_view filePath);
+
+        bool isOpen() const override;
+        bool close() override;
+
+        size_t write(const char* data, size_t size) override;
+        size_t write(const char c) override;
+
+        // Write the content of the buffer to the file
+        void flush() override;
+
+        size_t size() const override;
+
+        size_t bufferSize() const
+        {
+            return m_capacity;
+        }
+
+        // Number of bytes that have been written but not flushed yet
+        size_t buffered() const
+        {
+            return m_size;
+        }
+
+    private:
+        int m_fd { -1 };
+
+        std::unique_ptr<char[]> m_buffer;
+        size_t m_capacity;
+        size_t m_size { 0 };
+
+        // Number of bytes already written to the file
+        size_t m_written { 0 };
+
+        void writeFully(const char* data, size_t size);
+    };
+}
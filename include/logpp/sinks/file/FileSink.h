@@ -1,14 +1,19 @@
 #pragma once
 
+#include "logpp/format/FormatContext.h"
 #include "logpp/sinks/FormatSink.h"
+#include "logpp/sinks/file/BufferedFile.h"
 #include "logpp/sinks/file/File.h"
+#include "logpp/sinks/file/FlushPolicy.h"
 
+#include <chrono>
 #include <memory>
 #include <string_view>
 
 namespace logpp::sink
 {
-    class FileSink : public FormatSink
+    class FileSink : public FormatSink,
+                     public FormattedSink
     {
     public:
         static constexpr std::string_view Name = "File";
@@ -24,12 +29,52 @@ namespace logpp::sink
 
         bool close();
 
+        void flush();
+
+        void setFlushPolicy(FlushPolicy policy);
+        const FlushPolicy& flushPolicy() const;
+
+        // Size of the buffer of files opened afterwards
+        void setBufferSize(size_t bufferSize);
+        size_t bufferSize() const;
+
         void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override;
 
+        // Formats the whole batch in a single buffer to write it at once
+        void sinkBatch(Span<const EventRecord> records) override;
+
+        void formatBatch(Span<const EventRecord> records, fmt::memory_buffer& out) override;
+        void writeFormatted(std::string_view data, LogLevel maxLevel) override;
+
+        // Flush the file if the interval of the flush policy elapsed
+        void onIdle() override;
+
     protected:
         std::unique_ptr<File> m_file;
 
+        // Buffers events are formatted into, reused across events
+        FormatContext m_formatContext;
+
+        void activateFlushOptions(const Options& options);
+
+        // Create the file written by the sink. Not called for files opened by the
+        // constructors of this class
+        virtual std::unique_ptr<File> createFile(std::string_view filePath);
+
+        // Format an event followed by a line break
+        virtual void formatEvent(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out);
+
+        // Flush the file if required by the flush policy after writing `size` bytes
+        void onWritten(LogLevel level, size_t size);
+
         virtual void onAfterOpened(const std::unique_ptr<File>&) { }
         virtual void onBeforeClosing(const std::unique_ptr<File>&) { }
+
+    private:
+        size_t m_bufferSize { BufferedFile::DefaultBufferSize };
+
+        FlushPolicy m_flushPolicy;
+        size_t m_unflushedBytes { 0 };
+        std::chrono::steady_clock::time_point m_lastFlush;
     };
 }
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "logpp/core/LogLevel.h"
+
+#include <chrono>
+
+namespace logpp::sink
+{
+    // Determines when a file sink flushes the content written to its file.
+    // A file is always flushed when closed or on an explicit call to `flush`.
+    //
+    // By default, content is not flushed after every event. A sink used synchronously with
+    // a low rate of events should rather flush `always`, see `interval`
+    struct FlushPolicy
+    {
+        static constexpr std::chrono::milliseconds DefaultInterval { 1000 };
+
+        // Flush once that many bytes have been written since the last flush.
+        // When 0, the content is only written when the buffer of the file is full
+        size_t bytes = 0;
+
+        // Flush when that much time elapsed since the last flush, 0 to disable.
+        // Checked when writing and, behind an AsyncSink, periodically while no event is
+        // logged. Content written synchronously to an idle file stays buffered until the
+        // next event
+        std::chrono::milliseconds interval = DefaultInterval;
+
+        // Flush after every event of at least this level
+        LogLevel level = LogLevel::Error;
+
+        // Flush after every event
+        static FlushPolicy always()
+        {
+            FlushPolicy policy;
+            policy.level = LogLevel::Trace;
+            return policy;
+        }
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "logpp/sinks/file/File.h"
+
+#include <memory>
+#include <vector>
+
+namespace logpp::sink
+{
+    // A File whose writes are submitted asynchronously and complete in the background.
+    //
+    // Content is accumulated in one of a fixed set of buffers. A buffer is submitted
+    // when it is full or when the file is flushed, and the next free buffer is used
+    // in the meantime. Writing only blocks when all the buffers are in flight.
+    //
+    // On Linux, writes are submitted to an io_uring with the buffers registered to
+    // the kernel. When io_uring is not available, buffers are written from a dedicated
+    // thread instead. Either way, the file is opened in append mode and buffers are
+    // written one after the other, in order
+    class IoUringFile : public File
+    {
+    public:
+        static constexpr size_t DefaultBufferSize  = 256 * 1024;
+        static constexpr size_t DefaultBufferCount = 4;
+
+        explicit IoUringFile(size_t bufferSize = DefaultBufferSize, size_t bufferCount = DefaultBufferCount);
+        IoUringFile(std::string_view filePath, size_t bufferSize = DefaultBufferSize, size_t bufferCount = DefaultBufferCount);
+
+        ~IoUringFile();
+
+        IoUringFile(const IoUringFile&) = delete;
+        IoUringFile& operator=(const IoUringFile&) = delete;
+
+        // Open the file in append mode, creating it along with its directories if needed
+        bool open(std::string_view filePath);
+
+        bool isOpen() const override;
+
+        // Wait for all the writes in flight to complete and close the file
+        bool close() override;
+
+        size_t write(const char* data, size_t size) override;
+        size_t write(const char c) override;
+
+        // Submit the current buffer without waiting for the write to complete
+        void flush() override;
+
+        size_t size() const override;
+
+        // Whether writes are submitted to an io_uring
+        bool usesIoUring() const;
+
+        // Wait for all the writes in flight to complete
+        void wait();
+
+    private:
+        struct Buffer
+        {
+            char* data;
+            size_t size;
+            bool inFlight;
+        };
+
+        class Backend;
+        class IoUringBackend;
+        class ThreadBackend;
+
+        int m_fd { -1 };
+
+        size_t m_bufferSize;
+        std::unique_ptr<char[]> m_storage;
+        std::vector<Buffer> m_buffers;
+        size_t m_current { 0 };
+
+        // Size of the file once the writes submitted so far complete
+        uint64_t m_size { 0 };
+
+        std::unique_ptr<Backend> m_backend;
+        std::vector<size_t> m_completed;
+
+        void submitCurrent();
+        void nextBuffer();
+        void reap(bool wait);
+    };
+}
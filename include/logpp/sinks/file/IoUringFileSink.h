@@ -0,0 +1,30 @@
+#pragma once
+
+#include "logpp/sinks/file/FileSink.h"
+#include "logpp/sinks/file/IoUringFile.h"
+
+namespace logpp::sink
+{
+    // A FileSink whose writes complete asynchronously, see IoUringFile.
+    // The sinking thread only blocks when all the buffers of the file are in flight
+    class IoUringFileSink : public FileSink
+    {
+    public:
+        static constexpr std::string_view Name = "IoUringFile";
+
+        IoUringFileSink();
+        IoUringFileSink(std::string_view filePath);
+        IoUringFileSink(std::string_view filePath, std::shared_ptr<Formatter> formatter);
+
+        void activateOptions(const Options& options) override;
+
+        // Number of buffers of files opened afterwards
+        void setBufferCount(size_t bufferCount);
+
+    protected:
+        std::unique_ptr<File> createFile(std::string_view filePath) override;
+
+    private:
+        size_t m_bufferCount { IoUringFile::DefaultBufferCount };
+    };
+}
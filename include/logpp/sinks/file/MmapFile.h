@@ -0,0 +1,79 @@
+#pragma once
+
+#include "logpp/core/config.h"
+#include "logpp/sinks/file/File.h"
+
+#if !defined(LOGPP_PLATFORM_WINDOWS)
+#define LOGPP_HAS_MMAP_FILE
+#endif
+
+#if defined(LOGPP_HAS_MMAP_FILE)
+
+#include <cstdint>
+
+namespace logpp::sink
+{
+    // A File written through a shared memory mapping.
+    //
+    // The file is preallocated in chunks of `chunkSize` bytes and one chunk is mapped
+    // at a time, writing only costs a copy to the mapped memory. The file is truncated
+    // to the size of its content when closed.
+    //
+    // Note that the preallocated, zero-filled, tail of the file is left as is when the
+    // process does not close the file, e.g when crashing
+    class MmapFile : public File
+    {
+    public:
+        static constexpr size_t DefaultChunkSize = 16 * 1024 * 1024;
+
+        explicit MmapFile(size_t chunkSize = DefaultChunkSize);
+        MmapFile(std::string_view filePath, size_t chunkSize = DefaultChunkSize);
+
+        ~MmapFile();
+
+        MmapFile(const MmapFile&) = delete;
+        MmapFile& operator=(const MmapFile&) = delete;
+
+        // Open the file in append mode, creating it along with its directories if needed
+        bool open(std::string_view filePath);
+
+        bool isOpen() const override;
+
+        // Unmap the file and truncate it to the size of its content
+        bool close() override;
+
+        size_t write(const char* data, size_t size) override;
+        size_t write(const char c) override;
+
+        // Schedule the write-back of the content written since the last flush
+        void flush() override;
+
+        size_t size() const override;
+
+        // Chunk size rounded up to a multiple of the page size
+        size_t chunkSize() const
+        {
+            return m_chunkSize;
+        }
+
+    private:
+        int m_fd { -1 };
+        size_t m_chunkSize;
+
+        char* m_map { nullptr };
+
+        // Offset in the file of the mapped chunk
+        uint64_t m_mapOffset { 0 };
+
+        // Size of the content of the file
+        uint64_t m_size { 0 };
+
+        // Size of the content of the file when last flushed
+        uint64_t m_flushed { 0 };
+
+        bool mapChunk(uint64_t offset);
+        void unmap();
+    };
+}
+
+#endif
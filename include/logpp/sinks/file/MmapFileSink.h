@@ -0,0 +1,68 @@
+#pragma once
+
+#include "logpp/sinks/file/FileSink.h"
+#include "logpp/sinks/file/MmapFile.h"
+#include "logpp/sinks/file/RollingOfstream.h"
+
+#if defined(LOGPP_HAS_MMAP_FILE)
+
+#include <functional>
+#include <optional>
+
+namespace logpp::sink
+{
+    // A FileSink writing to a memory-mapped file, see MmapFile.
+    //
+    // The file can roll by size. The rolling threshold is rounded up to a multiple of
+    // the chunk size and an event is never split between two files, a file thus
+    // never grows past the chunks it has been preallocated with
+    class MmapFileSink : public FileSink
+    {
+    public:
+        static constexpr std::string_view Name = "MmapFile";
+
+        // Archive the closed file at the given path
+        using Archive = std::function<void(std::string_view)>;
+
+        MmapFileSink();
+        MmapFileSink(std::string_view filePath);
+        MmapFileSink(std::string_view filePath, std::shared_ptr<Formatter> formatter);
+
+        void activateOptions(const Options& options) override;
+
+        // Size of the chunks of files opened afterwards
+        void setChunkSize(size_t chunkSize);
+
+        // Roll the file once it reaches `rollSize` bytes, rounded up to a multiple of
+        // the chunk size
+        template <typename ArchivePolicy>
+        void setRolling(RollBySize rollBySize, ArchivePolicy archivePolicy)
+        {
+            m_rollSize = rollBySize.bytesThreshold;
+            m_archive  = [archivePolicy](std::string_view path) {
+                archivePolicy.archive(path);
+            };
+        }
+
+        void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override;
+        void sinkBatch(Span<const EventRecord> records) override;
+
+        // A formatted batch is never split between two files
+        void writeFormatted(std::string_view data, LogLevel maxLevel) override;
+
+    protected:
+        std::unique_ptr<File> createFile(std::string_view filePath) override;
+
+    private:
+        size_t m_chunkSize { MmapFile::DefaultChunkSize };
+
+        std::optional<size_t> m_rollSize;
+        Archive m_archive;
+
+        // Format and write an event, returning the number of bytes written
+        size_t write(std::string_view name, LogLevel level, const EventLogBuffer& buffer);
+        void rollIfNeeded(size_t size);
+    };
+}
+
+#endif
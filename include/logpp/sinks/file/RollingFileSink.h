@@ -21,6 +21,9 @@ namespace logpp::sink
         void activateOptions(const Options& options) override;
 
         void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override;
+        void sinkBatch(Span<const EventRecord> records) override;
+
+        void writeFormatted(std::string_view data, LogLevel maxLevel) override;
 
     private:
         std::string m_baseFilePath;
@@ -598,10 +598,19 @@ namespace logpp
             auto basePath = buf->path();
             auto mode     = buf->mode();
 
-            static constexpr size_t MAX_BUF = 255;
-
             buf->close();
 
+            if (!archive(basePath))
+                return false;
+
+            return buf->open(basePath.data(), mode);
+        }
+
+        // Rename the closed file at `basePath` with a time suffix
+        bool archive(std::string_view basePath) const
+        {
+            static constexpr size_t MAX_BUF = 255;
+
             auto now  = offset.apply(Clock::now());
             auto time = Clock::to_time_t(now);
 
@@ -617,10 +626,7 @@ namespace logpp
             if (std::filesystem::exists(newPath))
                 ArchiveIncremental::archive(newPath);
 
-            if (!file_utils::rename(basePath, newPath))
-                return false;
-
-            return buf->open(basePath.data(), mode);
+            return file_utils::rename(basePath, newPath);
         }
     };
 
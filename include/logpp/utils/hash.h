@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace logpp::hash_utils
+{
+    static constexpr uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+    static constexpr uint64_t FnvPrime       = 1099511628211ULL;
+
+    // 64-bit FNV-1a, `seed` chains the hash of several values
+    inline uint64_t fnv1a(std::string_view str, uint64_t seed = FnvOffsetBasis)
+    {
+        auto hash = seed;
+        for (auto c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= FnvPrime;
+        }
+
+        return hash;
+    }
+
+    inline uint64_t fnv1a(uint64_t value, uint64_t seed = FnvOffsetBasis)
+    {
+        auto hash = seed;
+        for (int i = 0; i < 8; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= FnvPrime;
+        }
+
+        return hash;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace logpp
+{
+    // A non-owning view over a contiguous sequence of objects, until std::span is available
+    template <typename T>
+    class Span
+    {
+    public:
+        using value_type     = std::remove_cv_t<T>;
+        using pointer        = T*;
+        using reference      = T&;
+        using iterator       = T*;
+        using const_iterator = const T*;
+
+        constexpr Span() = default;
+
+        constexpr Span(T* data, size_t size)
+            : m_data(data)
+            , m_size(size)
+        { }
+
+        template <typename Container,
+                  typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+        constexpr Span(Container& container)
+            : m_data(container.data())
+            , m_size(container.size())
+        { }
+
+        constexpr T* data() const
+        {
+            return m_data;
+        }
+
+        constexpr size_t size() const
+        {
+            return m_size;
+        }
+
+        constexpr bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        constexpr T& operator[](size_t index) const
+        {
+            return m_data[index];
+        }
+
+        constexpr T* begin() const
+        {
+            return m_data;
+        }
+
+        constexpr T* end() const
+        {
+            return m_data + m_size;
+        }
+
+        constexpr Span subspan(size_t offset, size_t count) const
+        {
+            return Span(m_data + offset, count);
+        }
+
+    private:
+        T* m_data { nullptr };
+        size_t m_size { 0 };
+    };
+}
@@ -10,6 +10,7 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 
 namespace logpp
 {
@@ -50,6 +51,16 @@ namespace logpp
             return std::nullopt;
         }
 
+        inline std::optional<bool> parseBool(std::string_view str)
+        {
+            if (iequals(str, "true"))
+                return true;
+            else if (iequals(str, "false"))
+                return false;
+
+            return std::nullopt;
+        }
+
         template <typename OnParsed>
         bool parseDuration(std::string_view str, OnParsed&& onParsed)
         {
@@ -64,6 +75,18 @@ namespace logpp
             while (std::isspace(*endptr))
                 ++endptr;
 
+            // Sub-second units, must be checked before minutes and seconds
+            if (std::strncmp(endptr, "ms", 2) == 0)
+            {
+                onParsed(std::chrono::milliseconds(value));
+                return true;
+            }
+            else if (std::strncmp(endptr, "us", 2) == 0)
+            {
+                onParsed(std::chrono::microseconds(value));
+                return true;
+            }
+
             switch (*endptr)
             {
             case 's':
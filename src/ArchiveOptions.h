@@ -0,0 +1,80 @@
+#pragma once
+
+#include "logpp/sinks/Sink.h"
+#include "logpp/sinks/file/RollingOfstream.h"
+
+#include "logpp/utils/string.h"
+
+// Parsing of the `archive` option shared by the rolling file sinks
+namespace logpp::sink::details
+{
+    template <typename Time, typename Func>
+    void parseArchiveTimestampOffset(const Options::Dict& options, std::string pattern, Func&& onParsed)
+    {
+        auto offsetIt = options.find("offset");
+        if (offsetIt == std::end(options))
+        {
+            onParsed(ArchiveTimestamp<Time> { std::move(pattern) });
+            return;
+        }
+
+        auto ok = string_utils::parseDuration(offsetIt->second, [&](auto duration) {
+            onParsed(ArchiveTimestamp<Time, offset::Fixed<decltype(duration)>> { std::move(pattern), duration });
+        });
+
+        if (!ok)
+            SinkBase::raiseConfigurationError("archive: invalid `offset` {}", offsetIt->second);
+    }
+
+    template <typename Func>
+    void parseArchive(const Options::Value& options, Func&& onParsed)
+    {
+        if (auto opts = options.asString())
+        {
+            if (string_utils::iequals(*opts, "incremental"))
+                onParsed(ArchiveIncremental {});
+            else if (string_utils::iequals(*opts, "timestamp"))
+                onParsed(ArchiveTimestamp<UTCTime> {});
+            else
+                SinkBase::raiseConfigurationError("archive: invalid type {}", *opts);
+        }
+        else if (auto opts = options.asDict())
+        {
+            auto typeIt = opts->find("type");
+            if (typeIt == std::end(*opts))
+                SinkBase::raiseConfigurationError("archive: missing `type`");
+
+            auto type = typeIt->second;
+            if (string_utils::iequals(type, "incremental"))
+            {
+                onParsed(ArchiveIncremental {});
+            }
+            else if (string_utils::iequals(type, "timestamp"))
+            {
+                static constexpr auto DefaultPattern = std::string_view("%Y%m%d");
+
+                auto patternIt = opts->find("pattern");
+                auto pattern   = patternIt == std::end(*opts) ? std::string(DefaultPattern) : patternIt->second;
+
+                auto tzIt = opts->find("tz");
+                if (tzIt == std::end(*opts))
+                {
+                    parseArchiveTimestampOffset<UTCTime>(*opts, std::move(pattern), std::forward<Func>(onParsed));
+                    return;
+                }
+
+                auto tz = tzIt->second;
+                if (string_utils::iequals(tz, "utc"))
+                    parseArchiveTimestampOffset<UTCTime>(*opts, std::move(pattern), std::forward<Func>(onParsed));
+                else if (string_utils::iequals(tz, "local"))
+                    parseArchiveTimestampOffset<LocalTime>(*opts, std::move(pattern), std::forward<Func>(onParsed));
+                else
+                    SinkBase::raiseConfigurationError("archive: invalid `tz` {}", tz);
+            }
+        }
+        else
+        {
+            SinkBase::raiseConfigurationError("archive: invalid archive options");
+        }
+    }
+}
@@ -53,12 +53,14 @@ namespace logpp
             return;
 
         m_internalQueue->push(StopEntry {});
+        notify();
     }
 
     void AsyncQueuePoller::addQueue(std::shared_ptr<IAsyncQueue> queue)
     {
         QueueEntry entry { std::move(queue), ControlAction::Add, nullptr };
         m_internalQueue->push(std::move(entry));
+        notify();
     }
 
     std::future<size_t> AsyncQueuePoller::removeQueue(std::shared_ptr<IAsyncQueue> queue)
@@ -75,11 +77,32 @@ namespace logpp
         {
             QueueEntry entry { std::move(queue), ControlAction::Remove, std::move(handlePromise) };
             m_internalQueue->push(std::move(entry));
+            notify();
         }
 
         return future;
     }
 
+    void AsyncQueuePoller::notify()
+    {
+        if (m_options.waitStrategy == WaitStrategy::BusySpin)
+            return;
+
+        // Pairs with the fence in park(): either the poller sees the entry that has just
+        // been pushed when polling one last time before parking, or we see it sleeping.
+        // This is a full fence on every event (an mfence or locked instruction on x86),
+        // only BusySpin avoids it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!m_sleeping.load(std::memory_order_relaxed))
+            return;
+
+        {
+            std::lock_guard guard(m_parkMutex);
+            m_notified = true;
+        }
+        m_parkCv.notify_one();
+    }
+
     void AsyncQueuePoller::handleEntry(StopEntry)
     {
         m_stopSignal.store(true, std::memory_order_relaxed);
@@ -126,19 +149,77 @@ namespace logpp
 
         for (;;)
         {
-            size_t totalCount = 0;
-            totalCount += m_internalQueue->poll();
+            auto totalCount = pollAll();
 
-            for (auto& queue : m_queues)
+            if (m_stopSignal.load(std::memory_order_relaxed))
+                break;
+
+            if (totalCount > 0)
             {
-                totalCount += queue->poll();
+                spinWait.reset();
+                continue;
             }
 
-            if (totalCount == 0)
-                spinWait.spinOnce();
+            // Once after every burst of events and every time the poller wakes up from parking
+            if (spinWait.count() == 0)
+                idleAll();
 
-            if (m_stopSignal.load(std::memory_order_relaxed))
+            switch (options.waitStrategy)
+            {
+            case WaitStrategy::BusySpin:
                 break;
+            case WaitStrategy::Hybrid:
+                if (spinWait.count() < options.hybridSpinCount)
+                {
+                    spinWait.spinOnce();
+                    break;
+                }
+
+                park(options);
+                spinWait.reset();
+                break;
+            case WaitStrategy::Blocking:
+                park(options);
+                break;
+            }
+        }
+    }
+
+    size_t AsyncQueuePoller::pollAll()
+    {
+        size_t totalCount = 0;
+        totalCount += m_internalQueue->poll();
+
+        for (auto& queue : m_queues)
+        {
+            totalCount += queue->poll();
+        }
+
+        return totalCount;
+    }
+
+    void AsyncQueuePoller::idleAll()
+    {
+        for (auto& queue : m_queues)
+        {
+            queue->onIdle();
         }
     }
+
+    void AsyncQueuePoller::park(const Options& options)
+    {
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // An entry might have been pushed before the producer could see us sleeping,
+        // poll one last time before actually parking
+        if (pollAll() == 0 && !m_stopSignal.load(std::memory_order_relaxed))
+        {
+            std::unique_lock lock(m_parkMutex);
+            m_parkCv.wait_for(lock, options.maxParkDuration, [&] { return m_notified; });
+            m_notified = false;
+        }
+
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
 }
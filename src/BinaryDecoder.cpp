@@ -0,0 +1,305 @@
+#include "logpp/format/BinaryDecoder.h"
+
+#include <fmt/args.h>
+
+namespace logpp
+{
+    namespace
+    {
+        // Reads a payload, raising an error when reading past its end
+        class Reader
+        {
+        public:
+            Reader(const char* data, size_t size)
+                : m_data(data)
+                , m_size(size)
+            { }
+
+            template <typename T>
+            T read()
+            {
+                return binary::decodeLE<T>(advance(sizeof(T)));
+            }
+
+            std::string_view readBytes()
+            {
+                auto size = read<uint32_t>();
+                return std::string_view(advance(size), size);
+            }
+
+            std::string_view remaining()
+            {
+                auto size = m_size - m_pos;
+                return std::string_view(advance(size), size);
+            }
+
+        private:
+            const char* m_data;
+            size_t m_size;
+            size_t m_pos { 0 };
+
+            const char* advance(size_t size)
+            {
+                if (m_size - m_pos < size)
+                    throw BinaryFormatError("truncated record");
+
+                const auto* data = m_data + m_pos;
+                m_pos += size;
+                return data;
+            }
+        };
+
+        template <typename Value>
+        Value readValue(Reader& reader)
+        {
+            Value value;
+            value.type = static_cast<binary::ValueType>(reader.read<uint8_t>());
+
+            switch (value.type)
+            {
+            case binary::ValueType::String:
+                value.str = reader.readBytes();
+                break;
+            case binary::ValueType::Char:
+                value.c = reader.read<char>();
+                break;
+            case binary::ValueType::UInt8:
+                value.u = reader.read<uint8_t>();
+                break;
+            case binary::ValueType::UInt16:
+                value.u = reader.read<uint16_t>();
+                break;
+            case binary::ValueType::UInt32:
+                value.u = reader.read<uint32_t>();
+                break;
+            case binary::ValueType::UInt64:
+                value.u = reader.read<uint64_t>();
+                break;
+            case binary::ValueType::Int8:
+                value.i = reader.read<int8_t>();
+                break;
+            case binary::ValueType::Int16:
+                value.i = reader.read<int16_t>();
+                break;
+            case binary::ValueType::Int32:
+                value.i = reader.read<int32_t>();
+                break;
+            case binary::ValueType::Int64:
+                value.i = reader.read<int64_t>();
+                break;
+            case binary::ValueType::Bool:
+                value.b = reader.read<uint8_t>() != 0;
+                break;
+            case binary::ValueType::Float: {
+                auto bits = reader.read<uint32_t>();
+                std::memcpy(&value.f, &bits, sizeof(bits));
+                break;
+            }
+            case binary::ValueType::Double: {
+                auto bits = reader.read<uint64_t>();
+                std::memcpy(&value.d, &bits, sizeof(bits));
+                break;
+            }
+            default:
+                throw BinaryFormatError(fmt::format("unknown value type {}", static_cast<int>(value.type)));
+            }
+
+            return value;
+        }
+
+        // Calls `func` with the value, converted back to the type it was written with
+        template <typename Value, typename Func>
+        void withValue(const Value& value, Func&& func)
+        {
+            switch (value.type)
+            {
+            case binary::ValueType::String:
+                return func(value.str);
+            case binary::ValueType::Char:
+                return func(value.c);
+            case binary::ValueType::UInt8:
+                return func(static_cast<uint8_t>(value.u));
+            case binary::ValueType::UInt16:
+                return func(static_cast<uint16_t>(value.u));
+            case binary::ValueType::UInt32:
+                return func(static_cast<uint32_t>(value.u));
+            case binary::ValueType::UInt64:
+                return func(static_cast<uint64_t>(value.u));
+            case binary::ValueType::Int8:
+                return func(static_cast<int8_t>(value.i));
+            case binary::ValueType::Int16:
+                return func(static_cast<int16_t>(value.i));
+            case binary::ValueType::Int32:
+                return func(static_cast<int32_t>(value.i));
+            case binary::ValueType::Int64:
+                return func(static_cast<int64_t>(value.i));
+            case binary::ValueType::Bool:
+                return func(value.b);
+            case binary::ValueType::Float:
+                return func(value.f);
+            case binary::ValueType::Double:
+                return func(value.d);
+            }
+        }
+    }
+
+    size_t BinaryDecoder::decode(const char* data, size_t size, const OnEvent& onEvent)
+    {
+        size_t pos = 0;
+        while (size - pos >= binary::RecordHeaderSize)
+        {
+            auto type = static_cast<binary::RecordType>(static_cast<uint8_t>(data[pos]));
+            if (!m_started && type != binary::RecordType::Session)
+                throw BinaryFormatError("missing session record, not a binary log");
+
+            auto payloadSize = binary::decodeLE<uint32_t>(data + pos + sizeof(uint8_t));
+            if (size - pos - binary::RecordHeaderSize < payloadSize)
+                break;
+
+            const auto* payload = data + pos + binary::RecordHeaderSize;
+
+            switch (type)
+            {
+            case binary::RecordType::Session:
+                decodeSession(payload, payloadSize);
+                break;
+            case binary::RecordType::String:
+                decodeString(payload, payloadSize);
+                break;
+            case binary::RecordType::Event:
+                decodeEvent(payload, payloadSize, onEvent);
+                break;
+            // Records added by future versions
+            default:
+                break;
+            }
+
+            pos += binary::RecordHeaderSize + payloadSize;
+        }
+
+        return pos;
+    }
+
+    void BinaryDecoder::decodeSession(const char* data, size_t size)
+    {
+        Reader reader(data, size);
+
+        auto magic = reader.remaining();
+        if (magic.size() < sizeof(binary::Magic) + sizeof(binary::Version)
+            || std::memcmp(magic.data(), binary::Magic, sizeof(binary::Magic)) != 0)
+            throw BinaryFormatError("invalid session record, not a binary log");
+
+        auto version = binary::decodeLE<uint16_t>(magic.data() + sizeof(binary::Magic));
+        if (version > binary::Version)
+            throw BinaryFormatError(fmt::format("unsupported version {}", version));
+
+        m_started = true;
+        m_strings.clear();
+    }
+
+    void BinaryDecoder::decodeString(const char* data, size_t size)
+    {
+        Reader reader(data, size);
+
+        auto id = reader.read<uint32_t>();
+        if (id != m_strings.size() + 1)
+            throw BinaryFormatError(fmt::format("unexpected string id {}", id));
+
+        m_strings.emplace_back(reader.remaining());
+    }
+
+    void BinaryDecoder::decodeEvent(const char* data, size_t size, const OnEvent& onEvent)
+    {
+        Reader reader(data, size);
+
+        auto nanos    = std::chrono::nanoseconds(reader.read<int64_t>());
+        auto threadId = reader.read<uint64_t>();
+        auto level    = static_cast<LogLevel>(reader.read<uint8_t>());
+        auto name     = string(reader.read<uint32_t>());
+
+        m_buffer.reset();
+        m_buffer.writeTime(TimePoint(std::chrono::duration_cast<TimePoint::duration>(nanos)));
+        m_buffer.writeThreadId(static_cast<thread_utils::id>(threadId));
+
+        auto textKind = static_cast<binary::TextKind>(reader.read<uint8_t>());
+        if (textKind == binary::TextKind::Format)
+        {
+            auto formatStr = string(reader.read<uint32_t>());
+            auto argsCount = reader.read<uint8_t>();
+
+            m_args.clear();
+            for (size_t i = 0; i < argsCount; ++i)
+                m_args.push_back(readValue<Value>(reader));
+
+            formatText(formatStr);
+            m_buffer.writeText(std::string_view(m_text.data(), m_text.size()));
+        }
+        else if (textKind == binary::TextKind::Raw)
+        {
+            m_buffer.writeText(reader.readBytes());
+        }
+
+        auto fileId = reader.read<uint32_t>();
+        auto line   = reader.read<uint32_t>();
+        if (fileId != 0)
+            m_buffer.writeSourceLocation(SourceLocation { string(fileId), line });
+
+        auto fieldsCount = reader.read<uint8_t>();
+
+        m_fields.clear();
+        for (size_t i = 0; i < fieldsCount; ++i)
+        {
+            auto key = string(reader.read<uint32_t>());
+            m_fields.push_back(Field { key, readValue<Value>(reader) });
+        }
+
+        if (!m_fields.empty())
+            m_buffer.writeExternalFields(m_fields.size(), &BinaryDecoder::visitFields, &m_fields);
+
+        onEvent(name, level, m_buffer);
+    }
+
+    std::string_view BinaryDecoder::string(uint32_t id) const
+    {
+        if (id == 0 || id > m_strings.size())
+            throw BinaryFormatError(fmt::format("unknown string id {}", id));
+
+        return m_strings[id - 1];
+    }
+
+    void BinaryDecoder::formatText(std::string_view formatStr)
+    {
+        m_text.clear();
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        for (const auto& arg : m_args)
+        {
+            withValue(arg, [&](auto value) {
+                store.push_back(value);
+            });
+        }
+
+        // The arguments are decoded with the type they were formatted with, formatting can
+        // only fail for arguments that were converted to strings when encoded
+        try
+        {
+            fmt::vformat_to(std::back_inserter(m_text), fmt::string_view(formatStr.data(), formatStr.size()), store);
+        }
+        catch (const fmt::format_error&)
+        {
+            m_text.clear();
+            m_text.append(formatStr.data(), formatStr.data() + formatStr.size());
+        }
+    }
+
+    void BinaryDecoder::visitFields(const void* data, LogFieldVisitor& visitor)
+    {
+        const auto& fields = *static_cast<const std::vector<Field>*>(data);
+        for (const auto& field : fields)
+        {
+            withValue(field.value, [&](auto value) {
+                visitor.visit(field.key, value);
+            });
+        }
+    }
+}
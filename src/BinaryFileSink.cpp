@@ -0,0 +1,34 @@
+#include "logpp/sinks/file/BinaryFileSink.h"
+
+namespace logpp::sink
+{
+    BinaryFileSink::BinaryFileSink()
+    {
+        setFormatter(std::make_shared<BinaryFormatter>());
+    }
+
+    BinaryFileSink::BinaryFileSink(std::string_view filePath)
+        : BinaryFileSink()
+    {
+        open(filePath);
+    }
+
+    void BinaryFileSink::activateOptions(const Options& options)
+    {
+        if (options.tryGet("format"))
+            raiseConfigurationError("format: not supported, events are written in binary");
+
+        FileSink::activateOptions(options);
+    }
+
+    void BinaryFileSink::formatEvent(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out)
+    {
+        format(name, level, buffer, out);
+    }
+
+    void BinaryFileSink::onAfterOpened(const std::unique_ptr<File>&)
+    {
+        if (auto formatter = std::dynamic_pointer_cast<BinaryFormatter>(this->formatter()))
+            formatter->reset();
+    }
+}
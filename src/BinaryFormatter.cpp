@@ -0,0 +1,256 @@
+#include "logpp/format/BinaryFormatter.h"
+
+#include "logpp/core/LogFieldVisitor.h"
+
+#include "logpp/utils/thread.h"
+
+namespace logpp
+{
+    namespace
+    {
+        template <typename T>
+        void put(fmt::memory_buffer& out, T value)
+        {
+            char bytes[sizeof(T)];
+            binary::encodeLE(bytes, value);
+            out.append(bytes, bytes + sizeof(T));
+        }
+
+        void putBytes(fmt::memory_buffer& out, std::string_view bytes)
+        {
+            put(out, static_cast<uint32_t>(bytes.size()));
+            out.append(bytes.data(), bytes.data() + bytes.size());
+        }
+
+        void putRecordHeader(fmt::memory_buffer& out, binary::RecordType type, size_t size)
+        {
+            put(out, static_cast<uint8_t>(type));
+            put(out, static_cast<uint32_t>(size));
+        }
+
+        template <typename T>
+        void patch(fmt::memory_buffer& out, size_t index, T value)
+        {
+            binary::encodeLE(out.data() + index, value);
+        }
+
+        // Writes the values visited to `values`. `onKey` is called with the key of every value
+        template <typename OnKey>
+        class ValueWriter final : public LogFieldVisitor
+        {
+        public:
+            ValueWriter(fmt::memory_buffer& values, OnKey onKey)
+                : m_values(values)
+                , m_onKey(std::move(onKey))
+            { }
+
+            void visitStart(size_t) override
+            { }
+
+            void visit(std::string_view key, std::string_view value) override
+            {
+                writeType(key, binary::ValueType::String);
+                putBytes(m_values, value);
+            }
+
+            void visit(std::string_view key, char value) override
+            {
+                writeType(key, binary::ValueType::Char);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, uint8_t value) override
+            {
+                writeType(key, binary::ValueType::UInt8);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, uint16_t value) override
+            {
+                writeType(key, binary::ValueType::UInt16);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, uint32_t value) override
+            {
+                writeType(key, binary::ValueType::UInt32);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, uint64_t value) override
+            {
+                writeType(key, binary::ValueType::UInt64);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, int8_t value) override
+            {
+                writeType(key, binary::ValueType::Int8);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, int16_t value) override
+            {
+                writeType(key, binary::ValueType::Int16);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, int32_t value) override
+            {
+                writeType(key, binary::ValueType::Int32);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, int64_t value) override
+            {
+                writeType(key, binary::ValueType::Int64);
+                put(m_values, value);
+            }
+
+            void visit(std::string_view key, bool value) override
+            {
+                writeType(key, binary::ValueType::Bool);
+                put(m_values, static_cast<uint8_t>(value));
+            }
+
+            void visit(std::string_view key, float value) override
+            {
+                writeType(key, binary::ValueType::Float);
+
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                put(m_values, bits);
+            }
+
+            void visit(std::string_view key, double value) override
+            {
+                writeType(key, binary::ValueType::Double);
+
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                put(m_values, bits);
+            }
+
+            void visitEnd() override
+            { }
+
+            size_t count() const
+            {
+                return m_count;
+            }
+
+        private:
+            fmt::memory_buffer& m_values;
+            OnKey m_onKey;
+            size_t m_count { 0 };
+
+            void writeType(std::string_view key, binary::ValueType type)
+            {
+                m_onKey(key);
+                put(m_values, static_cast<uint8_t>(type));
+                ++m_count;
+            }
+        };
+
+        template <typename OnKey>
+        ValueWriter<OnKey> valueWriter(fmt::memory_buffer& values, OnKey onKey)
+        {
+            return { values, std::move(onKey) };
+        }
+    }
+
+    void BinaryFormatter::reset()
+    {
+        m_started = false;
+        m_strings.clear();
+        m_ids.clear();
+    }
+
+    void BinaryFormatter::doFormat(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out) const
+    {
+        if (!m_started)
+        {
+            putRecordHeader(out, binary::RecordType::Session, sizeof(binary::Magic) + sizeof(binary::Version));
+            out.append(binary::Magic, binary::Magic + sizeof(binary::Magic));
+            put(out, binary::Version);
+
+            m_started = true;
+        }
+
+        // Strings that are not known yet are written to `out` while encoding the event,
+        // the event itself is thus encoded separately and appended afterwards
+        auto& event = m_event;
+        event.clear();
+
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(buffer.time().time_since_epoch());
+        put(event, static_cast<int64_t>(nanos.count()));
+        put(event, static_cast<uint64_t>(thread_utils::toInteger(buffer.threadId())));
+        put(event, static_cast<uint8_t>(level));
+        put(event, intern(name, out));
+
+        // The kind of the text is only known once its arguments have been visited
+        auto textIndex = event.size();
+        put(event, static_cast<uint8_t>(binary::TextKind::None));
+        put(event, uint32_t { 0 });
+        put(event, uint8_t { 0 });
+
+        auto argsWriter = valueWriter(event, [](std::string_view) {});
+        auto formatStr  = buffer.visitText(argsWriter);
+        if (!formatStr)
+        {
+            event.resize(textIndex + sizeof(uint8_t));
+        }
+        else if (argsWriter.count() == 0)
+        {
+            event.resize(textIndex);
+            put(event, static_cast<uint8_t>(binary::TextKind::Raw));
+            putBytes(event, *formatStr);
+        }
+        else
+        {
+            patch(event, textIndex, static_cast<uint8_t>(binary::TextKind::Format));
+            patch(event, textIndex + sizeof(uint8_t), intern(*formatStr, out));
+            patch(event, textIndex + sizeof(uint8_t) + sizeof(uint32_t), static_cast<uint8_t>(argsWriter.count()));
+        }
+
+        if (auto location = buffer.location())
+        {
+            put(event, intern(location->file, out));
+            put(event, static_cast<uint32_t>(location->line));
+        }
+        else
+        {
+            put(event, uint32_t { 0 });
+            put(event, uint32_t { 0 });
+        }
+
+        auto fieldsIndex = event.size();
+        put(event, uint8_t { 0 });
+
+        auto fieldsWriter = valueWriter(event, [&](std::string_view key) {
+            put(event, intern(key, out));
+        });
+        buffer.visitFieldsStatic(fieldsWriter);
+        patch(event, fieldsIndex, static_cast<uint8_t>(fieldsWriter.count()));
+
+        putRecordHeader(out, binary::RecordType::Event, event.size());
+        out.append(event.data(), event.data() + event.size());
+    }
+
+    uint32_t BinaryFormatter::intern(std::string_view str, fmt::memory_buffer& out) const
+    {
+        auto it = m_ids.find(str);
+        if (it != std::end(m_ids))
+            return it->second;
+
+        const auto& stored = m_strings.emplace_back(str);
+        auto id            = static_cast<uint32_t>(m_strings.size());
+        m_ids.emplace(std::string_view(stored), id);
+
+        putRecordHeader(out, binary::RecordType::String, sizeof(uint32_t) + str.size());
+        put(out, id);
+        out.append(str.data(), str.data() + str.size());
+
+        return id;
+    }
+}
@@ -0,0 +1,116 @@
+#include "logpp/sinks/file/BufferedFile.h"
+
+#include "logpp/utils/file.h"
+
+#include "FileDescriptor.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace logpp::sink
+{
+    BufferedFile::BufferedFile(size_t bufferSize)
+        : m_buffer(new char[std::max<size_t>(bufferSize, 1)])
+        , m_capacity(std::max<size_t>(bufferSize, 1))
+    { }
+
+    BufferedFile::BufferedFile(std::string_view filePath, size_t bufferSize)
+        : BufferedFile(bufferSize)
+    {
+        open(filePath);
+    }
+
+    BufferedFile::~BufferedFile()
+    {
+        if (isOpen())
+            close();
+    }
+
+    bool BufferedFile::open(std::string_view filePath)
+    {
+        if (isOpen())
+            return false;
+
+        std::error_code ec;
+        file_utils::createDirectories(filePath, ec);
+        if (ec)
+            return false;
+
+        std::string path(filePath);
+        auto fd = fd_utils::open(path.c_str(), true);
+        if (fd == -1)
+            return false;
+
+        auto size = fd_utils::size(fd);
+
+        m_fd      = fd;
+        m_path    = std::move(path);
+        m_size    = 0;
+        m_written = size > 0 ? static_cast<size_t>(size) : 0;
+        return true;
+    }
+
+    bool BufferedFile::isOpen() const
+    {
+        return m_fd != -1;
+    }
+
+    bool BufferedFile::close()
+    {
+        if (!isOpen())
+            return false;
+
+        flush();
+        fd_utils::close(m_fd);
+        m_fd = -1;
+
+        return true;
+    }
+
+    size_t BufferedFile::write(const char* data, size_t size)
+    {
+        if (!isOpen())
+            return 0ULL;
+
+        if (m_size + size > m_capacity)
+        {
+            flush();
+
+            // Do not bother copying writes that would not fit in the buffer anyway
+            if (size >= m_capacity)
+            {
+                writeFully(data, size);
+                return size;
+            }
+        }
+
+        std::memcpy(m_buffer.get() + m_size, data, size);
+        m_size += size;
+        return size;
+    }
+
+    size_t BufferedFile::write(const char c)
+    {
+        return write(&c, 1);
+    }
+
+    void BufferedFile::flush()
+    {
+        if (!isOpen() || m_size == 0)
+            return;
+
+        writeFully(m_buffer.get(), m_size);
+        m_size = 0;
+    }
+
+    size_t BufferedFile::size() const
+    {
+        return m_written + m_size;
+    }
+
+    void BufferedFile::writeFully(const char* data, size_t size)
+    {
+        // There is nothing we can do about a failing write, the data is dropped
+        m_written += fd_utils::writeFully(m_fd, data, size);
+    }
+}
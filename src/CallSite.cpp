@@ -0,0 +1,150 @@
+#include "logpp/core/CallSite.h"
+
+#include <algorithm>
+
+namespace logpp
+{
+    namespace
+    {
+        bool endsWithPath(std::string_view path, std::string_view suffix)
+        {
+            if (suffix.empty() || path.size() < suffix.size())
+                return false;
+
+            if (path.compare(path.size() - suffix.size(), suffix.size(), suffix) != 0)
+                return false;
+
+            if (path.size() == suffix.size())
+                return true;
+
+            auto separator = path[path.size() - suffix.size() - 1];
+            return separator == '/' || separator == '\\';
+        }
+    }
+
+    CallSiteState CallSite::registerSite()
+    {
+        return CallSiteRegistry::instance().add(*this);
+    }
+
+    CallSiteRegistry& CallSiteRegistry::instance()
+    {
+        // Never destroyed, sites can be registered until the very end of the process
+        static auto* registry = new CallSiteRegistry();
+        return *registry;
+    }
+
+    size_t CallSiteRegistry::setRule(CallSiteRule rule)
+    {
+        std::lock_guard guard(m_mutex);
+
+        auto it = std::find_if(std::begin(m_rules), std::end(m_rules), [&](const CallSiteRule& other) {
+            return other.file == rule.file && other.line == rule.line;
+        });
+        if (it != std::end(m_rules))
+            m_rules.erase(it);
+
+        size_t matched = 0;
+        for (const auto* site = m_head; site != nullptr; site = site->m_next)
+        {
+            if (matches(rule, *site))
+                ++matched;
+        }
+
+        m_rules.push_back(std::move(rule));
+        apply();
+
+        return matched;
+    }
+
+    void CallSiteRegistry::setRules(std::vector<CallSiteRule> rules)
+    {
+        std::lock_guard guard(m_mutex);
+
+        m_rules = std::move(rules);
+        apply();
+    }
+
+    bool CallSiteRegistry::removeRule(std::string_view file, std::optional<size_t> line)
+    {
+        std::lock_guard guard(m_mutex);
+
+        auto it = std::find_if(std::begin(m_rules), std::end(m_rules), [&](const CallSiteRule& rule) {
+            return rule.file == file && rule.line == line;
+        });
+        if (it == std::end(m_rules))
+            return false;
+
+        m_rules.erase(it);
+        apply();
+
+        return true;
+    }
+
+    void CallSiteRegistry::clearRules()
+    {
+        setRules({});
+    }
+
+    std::vector<CallSiteRule> CallSiteRegistry::rules() const
+    {
+        std::lock_guard guard(m_mutex);
+        return m_rules;
+    }
+
+    bool CallSiteRegistry::matches(const CallSiteRule& rule, const CallSite& site)
+    {
+        if (rule.line && *rule.line != site.line())
+            return false;
+
+        return endsWithPath(site.file(), rule.file);
+    }
+
+    CallSiteState CallSiteRegistry::add(CallSite& site)
+    {
+        std::lock_guard guard(m_mutex);
+
+        // Another thread might have registered the site in the meantime
+        auto state = site.m_state.load(std::memory_order_relaxed);
+        if (state != CallSite::Unregistered)
+            return static_cast<CallSiteState>(state);
+
+        site.m_next = m_head;
+        m_head      = &site;
+
+        auto resolved = resolve(site);
+        site.m_state.store(static_cast<uint8_t>(resolved), std::memory_order_relaxed);
+
+        return resolved;
+    }
+
+    CallSiteState CallSiteRegistry::resolve(const CallSite& site) const
+    {
+        const CallSiteRule* fileRule = nullptr;
+        const CallSiteRule* lineRule = nullptr;
+
+        for (const auto& rule : m_rules)
+        {
+            if (!matches(rule, site))
+                continue;
+
+            if (rule.line)
+                lineRule = &rule;
+            else
+                fileRule = &rule;
+        }
+
+        if (lineRule)
+            return lineRule->state;
+        if (fileRule)
+            return fileRule->state;
+
+        return CallSiteState::Default;
+    }
+
+    void CallSiteRegistry::apply()
+    {
+        for (auto* site = m_head; site != nullptr; site = site->m_next)
+            site->m_state.store(static_cast<uint8_t>(resolve(*site)), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,130 @@
+#include "logpp/core/Epoch.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace logpp
+{
+    namespace
+    {
+        struct Retired
+        {
+            uint64_t epoch;
+            std::shared_ptr<void> object;
+        };
+
+        // Objects still retired when the process exits are destroyed with the list
+        struct RetiredList
+        {
+            std::mutex mutex;
+            std::vector<Retired> objects;
+        };
+
+        RetiredList& retiredList()
+        {
+            static RetiredList list;
+            return list;
+        }
+    }
+
+    std::atomic<Epoch::Record*> Epoch::s_records { nullptr };
+
+    Epoch::LocalRecord::LocalRecord()
+        : record(acquireRecord())
+    { }
+
+    Epoch::LocalRecord::~LocalRecord()
+    {
+        releaseRecord(record);
+    }
+
+    void Epoch::retire(std::shared_ptr<void> object)
+    {
+        // Readers that announce a later epoch read the global epoch after this increment,
+        // and thus load the object that replaced this one
+        auto epoch = s_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+        {
+            auto& list = retiredList();
+            std::lock_guard guard(list.mutex);
+            list.objects.push_back(Retired { epoch, std::move(object) });
+
+            if (epoch < s_oldestRetired.load(std::memory_order_relaxed))
+                s_oldestRetired.store(epoch, std::memory_order_seq_cst);
+        }
+
+        reclaim();
+    }
+
+    size_t Epoch::reclaim()
+    {
+        // Oldest epoch still announced by a reader
+        auto oldest = std::numeric_limits<uint64_t>::max();
+        for (auto* record = s_records.load(std::memory_order_seq_cst); record != nullptr; record = record->next)
+        {
+            auto epoch = record->epoch.load(std::memory_order_seq_cst);
+            if (epoch != 0)
+                oldest = std::min(oldest, epoch);
+        }
+
+        std::vector<Retired> reclaimed;
+        size_t remaining = 0;
+        {
+            auto& list = retiredList();
+            std::lock_guard guard(list.mutex);
+
+            auto it = std::partition(std::begin(list.objects), std::end(list.objects), [&](const Retired& retired) {
+                return retired.epoch >= oldest;
+            });
+
+            std::move(it, std::end(list.objects), std::back_inserter(reclaimed));
+            list.objects.erase(it, std::end(list.objects));
+            remaining = list.objects.size();
+
+            auto oldestRetired = std::numeric_limits<uint64_t>::max();
+            for (const auto& retired : list.objects)
+                oldestRetired = std::min(oldestRetired, retired.epoch);
+            s_oldestRetired.store(oldestRetired, std::memory_order_release);
+        }
+
+        // Destroyed outside of the lock, destroying a sink can log or retire other objects
+        reclaimed.clear();
+        return remaining;
+    }
+
+    void Epoch::synchronize()
+    {
+        while (reclaim() > 0)
+            std::this_thread::yield();
+    }
+
+    Epoch::Record* Epoch::acquireRecord()
+    {
+        for (auto* record = s_records.load(std::memory_order_acquire); record != nullptr; record = record->next)
+        {
+            bool inUse = false;
+            if (record->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+                return record;
+        }
+
+        auto* record = new Record;
+        record->inUse.store(true, std::memory_order_relaxed);
+
+        auto* head = s_records.load(std::memory_order_relaxed);
+        do
+        {
+            record->next = head;
+        } while (!s_records.compare_exchange_weak(head, record, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+        return record;
+    }
+
+    void Epoch::releaseRecord(Record* record)
+    {
+        record->epoch.store(0, std::memory_order_release);
+        record->inUse.store(false, std::memory_order_release);
+    }
+}
@@ -0,0 +1,169 @@
+#include "logpp/core/EventLogBufferPool.h"
+
+#include <mutex>
+#include <vector>
+
+namespace logpp
+{
+    // Caches are never destroyed: when a thread exits, its cache is given back to a
+    // global list and adopted by the next thread that needs one. This way, a buffer
+    // that is still in flight when its owner thread exits can always be released
+    // safely, and the number of caches is bounded by the maximum number of threads
+    // that concurrently logged.
+    class EventLogBufferPool::ThreadCache
+    {
+    public:
+        Node* pop()
+        {
+            if (m_free == nullptr)
+                reclaim();
+
+            if (m_free == nullptr)
+                return new Node(this);
+
+            auto* node = m_free;
+            m_free     = node->m_next;
+            --m_freeCount;
+
+            return node;
+        }
+
+        // Must only be called by the thread that currently owns this cache
+        void push(Node* node)
+        {
+            if (m_freeCount >= MaxCachedBuffers)
+            {
+                delete node;
+                return;
+            }
+
+            node->m_next = m_free;
+            m_free       = node;
+            ++m_freeCount;
+        }
+
+        // Can be called by any thread
+        void pushRemote(Node* node)
+        {
+            auto* head = m_returned.load(std::memory_order_relaxed);
+            do
+            {
+                node->m_next = head;
+            } while (!m_returned.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+    private:
+        Node* m_free { nullptr };
+        size_t m_freeCount { 0 };
+
+        std::atomic<Node*> m_returned { nullptr };
+
+        void reclaim()
+        {
+            auto* node = m_returned.exchange(nullptr, std::memory_order_acquire);
+            while (node != nullptr)
+            {
+                auto* next = node->m_next;
+                push(node);
+                node = next;
+            }
+        }
+    };
+
+    namespace
+    {
+        class ThreadCacheRegistry
+        {
+        public:
+            using ThreadCache = EventLogBufferPool::ThreadCache;
+
+            static ThreadCacheRegistry& instance()
+            {
+                // Deliberately leaked, caches must outlive every thread and every
+                // in-flight buffer, including during static destruction
+                static auto* registry = new ThreadCacheRegistry();
+                return *registry;
+            }
+
+            ThreadCache* adopt()
+            {
+                std::lock_guard guard(m_mutex);
+                if (m_available.empty())
+                    return new ThreadCache();
+
+                auto* cache = m_available.back();
+                m_available.pop_back();
+                return cache;
+            }
+
+            void giveBack(ThreadCache* cache)
+            {
+                std::lock_guard guard(m_mutex);
+                m_available.push_back(cache);
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::vector<ThreadCache*> m_available;
+        };
+
+        thread_local EventLogBufferPool::ThreadCache* threadCache = nullptr;
+        thread_local bool threadExited                              = false;
+
+        struct ThreadCacheGuard
+        {
+            ~ThreadCacheGuard()
+            {
+                if (threadCache != nullptr)
+                    ThreadCacheRegistry::instance().giveBack(threadCache);
+
+                threadCache  = nullptr;
+                threadExited = true;
+            }
+
+            void touch()
+            { }
+        };
+
+        thread_local ThreadCacheGuard threadCacheGuard;
+
+        EventLogBufferPool::ThreadCache* currentThreadCache()
+        {
+            if (threadCache != nullptr)
+                return threadCache;
+
+            // The thread is exiting and its cache has already been given back
+            if (threadExited)
+                return nullptr;
+
+            threadCacheGuard.touch();
+            threadCache = ThreadCacheRegistry::instance().adopt();
+            return threadCache;
+        }
+    }
+
+    EventLogBufferPool::Node* EventLogBufferPool::acquire()
+    {
+        auto* cache = currentThreadCache();
+        if (cache == nullptr)
+            return new Node(nullptr);
+
+        auto* node = cache->pop();
+        node->m_buffer.reset();
+        return node;
+    }
+
+    void EventLogBufferPool::release(Node* node)
+    {
+        if (node == nullptr)
+            return;
+
+        auto* owner = node->m_owner;
+        if (owner == nullptr)
+            delete node;
+        else if (owner == threadCache)
+            owner->push(node);
+        else
+            owner->pushRemote(node);
+    }
+}
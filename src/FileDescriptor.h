@@ -0,0 +1,102 @@
+#pragma once
+
+#include "logpp/core/config.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(LOGPP_PLATFORM_WINDOWS)
+#include <io.h>
+#include <share.h>
+#else
+#include <unistd.h>
+#endif
+
+// Thin wrappers around the system calls used by the files writing directly to a
+// file descriptor
+namespace logpp::fd_utils
+{
+#if defined(LOGPP_PLATFORM_WINDOWS)
+    inline int open(const char* path, bool append)
+    {
+        int fd    = -1;
+        int flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : 0);
+        _sopen_s(&fd, path, flags, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+        return fd;
+    }
+
+    inline int64_t write(int fd, const char* data, size_t size)
+    {
+        return _write(fd, data, static_cast<unsigned int>(size));
+    }
+
+    inline int close(int fd)
+    {
+        return _close(fd);
+    }
+
+    inline int64_t size(int fd)
+    {
+        struct _stat64 st;
+        if (_fstat64(fd, &st) != 0)
+            return 0;
+        return st.st_size;
+    }
+#else
+    inline int open(const char* path, bool append)
+    {
+        int fd;
+        int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : 0);
+        do
+        {
+            fd = ::open(path, flags, 0644);
+        } while (fd == -1 && errno == EINTR);
+
+        return fd;
+    }
+
+    inline int64_t write(int fd, const char* data, size_t size)
+    {
+        return ::write(fd, data, size);
+    }
+
+    inline int close(int fd)
+    {
+        return ::close(fd);
+    }
+
+    inline int64_t size(int fd)
+    {
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+            return 0;
+        return st.st_size;
+    }
+#endif
+
+    // Write the whole content of `data`, retrying on partial writes and interruptions.
+    // Returns the number of bytes written, which is less than `size` on error
+    inline size_t writeFully(int fd, const char* data, size_t size)
+    {
+        size_t written = 0;
+        while (written < size)
+        {
+            auto res = write(fd, data + written, size - written);
+            if (res < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                break;
+            }
+
+            written += static_cast<size_t>(res);
+        }
+
+        return written;
+    }
+}
@@ -3,96 +3,62 @@
 #include "logpp/format/PatternFormatter.h"
 
 #include "logpp/utils/env.h"
-#include "logpp/utils/file.h"
+#include "logpp/utils/string.h"
 
 namespace logpp::sink
 {
-    class FileImpl : public File
+    namespace
     {
-    public:
-        explicit FileImpl(std::string_view filePath, std::ios_base::openmode openMode)
+        FlushPolicy parseFlushPolicy(const Options::Value& options)
         {
-            open(filePath, openMode);
+            if (auto policy = options.asString())
+            {
+                if (string_utils::iequals(*policy, "always"))
+                    return FlushPolicy::always();
+
+                SinkBase::raiseConfigurationError("flush: invalid policy `{}`", *policy);
+            }
+
+            auto opts = options.asDict();
+            if (!opts)
+                SinkBase::raiseConfigurationError("flush: expected string or table");
+
+            FlushPolicy policy;
+
+            auto bytesIt = opts->find("bytes");
+            if (bytesIt != std::end(*opts))
+            {
+                auto bytes = string_utils::parseSize(bytesIt->second);
+                if (!bytes)
+                    SinkBase::raiseConfigurationError("flush: invalid `bytes` {}", bytesIt->second);
+
+                policy.bytes = *bytes;
+            }
+
+            auto intervalIt = opts->find("interval");
+            if (intervalIt != std::end(*opts))
+            {
+                auto ok = string_utils::parseDuration(intervalIt->second, [&](auto duration) {
+                    policy.interval = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+                });
+
+                if (!ok)
+                    SinkBase::raiseConfigurationError("flush: invalid `interval` {}", intervalIt->second);
+            }
+
+            auto levelIt = opts->find("level");
+            if (levelIt != std::end(*opts))
+            {
+                auto level = parseLevel(levelIt->second);
+                if (!level)
+                    SinkBase::raiseConfigurationError("flush: invalid `level` {}", levelIt->second);
+
+                policy.level = *level;
+            }
+
+            return policy;
         }
-
-        ~FileImpl()
-        {
-            if (isOpen())
-                close();
-        }
-
-        bool open(std::string_view filePath, std::ios_base::openmode openMode)
-        {
-            if (m_ofs)
-                return false;
-
-            std::error_code ec;
-            file_utils::createDirectories(filePath, ec);
-            if (ec)
-                return false;
-
-            auto ofs = std::make_unique<std::ofstream>(filePath.data(), openMode);
-            if (ofs->bad() || !ofs->is_open())
-                return false;
-
-            std::swap(m_ofs, ofs);
-            m_path = filePath;
-            return true;
-        }
-
-        bool isOpen() const override
-        {
-            return m_ofs && m_ofs->is_open();
-        }
-
-        bool close() override
-        {
-            if (!m_ofs)
-                return false;
-
-            m_ofs->close();
-            m_ofs.reset();
-
-            return true;
-        }
-
-        size_t write(const char* data, size_t size) override
-        {
-            if (!m_ofs)
-                return 0ULL;
-
-            m_ofs->write(data, size);
-            return size;
-        }
-
-        size_t write(const char c) override
-        {
-            if (!m_ofs)
-                return 0ULL;
-
-            m_ofs->put(c);
-            return 1ULL;
-        }
-
-        size_t size() const override
-        {
-            if (!m_ofs || !m_ofs->rdbuf())
-                return 0;
-
-            return m_ofs->rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::out);
-        }
-
-        void flush() override
-        {
-            if (!m_ofs)
-                return;
-
-            m_ofs->flush();
-        }
-
-    private:
-        std::unique_ptr<std::ofstream> m_ofs;
-    };
+    }
 
     FileSink::FileSink()
         : FormatSink(std::make_shared<PatternFormatter>("%+"))
@@ -120,12 +86,29 @@ namespace logpp::sink
         if (!file)
             raiseConfigurationError("file: expected string");
 
+        if (auto bufferSizeOption = options.tryGet("buffer_size"))
+        {
+            auto bufferSizeStr = bufferSizeOption->asString();
+            if (!bufferSizeStr)
+                raiseConfigurationError("buffer_size: expected string");
+
+            auto bufferSize = string_utils::parseSize(*bufferSizeStr);
+            if (!bufferSize)
+                raiseConfigurationError("buffer_size: invalid size {}", *bufferSizeStr);
+
+            setBufferSize(*bufferSize);
+        }
+
+        activateFlushOptions(options);
+
         open(env_utils::expandEnvironmentVariables(*file));
     }
 
     bool FileSink::open(std::string_view filePath)
     {
-        m_file.reset(new FileImpl(filePath, std::ios_base::out | std::ios_base::app));
+        m_file = createFile(filePath);
+        m_unflushedBytes = 0;
+        m_lastFlush      = std::chrono::steady_clock::now();
         onAfterOpened(m_file);
         return isOpen();
     }
@@ -146,15 +129,127 @@ namespace logpp::sink
         return m_file->close();
     }
 
+    void FileSink::flush()
+    {
+        if (!m_file)
+            return;
+
+        m_file->flush();
+        m_unflushedBytes = 0;
+        m_lastFlush      = std::chrono::steady_clock::now();
+    }
+
+    void FileSink::setFlushPolicy(FlushPolicy policy)
+    {
+        m_flushPolicy = policy;
+    }
+
+    const FlushPolicy& FileSink::flushPolicy() const
+    {
+        return m_flushPolicy;
+    }
+
+    void FileSink::setBufferSize(size_t bufferSize)
+    {
+        m_bufferSize = bufferSize;
+    }
+
+    size_t FileSink::bufferSize() const
+    {
+        return m_bufferSize;
+    }
+
     void FileSink::sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
     {
         if (!m_file)
             return;
 
-        fmt::memory_buffer formatBuf;
-        format(name, level, buffer, formatBuf);
+        auto& formatBuf = m_formatContext.out();
+        formatEvent(name, level, buffer, formatBuf);
+
         m_file->write(formatBuf.data(), formatBuf.size());
-        m_file->write('\n');
-        m_file->flush();
+        onWritten(level, formatBuf.size());
+    }
+
+    void FileSink::sinkBatch(Span<const EventRecord> records)
+    {
+        if (!m_file)
+            return;
+
+        auto maxLevel = LogLevel::Trace;
+
+        auto& formatBuf = m_formatContext.out();
+        for (const auto& record : records)
+        {
+            formatEvent(record.name, record.level, *record.buffer, formatBuf);
+
+            maxLevel = std::max(maxLevel, record.level);
+        }
+
+        m_file->write(formatBuf.data(), formatBuf.size());
+        onWritten(maxLevel, formatBuf.size());
+
+        m_formatContext.trim();
+    }
+
+    void FileSink::formatBatch(Span<const EventRecord> records, fmt::memory_buffer& out)
+    {
+        for (const auto& record : records)
+            formatEvent(record.name, record.level, *record.buffer, out);
+    }
+
+    void FileSink::writeFormatted(std::string_view data, LogLevel maxLevel)
+    {
+        if (!m_file)
+            return;
+
+        m_file->write(data.data(), data.size());
+        onWritten(maxLevel, data.size());
+    }
+
+    void FileSink::onIdle()
+    {
+        if (!m_file || m_unflushedBytes == 0 || m_flushPolicy.interval.count() == 0)
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - m_lastFlush >= m_flushPolicy.interval)
+            flush();
+    }
+
+    std::unique_ptr<File> FileSink::createFile(std::string_view filePath)
+    {
+        return std::make_unique<BufferedFile>(filePath, m_bufferSize);
+    }
+
+    void FileSink::formatEvent(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out)
+    {
+        format(name, level, buffer, out);
+        out.push_back('\n');
+    }
+
+    void FileSink::activateFlushOptions(const Options& options)
+    {
+        if (auto flushOption = options.tryGet("flush"))
+            setFlushPolicy(parseFlushPolicy(*flushOption));
+    }
+
+    void FileSink::onWritten(LogLevel level, size_t size)
+    {
+        m_unflushedBytes += size;
+
+        if (level >= m_flushPolicy.level
+            || (m_flushPolicy.bytes > 0 && m_unflushedBytes >= m_flushPolicy.bytes))
+        {
+            flush();
+            return;
+        }
+
+        if (m_flushPolicy.interval.count() > 0)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now - m_lastFlush >= m_flushPolicy.interval)
+                flush();
+        }
     }
 }
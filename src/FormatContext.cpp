@@ -0,0 +1,57 @@
+#include "logpp/format/FormatContext.h"
+
+namespace logpp
+{
+    namespace
+    {
+        struct ThreadContext
+        {
+            FormatContext context;
+            bool inUse { false };
+        };
+
+        ThreadContext& threadContext()
+        {
+            static thread_local ThreadContext instance;
+            return instance;
+        }
+
+        void trimBuffer(fmt::memory_buffer& buffer)
+        {
+            if (buffer.capacity() <= FormatContext::MaxRetainedCapacity)
+                return;
+
+            buffer = fmt::memory_buffer();
+            buffer.reserve(FormatContext::DefaultCapacity);
+        }
+    }
+
+    void FormatContext::trim()
+    {
+        trimBuffer(m_out);
+        trimBuffer(m_scratch);
+    }
+
+    FormatContext::Scoped FormatContext::acquireScoped()
+    {
+        auto& local = threadContext();
+        if (local.inUse)
+        {
+            auto owned    = std::make_unique<FormatContext>();
+            auto* context = owned.get();
+            return Scoped { context, std::move(owned) };
+        }
+
+        local.inUse = true;
+        return Scoped { &local.context, nullptr };
+    }
+
+    FormatContext::Scoped::~Scoped()
+    {
+        if (m_owned)
+            return;
+
+        m_context->trim();
+        threadContext().inUse = false;
+    }
+}
@@ -0,0 +1,150 @@
+#include "logpp/sinks/FormatPipeline.h"
+
+#include "logpp/format/FormatContext.h"
+
+#include <algorithm>
+
+namespace logpp::sink
+{
+    FormatPipeline::FormatPipeline(size_t formatThreads, FormatFunc format, WriteFunc write)
+        : m_format(std::move(format))
+        , m_write(std::move(write))
+        , m_batches(std::max<size_t>(formatThreads, 1) * BatchesPerThread)
+    {
+        for (size_t i = 0; i < std::max<size_t>(formatThreads, 1); ++i)
+            m_formatThreads.emplace_back([this] { formatLoop(); });
+
+        m_writeThread = std::thread([this] { writeLoop(); });
+    }
+
+    FormatPipeline::~FormatPipeline()
+    {
+        {
+            std::lock_guard guard(m_mutex);
+            m_stopping = true;
+        }
+
+        // Batches already submitted are still formatted and written
+        m_submittedCond.notify_all();
+        m_formattedCond.notify_all();
+
+        for (auto& thread : m_formatThreads)
+            thread.join();
+
+        m_writeThread.join();
+    }
+
+    void FormatPipeline::submit(Span<const EventRecord> records)
+    {
+        if (records.empty())
+            return;
+
+        auto& batch = slot(m_submitted);
+        {
+            std::unique_lock lock(m_mutex);
+            m_writtenCond.wait(lock, [&] { return batch.state == State::Free; });
+        }
+
+        // A free batch is only touched by the submitting thread
+        while (batch.buffers.size() < records.size())
+            batch.buffers.emplace_back();
+
+        batch.records.clear();
+        batch.maxLevel = LogLevel::Trace;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            const auto& record = records[i];
+
+            auto& buffer = batch.buffers[i];
+            buffer       = *record.buffer;
+
+            batch.records.push_back(EventRecord { record.name, record.level, &buffer });
+            batch.maxLevel = std::max(batch.maxLevel, record.level);
+        }
+
+        {
+            std::lock_guard guard(m_mutex);
+            batch.state = State::Submitted;
+            ++m_submitted;
+        }
+
+        m_submittedCond.notify_one();
+    }
+
+    void FormatPipeline::drain()
+    {
+        std::unique_lock lock(m_mutex);
+        auto submitted = m_submitted;
+        m_writtenCond.wait(lock, [&] { return m_written >= submitted; });
+    }
+
+    size_t FormatPipeline::formatThreads() const
+    {
+        return m_formatThreads.size();
+    }
+
+    FormatPipeline::Batch& FormatPipeline::slot(uint64_t sequence)
+    {
+        return m_batches[sequence % m_batches.size()];
+    }
+
+    void FormatPipeline::formatLoop()
+    {
+        for (;;)
+        {
+            Batch* batch = nullptr;
+            {
+                std::unique_lock lock(m_mutex);
+                m_submittedCond.wait(lock, [&] { return m_stopping || m_nextToFormat < m_submitted; });
+
+                if (m_nextToFormat == m_submitted)
+                    return;
+
+                batch = &slot(m_nextToFormat++);
+            }
+
+            batch->out.clear();
+            m_format(batch->records, batch->out);
+
+            {
+                std::lock_guard guard(m_mutex);
+                batch->state = State::Formatted;
+            }
+
+            m_formattedCond.notify_one();
+        }
+    }
+
+    void FormatPipeline::writeLoop()
+    {
+        for (;;)
+        {
+            Batch* batch = nullptr;
+            {
+                std::unique_lock lock(m_mutex);
+                m_formattedCond.wait(lock, [&] {
+                    return slot(m_written).state == State::Formatted || (m_stopping && m_written == m_submitted);
+                });
+
+                if (slot(m_written).state != State::Formatted)
+                    return;
+
+                batch = &slot(m_written);
+            }
+
+            m_write(std::string_view(batch->out.data(), batch->out.size()), batch->maxLevel);
+
+            // Do not keep the storage of an unusually large batch around
+            if (batch->out.capacity() > FormatContext::MaxRetainedCapacity)
+                batch->out = fmt::memory_buffer();
+
+            {
+                std::lock_guard guard(m_mutex);
+                batch->state = State::Free;
+                ++m_written;
+            }
+
+            m_writtenCond.notify_all();
+        }
+    }
+}
@@ -0,0 +1,552 @@
+#include "logpp/sinks/file/IoUringFile.h"
+
+#include "logpp/core/config.h"
+#include "logpp/utils/file.h"
+
+#include "FileDescriptor.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#if defined(LOGPP_PLATFORM_LINUX) && defined __has_include
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define LOGPP_HAS_IO_URING
+#endif
+#endif
+#endif
+
+namespace logpp::sink
+{
+    class IoUringFile::Backend
+    {
+    public:
+        virtual ~Backend() = default;
+
+        virtual bool usesIoUring() const = 0;
+
+        // Write the buffer at the end of the file. Buffers are written in the order they are submitted
+        virtual bool submit(int fd, size_t index, const char* data, size_t size) = 0;
+
+        // Append to `completed` the index of the buffers whose write completed, waiting
+        // for at least one write to complete if `wait` is true
+        virtual void reap(bool wait, std::vector<size_t>& completed) = 0;
+    };
+
+#if defined(LOGPP_HAS_IO_URING)
+    class IoUringFile::IoUringBackend : public IoUringFile::Backend
+    {
+    public:
+        static std::unique_ptr<IoUringBackend> create(const std::vector<Buffer>& buffers, size_t bufferSize)
+        {
+            std::unique_ptr<IoUringBackend> backend(new IoUringBackend(buffers.size()));
+            if (!backend->setup(buffers, bufferSize))
+                return nullptr;
+
+            return backend;
+        }
+
+        ~IoUringBackend()
+        {
+            if (m_sqes != nullptr)
+                munmap(m_sqes, m_sqesSize);
+            if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+                munmap(m_cqRing, m_cqRingSize);
+            if (m_sqRing != nullptr)
+                munmap(m_sqRing, m_sqRingSize);
+            if (m_ringFd != -1)
+                ::close(m_ringFd);
+        }
+
+        bool usesIoUring() const override
+        {
+            return true;
+        }
+
+        // The file is opened in append mode, writes in flight at the same time could land
+        // in any order: only one write is in flight, the next ones wait for it to complete
+        bool submit(int fd, size_t index, const char* data, size_t size) override
+        {
+            m_ops[index] = Op { fd, data, size };
+            if (m_writing)
+            {
+                m_queued.push_back(index);
+                return true;
+            }
+
+            m_writing = true;
+            return submitOp(index);
+        }
+
+        void reap(bool wait, std::vector<size_t>& completed) override
+        {
+            submitPending();
+
+            for (;;)
+            {
+                auto head = *m_cqHead;
+                auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+                auto count = completed.size();
+                for (; head != tail; ++head)
+                {
+                    const auto& cqe = m_cqes[head & *m_cqMask];
+                    handleCompletion(static_cast<size_t>(cqe.user_data), cqe.res, completed);
+                }
+
+                __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+                if (!wait || completed.size() > count)
+                    return;
+
+                auto res = enter(m_unsubmitted, 1, IORING_ENTER_GETEVENTS);
+                if (res > 0)
+                    m_unsubmitted -= static_cast<unsigned>(res);
+            }
+        }
+
+    private:
+        // A write in flight. Partial writes are resubmitted until the whole buffer is written
+        struct Op
+        {
+            int fd;
+            const char* data;
+            size_t size;
+        };
+
+        explicit IoUringBackend(size_t bufferCount)
+            : m_ops(bufferCount)
+        { }
+
+        int m_ringFd { -1 };
+
+        void* m_sqRing { nullptr };
+        size_t m_sqRingSize { 0 };
+        void* m_cqRing { nullptr };
+        size_t m_cqRingSize { 0 };
+        io_uring_sqe* m_sqes { nullptr };
+        size_t m_sqesSize { 0 };
+
+        unsigned* m_sqTail { nullptr };
+        unsigned* m_sqMask { nullptr };
+        unsigned* m_sqArray { nullptr };
+
+        unsigned* m_cqHead { nullptr };
+        unsigned* m_cqTail { nullptr };
+        unsigned* m_cqMask { nullptr };
+        io_uring_cqe* m_cqes { nullptr };
+
+        std::vector<Op> m_ops;
+
+        // Buffers submitted while a write is in flight, in order
+        std::deque<size_t> m_queued;
+        bool m_writing { false };
+
+        // Entries of the submission queue the kernel has not consumed yet
+        unsigned m_unsubmitted { 0 };
+
+        bool setup(const std::vector<Buffer>& buffers, size_t bufferSize)
+        {
+            // There is at most one write in flight, the rings can never overflow
+            io_uring_params params {};
+            m_ringFd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(buffers.size()), &params));
+            if (m_ringFd < 0)
+            {
+                m_ringFd = -1;
+                return false;
+            }
+
+            m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMmap)
+                m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+            m_sqRing = mapRing(m_sqRingSize, IORING_OFF_SQ_RING);
+            if (m_sqRing == nullptr)
+                return false;
+
+            m_cqRing = singleMmap ? m_sqRing : mapRing(m_cqRingSize, IORING_OFF_CQ_RING);
+            if (m_cqRing == nullptr)
+                return false;
+
+            m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            m_sqes     = static_cast<io_uring_sqe*>(mapRing(m_sqesSize, IORING_OFF_SQES));
+            if (m_sqes == nullptr)
+                return false;
+
+            auto* sq  = static_cast<char*>(m_sqRing);
+            m_sqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sqMask  = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+            auto* cq = static_cast<char*>(m_cqRing);
+            m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_cqes   = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            // Registered buffers are pinned once instead of being mapped by the kernel on every write
+            std::vector<iovec> iovecs;
+            for (const auto& buffer : buffers)
+                iovecs.push_back(iovec { buffer.data, bufferSize });
+
+            return syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+        }
+
+        void* mapRing(size_t size, off_t offset)
+        {
+            auto* ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFd, offset);
+            return ring == MAP_FAILED ? nullptr : ring;
+        }
+
+        int enter(unsigned toSubmit, unsigned minComplete, unsigned flags)
+        {
+            int res;
+            do
+            {
+                res = static_cast<int>(syscall(__NR_io_uring_enter, m_ringFd, toSubmit, minComplete, flags, nullptr, 0));
+            } while (res < 0 && errno == EINTR);
+
+            return res;
+        }
+
+        bool submitOp(size_t index)
+        {
+            const auto& op = m_ops[index];
+
+            auto tail = *m_sqTail;
+            auto slot = tail & *m_sqMask;
+
+            auto& sqe = m_sqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode    = IORING_OP_WRITE_FIXED;
+            sqe.fd        = op.fd;
+            sqe.addr      = reinterpret_cast<uint64_t>(op.data);
+            sqe.len       = static_cast<uint32_t>(op.size);
+            // Ignored in append mode, the kernel writes at the end of the file
+            sqe.off       = 0;
+            sqe.buf_index = static_cast<uint16_t>(index);
+            sqe.user_data = index;
+
+            m_sqArray[slot] = slot;
+            __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+            // Once in the submission queue, the entry will be consumed by the kernel
+            // on the next call to io_uring_enter if it cannot be consumed right away
+            ++m_unsubmitted;
+            submitPending();
+            return true;
+        }
+
+        void submitPending()
+        {
+            if (m_unsubmitted == 0)
+                return;
+
+            auto res = enter(m_unsubmitted, 0, 0);
+            if (res > 0)
+                m_unsubmitted -= static_cast<unsigned>(res);
+        }
+
+        void handleCompletion(size_t index, int res, std::vector<size_t>& completed)
+        {
+            auto& op = m_ops[index];
+
+            if (res == -EINTR || res == -EAGAIN)
+            {
+                if (submitOp(index))
+                    return;
+            }
+            else if (res > 0 && static_cast<size_t>(res) < op.size)
+            {
+                op.data += res;
+                op.size -= static_cast<size_t>(res);
+
+                if (submitOp(index))
+                    return;
+            }
+
+            // There is nothing we can do about a failing write, the data is dropped
+            completed.push_back(index);
+
+            if (m_queued.empty())
+            {
+                m_writing = false;
+                return;
+            }
+
+            auto next = m_queued.front();
+            m_queued.pop_front();
+            submitOp(next);
+        }
+    };
+#endif
+
+    // Writes buffers in order from a dedicated thread
+    class IoUringFile::ThreadBackend : public IoUringFile::Backend
+    {
+    public:
+        ThreadBackend()
+            : m_thread([this] { run(); })
+        { }
+
+        ~ThreadBackend()
+        {
+            {
+                std::lock_guard guard(m_mutex);
+                m_stop = true;
+            }
+
+            m_requestsCv.notify_one();
+            m_thread.join();
+        }
+
+        bool usesIoUring() const override
+        {
+            return false;
+        }
+
+        bool submit(int fd, size_t index, const char* data, size_t size) override
+        {
+            {
+                std::lock_guard guard(m_mutex);
+                m_requests.push_back(Request { fd, index, data, size });
+            }
+
+            m_requestsCv.notify_one();
+            return true;
+        }
+
+        void reap(bool wait, std::vector<size_t>& completed) override
+        {
+            std::unique_lock lock(m_mutex);
+            if (wait)
+                m_completedCv.wait(lock, [&] { return !m_completed.empty(); });
+
+            completed.insert(std::end(completed), std::begin(m_completed), std::end(m_completed));
+            m_completed.clear();
+        }
+
+    private:
+        struct Request
+        {
+            int fd;
+            size_t index;
+            const char* data;
+            size_t size;
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_requestsCv;
+        std::condition_variable m_completedCv;
+
+        std::deque<Request> m_requests;
+        std::vector<size_t> m_completed;
+        bool m_stop { false };
+
+        std::thread m_thread;
+
+        void run()
+        {
+            std::unique_lock lock(m_mutex);
+            for (;;)
+            {
+                m_requestsCv.wait(lock, [&] { return m_stop || !m_requests.empty(); });
+                if (m_requests.empty())
+                    return;
+
+                auto request = m_requests.front();
+                m_requests.pop_front();
+
+                lock.unlock();
+                fd_utils::writeFully(request.fd, request.data, request.size);
+                lock.lock();
+
+                m_completed.push_back(request.index);
+                m_completedCv.notify_one();
+            }
+        }
+    };
+
+    IoUringFile::IoUringFile(size_t bufferSize, size_t bufferCount)
+        : m_bufferSize(std::max<size_t>(bufferSize, 1))
+    {
+        bufferCount = std::max<size_t>(bufferCount, 2);
+
+        m_storage.reset(new char[m_bufferSize * bufferCount]);
+        for (size_t i = 0; i < bufferCount; ++i)
+            m_buffers.push_back(Buffer { m_storage.get() + i * m_bufferSize, 0, false });
+
+#if defined(LOGPP_HAS_IO_URING)
+        m_backend = IoUringBackend::create(m_buffers, m_bufferSize);
+#endif
+        if (!m_backend)
+            m_backend = std::make_unique<ThreadBackend>();
+    }
+
+    IoUringFile::IoUringFile(std::string_view filePath, size_t bufferSize, size_t bufferCount)
+        : IoUringFile(bufferSize, bufferCount)
+    {
+        open(filePath);
+    }
+
+    IoUringFile::~IoUringFile()
+    {
+        if (isOpen())
+            close();
+    }
+
+    bool IoUringFile::open(std::string_view filePath)
+    {
+        if (isOpen())
+            return false;
+
+        std::error_code ec;
+        file_utils::createDirectories(filePath, ec);
+        if (ec)
+            return false;
+
+        std::string path(filePath);
+        // Appending keeps content written to the file by others, e.g a truncation by logrotate
+        auto fd = fd_utils::open(path.c_str(), true);
+        if (fd == -1)
+            return false;
+
+        auto size = fd_utils::size(fd);
+
+        m_fd   = fd;
+        m_path = std::move(path);
+        m_size = size > 0 ? static_cast<uint64_t>(size) : 0;
+        return true;
+    }
+
+    bool IoUringFile::isOpen() const
+    {
+        return m_fd != -1;
+    }
+
+    bool IoUringFile::close()
+    {
+        if (!isOpen())
+            return false;
+
+        flush();
+        wait();
+
+        fd_utils::close(m_fd);
+        m_fd = -1;
+
+        return true;
+    }
+
+    size_t IoUringFile::write(const char* data, size_t size)
+    {
+        if (!isOpen())
+            return 0ULL;
+
+        size_t written = 0;
+        while (written < size)
+        {
+            auto& buffer = m_buffers[m_current];
+
+            auto count = std::min(size - written, m_bufferSize - buffer.size);
+            std::memcpy(buffer.data + buffer.size, data + written, count);
+            buffer.size += count;
+            written += count;
+
+            if (buffer.size == m_bufferSize)
+                submitCurrent();
+        }
+
+        return size;
+    }
+
+    size_t IoUringFile::write(const char c)
+    {
+        return write(&c, 1);
+    }
+
+    void IoUringFile::flush()
+    {
+        if (!isOpen())
+            return;
+
+        submitCurrent();
+    }
+
+    size_t IoUringFile::size() const
+    {
+        return static_cast<size_t>(m_size) + m_buffers[m_current].size;
+    }
+
+    bool IoUringFile::usesIoUring() const
+    {
+        return m_backend->usesIoUring();
+    }
+
+    void IoUringFile::wait()
+    {
+        auto inFlight = [&] {
+            return std::any_of(std::begin(m_buffers), std::end(m_buffers), [](const Buffer& buffer) {
+                return buffer.inFlight;
+            });
+        };
+
+        while (inFlight())
+            reap(true);
+    }
+
+    void IoUringFile::submitCurrent()
+    {
+        auto& buffer = m_buffers[m_current];
+        if (buffer.size == 0)
+            return;
+
+        buffer.inFlight = m_backend->submit(m_fd, m_current, buffer.data, buffer.size);
+        if (buffer.inFlight)
+            m_size += buffer.size;
+
+        nextBuffer();
+    }
+
+    void IoUringFile::nextBuffer()
+    {
+        reap(false);
+
+        // Only block when every buffer is in flight
+        for (;;)
+        {
+            for (size_t i = 1; i <= m_buffers.size(); ++i)
+            {
+                auto index = (m_current + i) % m_buffers.size();
+                if (!m_buffers[index].inFlight)
+                {
+                    m_current              = index;
+                    m_buffers[index].size = 0;
+                    return;
+                }
+            }
+
+            reap(true);
+        }
+    }
+
+    void IoUringFile::reap(bool wait)
+    {
+        m_completed.clear();
+        m_backend->reap(wait, m_completed);
+
+        for (auto index : m_completed)
+            m_buffers[index].inFlight = false;
+    }
+}
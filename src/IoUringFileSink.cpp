@@ -0,0 +1,52 @@
+#include "logpp/sinks/file/IoUringFileSink.h"
+
+#include "logpp/format/PatternFormatter.h"
+
+#include "logpp/utils/string.h"
+
+namespace logpp::sink
+{
+    IoUringFileSink::IoUringFileSink()
+    {
+        setBufferSize(IoUringFile::DefaultBufferSize);
+    }
+
+    IoUringFileSink::IoUringFileSink(std::string_view filePath)
+        : IoUringFileSink(filePath, std::make_shared<PatternFormatter>("%+"))
+    { }
+
+    IoUringFileSink::IoUringFileSink(std::string_view filePath, std::shared_ptr<Formatter> formatter)
+        : IoUringFileSink()
+    {
+        setFormatter(std::move(formatter));
+        open(filePath);
+    }
+
+    void IoUringFileSink::activateOptions(const Options& options)
+    {
+        if (auto buffersOption = options.tryGet("buffers"))
+        {
+            auto buffersStr = buffersOption->asString();
+            if (!buffersStr)
+                raiseConfigurationError("buffers: expected string");
+
+            auto buffers = string_utils::parseSize(*buffersStr);
+            if (!buffers || *buffers < 2)
+                raiseConfigurationError("buffers: invalid number of buffers {}", *buffersStr);
+
+            setBufferCount(*buffers);
+        }
+
+        FileSink::activateOptions(options);
+    }
+
+    void IoUringFileSink::setBufferCount(size_t bufferCount)
+    {
+        m_bufferCount = bufferCount;
+    }
+
+    std::unique_ptr<File> IoUringFileSink::createFile(std::string_view filePath)
+    {
+        return std::make_unique<IoUringFile>(filePath, bufferSize(), m_bufferCount);
+    }
+}
@@ -0,0 +1,248 @@
+#include "logpp/format/JsonFormatter.h"
+#include "logpp/format/Digits.h"
+#include "logpp/format/LogFmtEscape.h"
+
+#include "logpp/core/LogFieldVisitor.h"
+
+#include "logpp/utils/file.h"
+
+#include <cmath>
+
+namespace logpp
+{
+    namespace
+    {
+        std::vector<TimestampPart> isoTimestamp()
+        {
+            return {
+                { 'Y', {} }, { '\0', "-" }, { 'm', {} }, { '\0', "-" }, { 'd', {} }, { '\0', "T" },
+                { 'H', {} }, { '\0', ":" }, { 'M', {} }, { '\0', ":" }, { 'S', {} }
+            };
+        }
+
+        void appendString(fmt::memory_buffer& out, std::string_view str)
+        {
+            logfmt::appendValue(out, str, logfmt::Quoting::Always);
+        }
+
+        // Writes the fields of an event as members of the JSON object
+        class FieldsWriter final : public LogFieldVisitor
+        {
+        public:
+            FieldsWriter(fmt::memory_buffer& out, bool first)
+                : m_out(out)
+                , m_first(first)
+            { }
+
+            void visitStart(size_t) override
+            { }
+
+            void visit(std::string_view key, std::string_view value) override
+            {
+                writeKey(key);
+                appendString(m_out, value);
+            }
+
+            void visit(std::string_view key, char value) override
+            {
+                writeKey(key);
+                appendString(m_out, std::string_view(&value, 1));
+            }
+
+            void visit(std::string_view key, uint8_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, uint16_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, uint32_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, uint64_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, int8_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, int16_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, int32_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, int64_t value) override
+            {
+                writeInteger(key, value);
+            }
+
+            void visit(std::string_view key, bool value) override
+            {
+                writeKey(key);
+                m_out.append(std::string_view(value ? "true" : "false"));
+            }
+
+            void visit(std::string_view key, float value) override
+            {
+                writeFloat(key, value);
+            }
+
+            void visit(std::string_view key, double value) override
+            {
+                writeFloat(key, value);
+            }
+
+            void visitEnd() override
+            { }
+
+        private:
+            fmt::memory_buffer& m_out;
+            bool m_first;
+
+            void writeKey(std::string_view key)
+            {
+                if (!m_first)
+                    m_out.push_back(',');
+
+                appendString(m_out, key);
+                m_out.push_back(':');
+                m_first = false;
+            }
+
+            template <typename Integer>
+            void writeInteger(std::string_view key, Integer value)
+            {
+                writeKey(key);
+                digits::appendDecimal(m_out, value);
+            }
+
+            // JSON has no representation for NaN and infinity
+            template <typename Float>
+            void writeFloat(std::string_view key, Float value)
+            {
+                writeKey(key);
+                if (std::isfinite(value))
+                    fmt::format_to(m_out, "{}", value);
+                else
+                    m_out.append(std::string_view("null"));
+            }
+        };
+    }
+
+    JsonFormatter::JsonFormatter()
+        : JsonFormatter(Keys {})
+    { }
+
+    JsonFormatter::JsonFormatter(Keys keys)
+        : m_timestamp(isoTimestamp())
+    {
+        setKeys(std::move(keys));
+    }
+
+    void JsonFormatter::setKeys(Keys keys)
+    {
+        auto makeMember = [](const std::string& key) {
+            if (key.empty())
+                return Member {};
+
+            fmt::memory_buffer buf;
+            appendString(buf, key);
+            buf.push_back(':');
+            return Member { fmt::to_string(buf) };
+        };
+
+        m_keys    = std::move(keys);
+        m_time    = makeMember(m_keys.time);
+        m_level   = makeMember(m_keys.level);
+        m_logger  = makeMember(m_keys.logger);
+        m_message = makeMember(m_keys.message);
+        m_file    = makeMember(m_keys.file);
+        m_line    = makeMember(m_keys.line);
+    }
+
+    void JsonFormatter::doFormat(std::string_view name, LogLevel level, const EventLogBuffer& buffer, fmt::memory_buffer& out) const
+    {
+        bool first = true;
+        auto writeKey = [&](const Member& member) {
+            if (!first)
+                out.push_back(',');
+
+            out.append(member.prefix.data(), member.prefix.data() + member.prefix.size());
+            first = false;
+        };
+
+        out.push_back('{');
+
+        if (m_time.enabled())
+        {
+            writeKey(m_time);
+            out.push_back('"');
+            m_timestamp.format(name, level, buffer, out);
+
+            auto time   = buffer.time();
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(time - std::chrono::floor<std::chrono::seconds>(time));
+
+            char fraction[] = ".000000Z\"";
+            auto value      = static_cast<unsigned>(micros.count());
+            for (size_t i = 6; i > 0; --i)
+            {
+                fraction[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            out.append(fraction, fraction + sizeof(fraction) - 1);
+        }
+
+        if (m_level.enabled())
+        {
+            writeKey(m_level);
+            appendString(out, levelString(level));
+        }
+
+        if (m_logger.enabled())
+        {
+            writeKey(m_logger);
+            appendString(out, name);
+        }
+
+        if (m_message.enabled())
+        {
+            writeKey(m_message);
+            auto start = out.size();
+            buffer.formatText(out);
+            logfmt::quoteInPlace(out, start, logfmt::Quoting::Always);
+        }
+
+        if (auto location = buffer.location())
+        {
+            if (m_file.enabled())
+            {
+                writeKey(m_file);
+                appendString(out, file_utils::fileName(location->file));
+            }
+
+            if (m_line.enabled())
+            {
+                writeKey(m_line);
+                digits::appendDecimal(out, location->line);
+            }
+        }
+
+        FieldsWriter writer(out, first);
+        buffer.visitFieldsStatic(writer);
+
+        out.push_back('}');
+    }
+}
@@ -25,6 +25,11 @@ namespace logpp
         return offsetAt<tag::StringLiteral>(encode(val));
     }
 
+    InternedStringOffset LogBufferBase::write(InternedString str)
+    {
+        return offsetAt<tag::InternedString>(encode(str.id));
+    }
+
     size_t LogBufferBase::size() const
     {
         return m_cursor;
@@ -35,14 +40,9 @@ namespace logpp
         return offsetAt<tag::String>(encodeString(str, size));
     }
 
-    const char* LogBufferBase::dataAt(size_t index) const
-    {
-        return const_cast<LogBufferBase*>(this)->dataAt(index);
-    }
-
     size_t LogBufferBase::encodeRaw(const char* bytes, size_t size)
     {
-        reserve(this->size() + size);
+        reserve(m_cursor + size);
         auto index = m_cursor;
         std::memcpy(dataAt(index), bytes, size);
         m_cursor += size;
@@ -62,6 +62,24 @@ namespace logpp
         m_cursor += size;
     }
 
+    void LogBufferBase::seek(size_t cursor)
+    {
+        m_cursor = cursor;
+    }
+
+    void LogBufferBase::assign(const LogBufferBase& other)
+    {
+        assign(other.m_data, other.m_cursor);
+    }
+
+    void LogBufferBase::assign(const char* bytes, size_t size)
+    {
+        reserve(size);
+        std::memcpy(m_data, bytes, size);
+
+        m_cursor = size;
+    }
+
     size_t LogBufferBase::cursor() const
     {
         return m_cursor;
@@ -0,0 +1,300 @@
+#include "logpp/format/LogFmtEscape.h"
+
+#include "logpp/core/config.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOGPP_LOGFMT_SSE2
+#include <emmintrin.h>
+#if defined(LOGPP_COMPILER_GCC) || defined(LOGPP_COMPILER_CLANG)
+#define LOGPP_LOGFMT_AVX2
+#include <immintrin.h>
+#endif
+#if defined(LOGPP_COMPILER_MSVC)
+#include <intrin.h>
+#endif
+#endif
+
+namespace logpp::logfmt
+{
+    namespace
+    {
+        bool isEscapable(unsigned char c)
+        {
+            return c < 0x20 || c == '"' || c == '\\' || c == 0x7f;
+        }
+
+        bool isQuotable(unsigned char c)
+        {
+            return c <= 0x20 || c == '=' || c == '"' || c == '\\' || c == 0x7f;
+        }
+
+        // Writes the escape sequence of `c` to `out` and returns its size
+        size_t escape(char c, char (&out)[6])
+        {
+            static constexpr char Hex[] = "0123456789abcdef";
+
+            out[0] = '\\';
+            switch (c)
+            {
+            case '"':
+            case '\\':
+                out[1] = c;
+                return 2;
+            case '\n':
+                out[1] = 'n';
+                return 2;
+            case '\r':
+                out[1] = 'r';
+                return 2;
+            case '\t':
+                out[1] = 't';
+                return 2;
+            default: {
+                auto value = static_cast<unsigned char>(c);
+                out[1]     = 'u';
+                out[2]     = '0';
+                out[3]     = '0';
+                out[4]     = Hex[value >> 4];
+                out[5]     = Hex[value & 0xf];
+                return 6;
+            }
+            }
+        }
+
+        template <bool Quote>
+        size_t findScalar(const char* data, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto c = static_cast<unsigned char>(data[i]);
+                if (Quote ? isQuotable(c) : isEscapable(c))
+                    return i;
+            }
+
+            return size;
+        }
+
+#if defined(LOGPP_LOGFMT_SSE2)
+        size_t countTrailingZeros(uint32_t bits)
+        {
+#if defined(LOGPP_COMPILER_MSVC)
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return static_cast<size_t>(__builtin_ctz(bits));
+#endif
+        }
+
+        // Classifies 16 bytes at once. Unsigned `c <= limit` is computed as `min(c, limit) == c`
+        template <bool Quote>
+        size_t findSse2(const char* data, size_t size)
+        {
+            const auto quote     = _mm_set1_epi8('"');
+            const auto backslash = _mm_set1_epi8('\\');
+            const auto del       = _mm_set1_epi8(0x7f);
+            const auto equal     = _mm_set1_epi8('=');
+            const auto limit     = _mm_set1_epi8(Quote ? 0x20 : 0x1f);
+
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+                auto mask = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+                mask      = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, del));
+                mask      = _mm_or_si128(mask, _mm_cmpeq_epi8(_mm_min_epu8(chunk, limit), chunk));
+                if constexpr (Quote)
+                    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, equal));
+
+                auto bits = static_cast<uint32_t>(_mm_movemask_epi8(mask));
+                if (bits != 0)
+                    return i + countTrailingZeros(bits);
+            }
+
+            return i + findScalar<Quote>(data + i, size - i);
+        }
+#endif
+
+#if defined(LOGPP_LOGFMT_AVX2)
+        // Same as `findSse2` with 32 bytes at once, only called when the CPU supports AVX2
+        template <bool Quote>
+        __attribute__((target("avx2"))) size_t findAvx2(const char* data, size_t size)
+        {
+            const auto quote     = _mm256_set1_epi8('"');
+            const auto backslash = _mm256_set1_epi8('\\');
+            const auto del       = _mm256_set1_epi8(0x7f);
+            const auto equal     = _mm256_set1_epi8('=');
+            const auto limit     = _mm256_set1_epi8(Quote ? 0x20 : 0x1f);
+
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+            {
+                auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+                auto mask = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+                mask      = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chunk, del));
+                mask      = _mm256_or_si256(mask, _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, limit), chunk));
+                if constexpr (Quote)
+                    mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(chunk, equal));
+
+                auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(mask));
+                if (bits != 0)
+                    return i + countTrailingZeros(bits);
+            }
+
+            return i + findSse2<Quote>(data + i, size - i);
+        }
+#endif
+
+        template <bool Quote>
+        size_t find(SimdLevel level, const char* data, size_t size)
+        {
+#if defined(LOGPP_LOGFMT_AVX2)
+            if (level == SimdLevel::Avx2)
+                return findAvx2<Quote>(data, size);
+#endif
+#if defined(LOGPP_LOGFMT_SSE2)
+            if (level != SimdLevel::Scalar)
+                return findSse2<Quote>(data, size);
+#endif
+            return findScalar<Quote>(data, size);
+        }
+
+        SimdLevel detectSimdLevel()
+        {
+#if defined(LOGPP_LOGFMT_AVX2)
+            if (__builtin_cpu_supports("avx2"))
+                return SimdLevel::Avx2;
+#endif
+#if defined(LOGPP_LOGFMT_SSE2)
+            return SimdLevel::Sse2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+    }
+
+    SimdLevel simdLevel()
+    {
+        static const SimdLevel level = detectSimdLevel();
+        return level;
+    }
+
+    bool needsQuoting(std::string_view value)
+    {
+        return details::findQuotable(simdLevel(), value.data(), value.size()) != value.size();
+    }
+
+    void appendValue(fmt::memory_buffer& out, std::string_view value, Quoting quoting)
+    {
+        const auto level = simdLevel();
+        const auto* data = value.data();
+        const auto size  = value.size();
+
+        size_t pos = 0;
+        if (quoting == Quoting::IfNeeded)
+        {
+            pos = details::findQuotable(level, data, size);
+            if (pos == size)
+            {
+                out.append(data, data + size);
+                return;
+            }
+        }
+
+        out.push_back('"');
+
+        // Escapable characters are a subset of quotable ones, no need to scan again before `pos`
+        size_t begin = 0;
+        pos += details::findEscapable(level, data + pos, size - pos);
+        while (pos < size)
+        {
+            out.append(data + begin, data + pos);
+
+            char escaped[6];
+            auto escapedSize = escape(data[pos], escaped);
+            out.append(escaped, escaped + escapedSize);
+
+            begin = pos + 1;
+            pos   = begin + details::findEscapable(level, data + begin, size - begin);
+        }
+
+        out.append(data + begin, data + size);
+        out.push_back('"');
+    }
+
+    void quoteInPlace(fmt::memory_buffer& out, size_t start, Quoting quoting)
+    {
+        const auto level = simdLevel();
+        const auto size  = out.size() - start;
+
+        size_t pos = 0;
+        if (quoting == Quoting::IfNeeded)
+        {
+            pos = details::findQuotable(level, out.data() + start, size);
+            if (pos == size)
+                return;
+        }
+
+        // Count the bytes needed by the quotes and escape sequences, then rewrite the value
+        // backwards so that every byte is only moved once
+        size_t extra   = 2;
+        size_t escapes = 0;
+        char escaped[6];
+
+        const auto* data = out.data() + start;
+        pos += details::findEscapable(level, data + pos, size - pos);
+        while (pos < size)
+        {
+            extra += escape(data[pos], escaped) - 1;
+            ++escapes;
+            pos += 1 + details::findEscapable(level, data + pos + 1, size - pos - 1);
+        }
+
+        out.resize(out.size() + extra);
+
+        auto* value = out.data() + start;
+        auto* dst   = out.data() + out.size();
+        *--dst      = '"';
+
+        if (escapes == 0)
+        {
+            std::memmove(value + 1, value, size);
+            *value = '"';
+            return;
+        }
+
+        for (const auto* src = value + size; src != value;)
+        {
+            auto c = *--src;
+            if (isEscapable(static_cast<unsigned char>(c)))
+            {
+                auto escapedSize = escape(c, escaped);
+                dst -= escapedSize;
+                std::memcpy(dst, escaped, escapedSize);
+            }
+            else
+            {
+                *--dst = c;
+            }
+        }
+
+        *--dst = '"';
+    }
+
+    namespace details
+    {
+        size_t findQuotable(SimdLevel level, const char* data, size_t size)
+        {
+            return find<true>(level, data, size);
+        }
+
+        size_t findEscapable(SimdLevel level, const char* data, size_t size)
+        {
+            return find<false>(level, data, size);
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "logpp/format/LogFmtFormatter.h"
+#include "logpp/format/LogFmtEscape.h"
 
 #include "logpp/format/flag/DateFormatter.h"
 #include "logpp/format/flag/FieldsFormatter.h"
@@ -35,19 +36,9 @@ namespace logpp
             out.append(m_key);
             out.push_back('=');
 
-            fmt::memory_buffer formatBuf;
-            m_valueFormatter->format(name, level, buffer, formatBuf);
-
-            auto str               = std::string_view(formatBuf.data(), formatBuf.size());
-            const auto shouldQuote = str.find(' ') != std::string_view::npos;
-
-            if (shouldQuote)
-                out.push_back('"');
-
-            out.append(str);
-
-            if (shouldQuote)
-                out.push_back('"');
+            auto start = out.size();
+            m_valueFormatter->format(name, level, buffer, out);
+            logfmt::quoteInPlace(out, start);
         }
 
     private:
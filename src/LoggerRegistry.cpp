@@ -3,13 +3,43 @@
 #include "logpp/sinks/AsyncSink.h"
 #include "logpp/sinks/ColoredConsole.h"
 #include "logpp/sinks/Console.h"
+#include "logpp/sinks/DedupSink.h"
+#include "logpp/sinks/RateLimitSink.h"
+#include "logpp/sinks/SampleSink.h"
+#include "logpp/sinks/file/BinaryFileSink.h"
 #include "logpp/sinks/file/FileSink.h"
+#include "logpp/sinks/file/IoUringFileSink.h"
+#include "logpp/sinks/file/MmapFileSink.h"
 #include "logpp/sinks/file/RollingFileSink.h"
 
 #include <iostream>
 
 namespace logpp
 {
+    namespace
+    {
+        std::atomic<uint64_t> nextVersion { 1 };
+
+        // Loggers recently retrieved by a thread, valid as long as the version of the
+        // registry they have been retrieved from did not change
+        struct ThreadCache
+        {
+            static constexpr size_t Size = 16;
+
+            struct Entry
+            {
+                uint64_t version { 0 };
+                size_t hash { 0 };
+                std::string name;
+                std::shared_ptr<Logger> logger;
+            };
+
+            Entry loggers[Size];
+        };
+
+        thread_local ThreadCache threadCache;
+    }
+
     class NoopSink : public sink::Sink
     {
     public:
@@ -27,6 +57,11 @@ namespace logpp
 
     LoggerRegistry::LoggerRegistry()
     {
+        {
+            std::lock_guard guard(m_mutex);
+            publish();
+        }
+
         auto defaultSink = std::make_shared<sink::ColoredOutputConsole>();
         setDefaultLogger(std::make_shared<Logger>("logpp", LogLevel::Debug, defaultSink));
 
@@ -35,7 +70,15 @@ namespace logpp
         registerSinkFactory<sink::ColoredErrorConsole>();
         registerSinkFactory<sink::OutputConsole>();
         registerSinkFactory<sink::ErrorConsole>();
+        registerSinkFactory<sink::DedupSink>();
+        registerSinkFactory<sink::RateLimitSink>();
+        registerSinkFactory<sink::SampleSink>();
+        registerSinkFactory<sink::BinaryFileSink>();
         registerSinkFactory<sink::FileSink>();
+        registerSinkFactory<sink::IoUringFileSink>();
+#if defined(LOGPP_HAS_MMAP_FILE)
+        registerSinkFactory<sink::MmapFileSink>();
+#endif
         registerSinkFactory<sink::RollingFileSink>();
 
         m_defaultLoggerFactory = [&](std::string name) {
@@ -71,30 +114,80 @@ namespace logpp
 
     bool LoggerRegistry::registerLoggerFunc(std::string name, LoggerRegistry::LoggerFactory factory, bool isDefault)
     {
-        std::lock_guard guard(m_mutex);
-
-        if (isDefault)
+        std::vector<std::shared_ptr<void>> retired;
+        bool inserted = false;
         {
-            if (m_loggerInstantiator.totalInstances() > 0)
+            std::lock_guard guard(m_mutex);
+
+            if (isDefault)
             {
-                auto tmpLogger = factory("");
-                m_loggerInstantiator.forEachInstance(
-                    [&](const std::shared_ptr<Logger>& instance) {
-                        instance->setSink(tmpLogger->sink());
-                        instance->setLevel(tmpLogger->level());
-                    });
+                if (m_loggerInstantiator.totalInstances() > 0)
+                {
+                    auto tmpLogger = factory("");
+                    m_loggerInstantiator.forEachInstance(
+                        [&](const std::shared_ptr<Logger>& instance) {
+                            instance->setSink(tmpLogger->sink());
+                            instance->setLevel(tmpLogger->level());
+                        });
+                }
+                m_defaultLoggerFactory = factory;
+                replaceDefaultLogger(std::invoke(factory, name));
             }
-            m_defaultLoggerFactory = factory;
+
+            inserted = m_loggerFactories.insert(std::make_pair(std::move(name), std::move(factory))).second;
+            resetResolvedLoggers();
+
+            retired = std::exchange(m_retired, {});
         }
 
-        auto it = m_loggerFactories.insert(std::make_pair(std::move(name), std::move(factory)));
-        return it.second;
+        retire(std::move(retired));
+        return inserted;
     }
 
     std::shared_ptr<Logger> LoggerRegistry::get(std::string_view name)
     {
-        std::lock_guard guard(m_mutex);
+        auto version = m_version.load(std::memory_order_acquire);
+        auto hash    = std::hash<std::string_view> {}(name);
+
+        auto& cached = threadCache.loggers[hash % ThreadCache::Size];
+        if (cached.version == version && cached.hash == hash && cached.name == name)
+            return cached.logger;
+
+        auto logger = readSnapshot([&](const Snapshot& snapshot) -> std::shared_ptr<Logger> {
+            auto it = snapshot.loggers.find(name);
+            if (it == std::end(snapshot.loggers))
+                return nullptr;
+
+            return it->second;
+        });
+
+        if (!logger)
+            return create(name);
+
+        cached.version = version;
+        cached.hash    = hash;
+        cached.name.assign(name.data(), name.size());
+        cached.logger = logger;
+
+        return logger;
+    }
+
+    std::shared_ptr<Logger> LoggerRegistry::create(std::string_view name)
+    {
+        std::vector<std::shared_ptr<void>> retired;
+        std::shared_ptr<Logger> logger;
+        {
+            std::lock_guard guard(m_mutex);
+            logger  = resolve(name);
+            retired = std::exchange(m_retired, {});
+        }
+
+        retire(std::move(retired));
+        return logger;
+    }
 
+    std::shared_ptr<Logger> LoggerRegistry::resolve(std::string_view name)
+    {
         LoggerKey key(name);
 
         for (auto fragmentIt = key.rbegin(); fragmentIt != key.rend(); ++fragmentIt)
@@ -103,13 +196,19 @@ namespace logpp
 
             auto loggerIt = m_loggers.find(fragment);
             if (loggerIt != std::end(m_loggers))
-                return loggerIt->second;
+            {
+                if (loggerIt->first == name)
+                    return loggerIt->second;
+
+                return addResolved(name, loggerIt->second);
+            }
 
             auto factoryIt = m_loggerFactories.find(fragment);
             if (factoryIt != std::end(m_loggerFactories))
             {
                 auto logger = std::invoke(factoryIt->second, std::string(name));
                 m_loggers.insert(std::make_pair(std::string(name), logger));
+                publish();
                 return logger;
             }
         }
@@ -118,16 +217,37 @@ namespace logpp
         {
             auto logger = std::invoke(m_defaultLoggerFactory, std::string(name));
             m_loggers.insert(std::make_pair(std::string(name), logger));
+            publish();
             return logger;
         }
 
-        return m_defaultLogger;
+        if (!m_defaultLogger)
+            return nullptr;
+
+        return addResolved(name, m_defaultLogger);
     }
 
-    std::shared_ptr<Logger> LoggerRegistry::defaultLogger()
+    std::shared_ptr<Logger> LoggerRegistry::addResolved(std::string_view name, std::shared_ptr<Logger> logger)
     {
-        std::lock_guard guard(m_mutex);
-        return m_defaultLogger;
+        m_resolvedLoggers->insert_or_assign(std::string(name), logger);
+        publish();
+        return logger;
+    }
+
+    void LoggerRegistry::resetResolvedLoggers()
+    {
+        if (m_resolvedLoggers->empty())
+            return;
+
+        m_retired.push_back(std::exchange(m_resolvedLoggers, std::make_unique<ResolvedLoggers>()));
+        publish();
+    }
+
+    std::shared_ptr<Logger> LoggerRegistry::defaultLogger() const
+    {
+        return readSnapshot([](const Snapshot& snapshot) {
+            return snapshot.defaultLogger;
+        });
     }
 
     void LoggerRegistry::setDefaultLogger(std::shared_ptr<Logger> logger)
@@ -137,17 +257,63 @@ namespace logpp
 
     void LoggerRegistry::setDefaultLoggerFunc(LoggerFactory factory)
     {
-        std::lock_guard guard(m_mutex);
-        if (m_loggerInstantiator.totalInstances() > 0)
+        std::vector<std::shared_ptr<void>> retired;
         {
-            auto tmpLogger = factory("");
-            m_loggerInstantiator.forEachInstance(
-                [&](const std::shared_ptr<Logger>& instance) {
-                    instance->setSink(tmpLogger->sink());
-                    instance->setLevel(tmpLogger->level());
-                });
+            std::lock_guard guard(m_mutex);
+            if (m_loggerInstantiator.totalInstances() > 0)
+            {
+                auto tmpLogger = factory("");
+                m_loggerInstantiator.forEachInstance(
+                    [&](const std::shared_ptr<Logger>& instance) {
+                        instance->setSink(tmpLogger->sink());
+                        instance->setLevel(tmpLogger->level());
+                    });
+            }
+            m_defaultLoggerFactory = factory;
+
+            // The default logger keeps its name, free logging functions now go through the new factory
+            auto name = m_defaultLogger ? std::string(m_defaultLogger->name()) : std::string();
+            replaceDefaultLogger(std::invoke(factory, std::move(name)));
+            resetResolvedLoggers();
+
+            retired = std::exchange(m_retired, {});
         }
-        m_defaultLoggerFactory = factory;
+
+        retire(std::move(retired));
+    }
+
+    void LoggerRegistry::replaceDefaultLogger(std::shared_ptr<Logger> logger)
+    {
+        auto previous = std::exchange(m_defaultLogger, std::move(logger));
+        m_defaultLoggerPtr.store(m_defaultLogger.get(), std::memory_order_seq_cst);
+        publish();
+
+        if (previous)
+            m_retired.push_back(std::move(previous));
+    }
+
+    void LoggerRegistry::publish()
+    {
+        auto snapshot           = std::make_shared<Snapshot>();
+        snapshot->defaultLogger = m_defaultLogger;
+        for (const auto& [name, logger] : m_loggers)
+            snapshot->loggers.emplace(name, logger);
+        for (const auto& [name, logger] : *m_resolvedLoggers)
+            snapshot->loggers.emplace(name, logger);
+
+        m_snapshot.store(snapshot.get(), std::memory_order_seq_cst);
+        m_version.store(nextVersion.fetch_add(1), std::memory_order_release);
+
+        // Readers that enter their guard from now on can only see the new snapshot
+        if (m_currentSnapshot)
+            m_retired.push_back(std::move(m_currentSnapshot));
+        m_currentSnapshot = std::move(snapshot);
+    }
+
+    void LoggerRegistry::retire(std::vector<std::shared_ptr<void>> objects)
+    {
+        for (auto& object : objects)
+            Epoch::retire(std::move(object));
     }
 
     std::shared_ptr<sink::Sink> LoggerRegistry::createSink(std::string_view name)
@@ -0,0 +1,200 @@
+#include "logpp/sinks/file/MmapFile.h"
+
+#if defined(LOGPP_HAS_MMAP_FILE)
+
+#include "logpp/utils/file.h"
+
+#include "FileDescriptor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace logpp::sink
+{
+    namespace
+    {
+        size_t pageSize()
+        {
+            static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        uint64_t roundDown(uint64_t value, uint64_t multiple)
+        {
+            return value - value % multiple;
+        }
+
+        uint64_t roundUp(uint64_t value, uint64_t multiple)
+        {
+            return roundDown(value + multiple - 1, multiple);
+        }
+
+        bool allocate(int fd, uint64_t offset, uint64_t size)
+        {
+#if defined(LOGPP_PLATFORM_LINUX)
+            if (fallocate(fd, 0, static_cast<off_t>(offset), static_cast<off_t>(size)) == 0)
+                return true;
+
+            // Not every file system supports fallocate, let the file be sparse instead
+            if (errno != EOPNOTSUPP)
+                return false;
+#endif
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+                return false;
+
+            if (static_cast<uint64_t>(st.st_size) >= offset + size)
+                return true;
+
+            return ftruncate(fd, static_cast<off_t>(offset + size)) == 0;
+        }
+    }
+
+    MmapFile::MmapFile(size_t chunkSize)
+        : m_chunkSize(static_cast<size_t>(roundUp(std::max<size_t>(chunkSize, 1), pageSize())))
+    { }
+
+    MmapFile::MmapFile(std::string_view filePath, size_t chunkSize)
+        : MmapFile(chunkSize)
+    {
+        open(filePath);
+    }
+
+    MmapFile::~MmapFile()
+    {
+        if (isOpen())
+            close();
+    }
+
+    bool MmapFile::open(std::string_view filePath)
+    {
+        if (isOpen())
+            return false;
+
+        std::error_code ec;
+        file_utils::createDirectories(filePath, ec);
+        if (ec)
+            return false;
+
+        std::string path(filePath);
+
+        int fd;
+        do
+        {
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        } while (fd == -1 && errno == EINTR);
+
+        if (fd == -1)
+            return false;
+
+        m_fd      = fd;
+        m_size    = static_cast<uint64_t>(std::max<int64_t>(fd_utils::size(fd), 0));
+        m_flushed = m_size;
+
+        if (!mapChunk(roundDown(m_size, pageSize())))
+        {
+            fd_utils::close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+
+        m_path = std::move(path);
+        return true;
+    }
+
+    bool MmapFile::isOpen() const
+    {
+        return m_fd != -1;
+    }
+
+    bool MmapFile::close()
+    {
+        if (!isOpen())
+            return false;
+
+        unmap();
+
+        // Give back the preallocated space that has not been written to
+        auto res = ftruncate(m_fd, static_cast<off_t>(m_size));
+        (void)res;
+
+        fd_utils::close(m_fd);
+        m_fd = -1;
+
+        return true;
+    }
+
+    size_t MmapFile::write(const char* data, size_t size)
+    {
+        if (m_map == nullptr)
+            return 0ULL;
+
+        size_t written = 0;
+        while (written < size)
+        {
+            auto mapEnd = m_mapOffset + m_chunkSize;
+            if (m_size == mapEnd && !mapChunk(mapEnd))
+                break;
+
+            auto count = std::min<uint64_t>(size - written, m_mapOffset + m_chunkSize - m_size);
+            std::memcpy(m_map + (m_size - m_mapOffset), data + written, count);
+
+            m_size += count;
+            written += count;
+        }
+
+        return written;
+    }
+
+    size_t MmapFile::write(const char c)
+    {
+        return write(&c, 1);
+    }
+
+    void MmapFile::flush()
+    {
+        if (m_map == nullptr || m_flushed == m_size)
+            return;
+
+        // msync requires a page-aligned address
+        auto from = roundDown(std::max(m_flushed, m_mapOffset), pageSize());
+        msync(m_map + (from - m_mapOffset), m_size - from, MS_ASYNC);
+        m_flushed = m_size;
+    }
+
+    size_t MmapFile::size() const
+    {
+        return static_cast<size_t>(m_size);
+    }
+
+    bool MmapFile::mapChunk(uint64_t offset)
+    {
+        unmap();
+
+        if (!allocate(m_fd, offset, m_chunkSize))
+            return false;
+
+        auto* map = mmap(nullptr, m_chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, static_cast<off_t>(offset));
+        if (map == MAP_FAILED)
+            return false;
+
+        m_map       = static_cast<char*>(map);
+        m_mapOffset = offset;
+        return true;
+    }
+
+    void MmapFile::unmap()
+    {
+        if (m_map == nullptr)
+            return;
+
+        munmap(m_map, m_chunkSize);
+        m_map = nullptr;
+    }
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "logpp/sinks/file/MmapFileSink.h"
+
+#if defined(LOGPP_HAS_MMAP_FILE)
+
+#include "logpp/format/PatternFormatter.h"
+
+#include "logpp/utils/string.h"
+
+#include "ArchiveOptions.h"
+
+namespace logpp::sink
+{
+    MmapFileSink::MmapFileSink() = default;
+
+    MmapFileSink::MmapFileSink(std::string_view filePath)
+        : MmapFileSink(filePath, std::make_shared<PatternFormatter>("%+"))
+    { }
+
+    MmapFileSink::MmapFileSink(std::string_view filePath, std::shared_ptr<Formatter> formatter)
+    {
+        setFormatter(std::move(formatter));
+        open(filePath);
+    }
+
+    void MmapFileSink::activateOptions(const Options& options)
+    {
+        if (auto chunkSizeOption = options.tryGet("chunk_size"))
+        {
+            auto chunkSizeStr = chunkSizeOption->asString();
+            if (!chunkSizeStr)
+                raiseConfigurationError("chunk_size: expected string");
+
+            auto chunkSize = string_utils::parseSize(*chunkSizeStr);
+            if (!chunkSize || *chunkSize == 0)
+                raiseConfigurationError("chunk_size: invalid size {}", *chunkSizeStr);
+
+            setChunkSize(*chunkSize);
+        }
+
+        if (auto strategyOption = options.tryGet("strategy"))
+        {
+            auto strategy = strategyOption->asDict();
+            if (!strategy)
+                raiseConfigurationError("strategy: invalid strategy options");
+
+            auto typeIt = strategy->find("type");
+            if (typeIt == std::end(*strategy) || !string_utils::iequals(typeIt->second, "size"))
+                raiseConfigurationError("strategy: only the `size` rolling strategy is supported");
+
+            auto sizeIt = strategy->find("size");
+            if (sizeIt == std::end(*strategy))
+                raiseConfigurationError("strategy: missing `size` for size rolling strategy");
+
+            auto size = string_utils::parseSize(sizeIt->second);
+            if (!size)
+                raiseConfigurationError("strategy: invalid size {}", sizeIt->second);
+
+            auto archiveOption = options.tryGet("archive");
+            if (!archiveOption)
+                raiseConfigurationError("missing `archive` options");
+
+            details::parseArchive(*archiveOption, [&](auto archivePolicy) {
+                setRolling(RollBySize { *size }, archivePolicy);
+            });
+        }
+
+        FileSink::activateOptions(options);
+    }
+
+    void MmapFileSink::setChunkSize(size_t chunkSize)
+    {
+        m_chunkSize = chunkSize;
+    }
+
+    void MmapFileSink::sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+    {
+        if (!m_file)
+            return;
+
+        auto size = write(name, level, buffer);
+        onWritten(level, size);
+    }
+
+    void MmapFileSink::sinkBatch(Span<const EventRecord> records)
+    {
+        if (!m_file)
+            return;
+
+        // Writing to the mapping does not involve any system call, there is nothing
+        // to gain by writing the whole batch at once
+        auto maxLevel = LogLevel::Trace;
+        size_t size   = 0;
+        for (const auto& record : records)
+        {
+            size += write(record.name, record.level, *record.buffer);
+
+            maxLevel = std::max(maxLevel, record.level);
+        }
+
+        onWritten(maxLevel, size);
+    }
+
+    void MmapFileSink::writeFormatted(std::string_view data, LogLevel maxLevel)
+    {
+        if (!m_file)
+            return;
+
+        rollIfNeeded(data.size());
+        if (m_file)
+            m_file->write(data.data(), data.size());
+
+        onWritten(maxLevel, data.size());
+    }
+
+    std::unique_ptr<File> MmapFileSink::createFile(std::string_view filePath)
+    {
+        return std::make_unique<MmapFile>(filePath, m_chunkSize);
+    }
+
+    size_t MmapFileSink::write(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+    {
+        auto& formatBuf = m_formatContext.out();
+        formatEvent(name, level, buffer, formatBuf);
+
+        rollIfNeeded(formatBuf.size());
+        if (m_file)
+            m_file->write(formatBuf.data(), formatBuf.size());
+
+        return formatBuf.size();
+    }
+
+    void MmapFileSink::rollIfNeeded(size_t size)
+    {
+        if (!m_rollSize)
+            return;
+
+        auto* file     = static_cast<MmapFile*>(m_file.get());
+        auto chunkSize = file->chunkSize();
+        auto rollSize  = std::max<size_t>((*m_rollSize + chunkSize - 1) / chunkSize, 1) * chunkSize;
+
+        auto fileSize = file->size();
+        if (fileSize == 0 || fileSize + size <= rollSize)
+            return;
+
+        std::string path(file->path());
+
+        close();
+        m_archive(path);
+        open(path);
+    }
+}
+
+#endif
@@ -1,6 +1,5 @@
 #include "logpp/format/PatternFormatter.h"
 
-#include "logpp/format/flag/DateFormatter.h"
 #include "logpp/format/flag/FieldsFormatter.h"
 #include "logpp/format/flag/LevelFormatter.h"
 #include "logpp/format/flag/LiteralFormatter.h"
@@ -9,18 +8,19 @@
 #include "logpp/format/flag/TextFormatter.h"
 #include "logpp/format/flag/ThreadFormatter.h"
 #include "logpp/format/flag/TimeFormatter.h"
+#include "logpp/format/flag/TimestampFormatter.h"
 
 namespace logpp
 {
     namespace
     {
-        template <template <typename Tz> typename FormatterT>
-        std::shared_ptr<FlagFormatter> makeZonedFormatter(tz::ZoneId zoneId)
+        template <template <typename Tz> typename FormatterT, typename... Args>
+        std::shared_ptr<FlagFormatter> makeZonedFormatter(tz::ZoneId zoneId, Args&&... args)
         {
             if (zoneId == tz::ZoneId::Local)
-                return std::make_shared<FormatterT<tz::Local>>();
+                return std::make_shared<FormatterT<tz::Local>>(std::forward<Args>(args)...);
 
-            return std::make_shared<FormatterT<tz::Utc>>();
+            return std::make_shared<FormatterT<tz::Utc>>(std::forward<Args>(args)...);
         }
     }
 
@@ -60,24 +60,56 @@ namespace logpp
         std::vector<std::shared_ptr<FlagFormatter>> formatters;
         std::string literalStr;
 
+        // Adjacent second-resolution date and time flags, along with the literals between them,
+        // are fused in a single TimestampFormatter
+        std::vector<TimestampPart> timestampParts;
+
+        auto flushLiteral = [&] {
+            if (literalStr.empty())
+                return;
+
+            if (!timestampParts.empty())
+                timestampParts.push_back(TimestampPart { '\0', std::move(literalStr) });
+            else
+                formatters.push_back(std::make_shared<LiteralFormatter>(std::move(literalStr)));
+
+            literalStr.clear();
+        };
+
+        auto flushTimestamp = [&] {
+            if (timestampParts.empty())
+                return;
+
+            formatters.push_back(makeZonedFormatter<TimestampFormatter>(m_zoneId, std::move(timestampParts)));
+            timestampParts.clear();
+        };
+
         while (it != end)
         {
             if (*it == '%')
             {
-                if (!literalStr.empty())
-                    formatters.push_back(std::make_shared<LiteralFormatter>(std::move(literalStr)));
+                flushLiteral();
 
                 ++it;
                 if (it != end)
                 {
-                    if (*it == '+')
+                    if (isTimestampFlag(*it))
                     {
-                        auto fullFormatters = parsePattern("%Y-%m-%d %H:%M:%S [%l] (%n) %v%f[ - ]");
+                        timestampParts.push_back(TimestampPart { *it, {} });
+                        ++it;
+                    }
+                    else if (*it == '+')
+                    {
+                        flushTimestamp();
+
+                        auto fullFormatters = parsePattern(pattern_compiler::FullPattern);
                         std::copy(std::begin(fullFormatters), std::end(fullFormatters), std::back_inserter(formatters));
                         ++it;
                     }
                     else
                     {
+                        flushTimestamp();
+
                         auto flag   = *it;
                         auto result = parseFlag(it);
                         if (!result.isOk())
@@ -96,8 +128,8 @@ namespace logpp
             }
         }
 
-        if (!literalStr.empty())
-            formatters.push_back(std::make_shared<LiteralFormatter>(std::move(literalStr)));
+        flushLiteral();
+        flushTimestamp();
 
         return formatters;
     }
@@ -108,51 +140,12 @@ namespace logpp
 
         switch (*it)
         {
-        // -----------------------------
-        // Date
-        // -----------------------------
-
-        // Writes year as a decimal number, e.g. 2017
-        case 'Y': {
-            ++it;
-            formatter = makeZonedFormatter<YearFormatter>(m_zoneId);
-            break;
-        }
-        // Writes month as a decimal number (range [01,12])
-        case 'm': {
-            ++it;
-            formatter = makeZonedFormatter<MonthDecimalFormatter>(m_zoneId);
-            break;
-        }
-        // Writes day of the month as a decimal number (range [01,31])
-        case 'd': {
-            ++it;
-            formatter = makeZonedFormatter<DayDecimalFormatter>(m_zoneId);
-            break;
-        }
+        // Date and time flags (%Y %m %d %H %M %S) are handled by a TimestampFormatter in `parsePattern`
 
         // -----------------------------
         // Time
         // -----------------------------
 
-        // Writes hour as a decimal number, 24 hour clock (range [00-23])
-        case 'H': {
-            ++it;
-            formatter = makeZonedFormatter<HoursFormatter>(m_zoneId);
-            break;
-        }
-        // Writes minute as a decimal number (range [00,59])
-        case 'M': {
-            ++it;
-            formatter = makeZonedFormatter<MinutesFormatter>(m_zoneId);
-            break;
-        }
-        // Writes second as a decimal number (range [00,60])
-        case 'S': {
-            ++it;
-            formatter = makeZonedFormatter<SecondsFormatter>(m_zoneId);
-            break;
-        }
         // Writes millisecond as a decimal number (range [000, 999])
         case 'i': {
             ++it;
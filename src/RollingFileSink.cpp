@@ -7,6 +7,8 @@
 #include "logpp/utils/file.h"
 #include "logpp/utils/string.h"
 
+#include "ArchiveOptions.h"
+
 #include <cstring>
 
 namespace logpp::sink
@@ -65,76 +67,6 @@ namespace logpp::sink
             }
         }
 
-        template<typename Time, typename Func>
-        void parseArchiveTimestampOffset(const Options::Dict& options, std::string pattern, Func&& onParsed)
-        {
-            auto offsetIt = options.find("offset");
-            if (offsetIt == std::end(options))
-            {
-                onParsed(ArchiveTimestamp<Time> { std::move(pattern) });
-                return;
-            }
-
-            auto ok = string_utils::parseDuration(offsetIt->second, [&](auto duration) {
-                onParsed(ArchiveTimestamp<Time, offset::Fixed<decltype(duration)>> { std::move(pattern), duration });
-            });
-
-            if (!ok)
-                SinkBase::raiseConfigurationError("archive: invalid `offset` {}", offsetIt->second);
-        }
-
-        template <typename Func>
-        void parseArchive(const Options::Value& options, Func&& onParsed)
-        {
-            if (auto opts = options.asString())
-            {
-                if (string_utils::iequals(*opts, "incremental"))
-                    onParsed(ArchiveIncremental {});
-                else if (string_utils::iequals(*opts, "timestamp"))
-                    onParsed(ArchiveTimestamp<UTCTime> {});
-
-                SinkBase::raiseConfigurationError("archive: invalid type {}", *opts);
-            }
-            else if (auto opts = options.asDict())
-            {
-                auto typeIt = opts->find("type");
-                if (typeIt == std::end(*opts))
-                    SinkBase::raiseConfigurationError("archive: missing `type`");
-
-                auto type = typeIt->second;
-                if (string_utils::iequals(type, "incremental"))
-                {
-                    onParsed(ArchiveIncremental {});
-                }
-                else if (string_utils::iequals(type, "timestamp"))
-                {
-                    static constexpr auto DefaultPattern = std::string_view("%Y%m%d");
-
-                    auto patternIt = opts->find("pattern");
-                    auto pattern   = patternIt == std::end(*opts) ? std::string(DefaultPattern) : patternIt->second;
-
-                    auto tzIt = opts->find("tz");
-                    if (tzIt == std::end(*opts))
-                    {
-                        parseArchiveTimestampOffset<UTCTime>(*opts, std::move(pattern), std::forward<Func>(onParsed));
-                        return;
-                    }
-
-                    auto tz = tzIt->second;
-                    if (string_utils::iequals(tz, "utc"))
-                        parseArchiveTimestampOffset<UTCTime>(*opts, std::move(pattern), std::forward<Func>(onParsed));
-                    else if (string_utils::iequals(tz, "local"))
-                        parseArchiveTimestampOffset<LocalTime>(*opts, std::move(pattern), std::forward<Func>(onParsed));
-                    else
-                        SinkBase::raiseConfigurationError("archive: invalid `tz` {}", tz);
-                }
-            }
-            else
-            {
-                SinkBase::raiseConfigurationError("archive: invalid archive options");
-            }
-        }
-
         template <typename Func>
         void parseRollingAndArchive(const Options& options, Func&& onParsed)
         {
@@ -147,7 +79,7 @@ namespace logpp::sink
                 SinkBase::raiseConfigurationError("missing `archive` options");
 
             parseRolling(*rollingOpts, [&](auto rollingStrategy) {
-                parseArchive(*archiveOpts, [&](auto archiveStrategy) {
+                details::parseArchive(*archiveOpts, [&](auto archiveStrategy) {
                     onParsed(rollingStrategy, archiveStrategy);
                 });
             });
@@ -269,6 +201,8 @@ namespace logpp::sink
         if (!file)
             raiseConfigurationError("file: expected string");
 
+        activateFlushOptions(options);
+
         parseRollingAndArchive(options, [&](auto rollingStrategy, auto archiveStrategy) {
             m_file.reset(new FileImpl(env_utils::expandEnvironmentVariables(*file), std::ios_base::out | std::ios_base::app, rollingStrategy, archiveStrategy));
             onAfterOpened(m_file);
@@ -290,4 +224,38 @@ namespace logpp::sink
 
         FileSink::sink(name, level, buffer);
     }
+
+    // Rolling is checked once per batch, a file can thus grow past its maximum size
+    // by at most one batch
+    void RollingFileSink::sinkBatch(Span<const EventRecord> records)
+    {
+        if (!m_file)
+            return;
+
+        auto* file = static_cast<FileImpl*>(m_file.get());
+        if (file->canRoll())
+        {
+            onBeforeClosing(m_file);
+            file->roll();
+            onAfterOpened(m_file);
+        }
+
+        FileSink::sinkBatch(records);
+    }
+
+    void RollingFileSink::writeFormatted(std::string_view data, LogLevel maxLevel)
+    {
+        if (!m_file)
+            return;
+
+        auto* file = static_cast<FileImpl*>(m_file.get());
+        if (file->canRoll())
+        {
+            onBeforeClosing(m_file);
+            file->roll();
+            onAfterOpened(m_file);
+        }
+
+        FileSink::writeFormatted(data, maxLevel);
+    }
 }
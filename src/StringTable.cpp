@@ -0,0 +1,181 @@
+#include "logpp/core/StringTable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace logpp
+{
+    namespace
+    {
+        size_t nextPowerOfTwo(size_t value)
+        {
+            size_t power = 1;
+            while (power < value)
+                power <<= 1;
+            return power;
+        }
+    }
+
+    StringTable::StringTable(size_t capacity)
+        : m_capacity(capacity)
+        , m_chunksCount((capacity + 1 + ChunkSize - 1) / ChunkSize)
+        , m_chunks(new std::atomic<Entry*>[m_chunksCount])
+        , m_indexMask(nextPowerOfTwo(capacity * 2) - 1)
+        , m_index(new std::atomic<StringId>[m_indexMask + 1])
+    {
+        for (size_t i = 0; i < m_chunksCount; ++i)
+            m_chunks[i].store(nullptr, std::memory_order_relaxed);
+
+        for (size_t i = 0; i <= m_indexMask; ++i)
+            m_index[i].store(InvalidId, std::memory_order_relaxed);
+    }
+
+    StringTable::~StringTable()
+    {
+        for (size_t i = 0; i < m_chunksCount; ++i)
+        {
+            auto* chunk = m_chunks[i].load(std::memory_order_relaxed);
+            if (chunk == nullptr)
+                continue;
+
+            for (size_t j = 0; j < ChunkSize; ++j)
+                delete[] chunk[j].data;
+
+            delete[] chunk;
+        }
+    }
+
+    StringTable& StringTable::instance()
+    {
+        static auto* table = new StringTable();
+        return *table;
+    }
+
+    StringId StringTable::intern(std::string_view str)
+    {
+        auto hash  = hashOf(str);
+        auto newId = InvalidId;
+
+        for (size_t slot = hash & m_indexMask;; slot = (slot + 1) & m_indexMask)
+        {
+            auto id = m_index[slot].load(std::memory_order_acquire);
+            if (id == InvalidId)
+            {
+                if (newId == InvalidId)
+                {
+                    newId = allocate(str, hash);
+                    if (newId == InvalidId)
+                        return InvalidId;
+                }
+
+                if (m_index[slot].compare_exchange_strong(id, newId, std::memory_order_acq_rel, std::memory_order_acquire))
+                    return newId;
+            }
+
+            // When the same string is interned concurrently, the id allocated by the thread
+            // that lost the race is left unused
+            if (matches(id, str, hash))
+                return id;
+        }
+    }
+
+    std::optional<StringId> StringTable::find(std::string_view str) const
+    {
+        auto hash = hashOf(str);
+        for (size_t slot = hash & m_indexMask;; slot = (slot + 1) & m_indexMask)
+        {
+            auto id = m_index[slot].load(std::memory_order_acquire);
+            if (id == InvalidId)
+                return std::nullopt;
+
+            if (matches(id, str, hash))
+                return id;
+        }
+    }
+
+    std::string_view StringTable::get(StringId id) const
+    {
+        const auto* e = entry(id);
+        if (e == nullptr || e->data == nullptr)
+            return {};
+
+        return std::string_view(e->data, e->size);
+    }
+
+    size_t StringTable::size() const
+    {
+        return std::min<size_t>(m_nextId.load(std::memory_order_relaxed) - 1, m_capacity);
+    }
+
+    StringId StringTable::allocate(std::string_view str, uint32_t hash)
+    {
+        // Check before incrementing so that the next id can not overflow once the table is full
+        if (m_nextId.load(std::memory_order_relaxed) > m_capacity)
+            return InvalidId;
+
+        auto id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+        if (id > m_capacity)
+            return InvalidId;
+
+        auto& chunk = m_chunks[id / ChunkSize];
+
+        auto* entries = chunk.load(std::memory_order_acquire);
+        if (entries == nullptr)
+        {
+            auto* newEntries = new Entry[ChunkSize]();
+            if (chunk.compare_exchange_strong(entries, newEntries, std::memory_order_acq_rel, std::memory_order_acquire))
+                entries = newEntries;
+            else
+                delete[] newEntries;
+        }
+
+        auto* data = new char[str.size() + 1];
+        std::memcpy(data, str.data(), str.size());
+        data[str.size()] = '\0';
+
+        // The entry is published by the release of the index slot, or by whatever hands
+        // the id over to another thread
+        entries[id % ChunkSize] = Entry { data, static_cast<uint32_t>(str.size()), hash };
+        return id;
+    }
+
+    const StringTable::Entry* StringTable::entry(StringId id) const
+    {
+        if (id == InvalidId || id > m_capacity)
+            return nullptr;
+
+        const auto* entries = m_chunks[id / ChunkSize].load(std::memory_order_acquire);
+        if (entries == nullptr)
+            return nullptr;
+
+        return &entries[id % ChunkSize];
+    }
+
+    bool StringTable::matches(StringId id, std::string_view str, uint32_t hash) const
+    {
+        const auto* e = entry(id);
+        return e->hash == hash && std::string_view(e->data, e->size) == str;
+    }
+
+    uint32_t StringTable::hashOf(std::string_view str)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (char c : str)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    InternedString intern(std::string_view str)
+    {
+        auto id = StringTable::instance().intern(str);
+        if (id == StringTable::InvalidId)
+            throw std::length_error("logpp: string table is full, increase LOGPP_STRING_TABLE_CAPACITY");
+
+        return InternedString { id };
+    }
+}
@@ -10,6 +10,8 @@
 #include "logpp/sinks/MultiSink.h"
 #include "logpp/sinks/Sink.h"
 
+#include <fmt/format.h>
+
 #include <fstream>
 #include <iostream>
 
@@ -25,7 +27,7 @@ namespace logpp
             else if (auto* intVal = node.as_integer())
                 return std::to_string(intVal->get());
             else if (auto* floatVal = node.as_floating_point())
-                return std::to_string(floatVal->get());
+                return fmt::format("{}", floatVal->get());
             else if (auto* boolVal = node.as_boolean())
                 return boolVal->get() ? "true" : "false";
 
@@ -35,9 +37,11 @@ namespace logpp
         template <typename Node>
         std::optional<TomlConfigurator::Error> addSinkOption(sink::Options& options, std::string key, const Node& node)
         {
-            if constexpr (toml::is_integer<Node>)
+            if constexpr (toml::is_integer<Node> || toml::is_floating_point<Node>)
             {
-                if (!options.add(std::move(key), std::to_string(node.get())))
+                // Shortest representation that reads back to the same value, std::to_string
+                // would round floats to 6 decimals
+                if (!options.add(std::move(key), fmt::format("{}", node.get())))
                     return TomlConfigurator::Error { "invalid option", node.source() };
 
                 return std::nullopt;
@@ -165,6 +169,8 @@ namespace logpp
                     });
                 }
 
+                CallSiteRegistry::instance().setRules(std::move(result.callSites));
+
                 std::cout << "[logpp] Configuration " << path << " has been reloaded\n";
             }
             catch (const std::exception& e)
@@ -190,7 +196,11 @@ namespace logpp
         if (err2)
             return ParseResult::failure(*err2);
 
-        return ParseResult::success(std::move(sinks), std::move(loggers));
+        auto [callSites, err3] = parseCallSites(table);
+        if (err3)
+            return ParseResult::failure(*err3);
+
+        return ParseResult::success(std::move(sinks), std::move(loggers), std::move(callSites));
     }
 
     std::pair<std::vector<TomlConfigurator::Sink>, std::optional<TomlConfigurator::Error>>
@@ -284,6 +294,65 @@ namespace logpp
         return std::make_pair(std::move(loggers), std::nullopt);
     }
 
+    std::pair<std::vector<CallSiteRule>, std::optional<TomlConfigurator::Error>>
+    TomlConfigurator::parseCallSites(const toml::table& table)
+    {
+        static auto error = [](Error err) { return std::make_pair(std::vector<CallSiteRule> {}, std::move(err)); };
+
+        auto callSitesNode = table["call_sites"];
+        if (!callSitesNode)
+            return std::make_pair(std::vector<CallSiteRule> {}, std::nullopt);
+
+        auto* callSitesArray = callSitesNode.as_array();
+        if (!callSitesArray)
+            return error(Error { "call_sites: expected array of tables", table.source() });
+
+        std::vector<CallSiteRule> rules;
+        for (const auto& callSiteNode : *callSitesArray)
+        {
+            auto* callSiteTable = callSiteNode.as_table();
+            if (!callSiteTable)
+                return error(Error { "call_sites: expected table", callSiteNode.source() });
+
+            CallSiteRule rule;
+
+            auto [file, err1] = tryRead<std::string>(*callSiteTable, "file", "call_sites.file: expected string");
+            if (err1)
+                return error(*err1);
+
+            rule.file = std::move(*file);
+
+            if (callSiteTable->contains("line"))
+            {
+                auto [line, err2] = tryRead<int64_t>(*callSiteTable, "line", "call_sites.line: expected integer");
+                if (err2)
+                    return error(*err2);
+
+                if (*line <= 0)
+                    return error(Error { "call_sites.line: expected positive integer", callSiteTable->source() });
+
+                rule.line = static_cast<size_t>(*line);
+            }
+
+            auto [state, err3] = tryReadOr<std::string>(*callSiteTable, "state", "call_sites.state: expected string", "enabled");
+            if (err3)
+                return error(*err3);
+
+            if (string_utils::iequals(*state, "enabled"))
+                rule.state = CallSiteState::Enabled;
+            else if (string_utils::iequals(*state, "disabled"))
+                rule.state = CallSiteState::Disabled;
+            else if (string_utils::iequals(*state, "default"))
+                rule.state = CallSiteState::Default;
+            else
+                return error(Error { "call_sites.state: unknown state", callSiteTable->source() });
+
+            rules.push_back(std::move(rule));
+        }
+
+        return std::make_pair(std::move(rules), std::nullopt);
+    }
+
     std::pair<std::optional<TomlConfigurator::Logger>, std::optional<TomlConfigurator::Error>>
     TomlConfigurator::parseLogger(std::string, const toml::table& table, const std::vector<Sink>& sinks)
     {
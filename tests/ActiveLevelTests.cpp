@@ -0,0 +1,96 @@
+#define LOGPP_ACTIVE_LEVEL LOGPP_LEVEL_INFO
+
+#include "logpp/logpp.h"
+
+#include "gtest/gtest.h"
+
+using namespace logpp;
+
+class CountingSink : public sink::Sink
+{
+public:
+    void activateOptions(const sink::Options&) override
+    { }
+
+    void sink(std::string_view, LogLevel level, const EventLogBuffer& buffer) override
+    {
+        levels.push_back(level);
+
+        fmt::memory_buffer text;
+        buffer.formatText(text);
+        texts.emplace_back(text.data(), text.size());
+    }
+
+    std::vector<LogLevel> levels;
+    std::vector<std::string> texts;
+};
+
+struct ActiveLevelTest : public ::testing::Test
+{
+    void SetUp() override
+    {
+        sink   = std::make_shared<CountingSink>();
+        logger = std::make_shared<Logger>("ActiveLevelTest", LogLevel::Trace, sink);
+    }
+
+    // Count the evaluations of the arguments of a statement
+    int evaluate(int value)
+    {
+        ++evaluations;
+        return value;
+    }
+
+    std::shared_ptr<CountingSink> sink;
+    std::shared_ptr<Logger> logger;
+    int evaluations { 0 };
+};
+
+TEST_F(ActiveLevelTest, should_compile_out_statements_below_active_level)
+{
+    static_assert(!LOGPP_IS_ACTIVE(LogLevel::Trace));
+    static_assert(!LOGPP_IS_ACTIVE(LogLevel::Debug));
+    static_assert(LOGPP_IS_ACTIVE(LogLevel::Info));
+
+    setDefaultLogger(logger);
+
+    LOGPP_TRACE("Trace message", LOGPP_FIELD("value", evaluate(1)));
+    LOGPP_DEBUG("Debug message", LOGPP_FIELD("value", evaluate(2)));
+    ASSERT_EQ(evaluations, 0);
+    ASSERT_TRUE(sink->levels.empty());
+
+    LOGPP_INFO("Info message", LOGPP_FIELD("value", evaluate(3)));
+    LOGPP_WARN("Warn message", LOGPP_FIELD("value", evaluate(4)));
+    ASSERT_EQ(evaluations, 2);
+    ASSERT_EQ(sink->levels, (std::vector<LogLevel> { LogLevel::Info, LogLevel::Warning }));
+}
+
+TEST_F(ActiveLevelTest, should_drop_runtime_levels_below_active_level)
+{
+    setDefaultLogger(logger);
+
+    for (auto level : { LogLevel::Trace, LogLevel::Debug, LogLevel::Info })
+        LOGPP_LOG("Message", level, LOGPP_FIELD("value", evaluate(1)));
+
+    ASSERT_EQ(evaluations, 1);
+    ASSERT_EQ(sink->levels, (std::vector<LogLevel> { LogLevel::Info }));
+}
+
+TEST_F(ActiveLevelTest, should_not_evaluate_arguments_below_logger_level)
+{
+    logger->setLevel(LogLevel::Warning);
+
+    LOGPP_LOGGER_LOG(logger, LOGPP_FORMAT("Message {}", evaluate(1)), LogLevel::Info, LOGPP_FIELD("value", evaluate(2)));
+    ASSERT_EQ(evaluations, 0);
+    ASSERT_TRUE(sink->levels.empty());
+
+    LOGPP_LOGGER_LOG(logger, LOGPP_FORMAT("Message {}", evaluate(3)), LogLevel::Error, LOGPP_FIELD("value", evaluate(4)));
+    ASSERT_EQ(evaluations, 2);
+    ASSERT_EQ(sink->texts, (std::vector<std::string> { "Message 3" }));
+}
+
+TEST_F(ActiveLevelTest, should_ignore_null_logger)
+{
+    std::shared_ptr<Logger> nullLogger;
+    LOGPP_LOGGER_LOG(nullLogger, "Message", LogLevel::Error, LOGPP_FIELD("value", evaluate(1)));
+    ASSERT_EQ(evaluations, 0);
+}
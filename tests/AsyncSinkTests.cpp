@@ -7,6 +7,11 @@
 #include "logpp/sinks/AsyncSink.h"
 #include "logpp/sinks/Sink.h"
 
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <thread>
+
 using namespace logpp;
 
 class MemorySink : public sink::Sink
@@ -51,6 +56,122 @@ private:
     std::vector<Entry> m_entries;
 };
 
+// Sink that blocks the poller until it is opened
+class GateSink : public sink::Sink
+{
+public:
+    explicit GateSink(std::shared_ptr<sink::Sink> innerSink)
+        : m_innerSink(std::move(innerSink))
+    { }
+
+    void activateOptions(const sink::Options&) override { }
+
+    void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
+    {
+        {
+            std::unique_lock lock { m_mutex };
+            m_cv.wait(lock, [&] { return m_open; });
+        }
+
+        m_innerSink->sink(name, level, buffer);
+    }
+
+    void open()
+    {
+        std::scoped_lock guard { m_mutex };
+        m_open = true;
+        m_cv.notify_all();
+    }
+
+private:
+    std::shared_ptr<sink::Sink> m_innerSink;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_open { false };
+};
+
+// Records the size of every batch before forwarding it
+class BatchSink : public sink::Sink
+{
+public:
+    explicit BatchSink(std::shared_ptr<sink::Sink> innerSink)
+        : m_innerSink(std::move(innerSink))
+    { }
+
+    void activateOptions(const sink::Options&) override { }
+
+    void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
+    {
+        m_innerSink->sink(name, level, buffer);
+    }
+
+    void sinkBatch(Span<const sink::EventRecord> records) override
+    {
+        batchSizes.push_back(records.size());
+        m_innerSink->sinkBatch(records);
+    }
+
+    std::vector<size_t> batchSizes;
+
+private:
+    std::shared_ptr<sink::Sink> m_innerSink;
+};
+
+// Writes the text of events, one per line, and records the threads it has been called from
+class TextSink : public sink::SinkBase,
+                 public sink::FormattedSink
+{
+public:
+    void activateOptions(const sink::Options&) override { }
+
+    void sink(std::string_view, LogLevel, const EventLogBuffer&) override { }
+
+    void formatBatch(Span<const sink::EventRecord> records, fmt::memory_buffer& out) override
+    {
+        for (const auto& record : records)
+        {
+            record.buffer->formatText(out);
+            out.push_back('\n');
+        }
+
+        std::scoped_lock guard { m_mutex };
+        formatThreads.insert(std::this_thread::get_id());
+    }
+
+    void writeFormatted(std::string_view data, LogLevel) override
+    {
+        std::scoped_lock guard { m_mutex };
+        writeThreads.insert(std::this_thread::get_id());
+        text.append(data);
+        m_cv.notify_all();
+    }
+
+    template <typename Duration>
+    std::vector<std::string> waitForLines(size_t count, Duration timeout)
+    {
+        std::unique_lock lock { m_mutex };
+        m_cv.wait_for(lock, timeout, [&] {
+            return static_cast<size_t>(std::count(std::begin(text), std::end(text), '\n')) >= count;
+        });
+
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        for (std::string line; std::getline(stream, line);)
+            lines.push_back(line);
+
+        return lines;
+    }
+
+    std::set<std::thread::id> formatThreads;
+    std::set<std::thread::id> writeThreads;
+    std::string text;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
 struct AsyncSinkTest : public ::testing::Test
 {
     void SetUp() override
@@ -87,3 +208,297 @@ TEST_F(AsyncSinkTest, should_sink)
     auto entries = waitForEntries(Count, std::chrono::milliseconds(500));
     ASSERT_EQ(entries.size(), Count);
 }
+
+TEST_F(AsyncSinkTest, should_sink_with_ring_queue)
+{
+    static constexpr size_t Count = 1'000'000;
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.type = sink::AsyncSink::QueueType::Ring;
+    queueOptions.size = 64 * 1024;
+
+    auto ringSink = std::make_shared<sink::AsyncSink>(poller, memorySink, queueOptions);
+    ringSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, ringSink);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        logger->info(logpp::format("Test message {}", i), logpp::field("index", i));
+    }
+
+    auto entries = waitForEntries(Count, std::chrono::milliseconds(500));
+    ASSERT_EQ(entries.size(), Count);
+
+    fmt::memory_buffer text;
+    entries.back().buffer.formatText(text);
+    ASSERT_EQ(std::string_view(text.data(), text.size()), fmt::format("Test message {}", Count - 1));
+}
+
+TEST_F(AsyncSinkTest, should_sink_from_multiple_threads_with_per_thread_ring_queue)
+{
+    static constexpr size_t Threads        = 4;
+    static constexpr size_t CountPerThread = 100'000;
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.type    = sink::AsyncSink::QueueType::PerThreadRing;
+    queueOptions.size    = 64 * 1024;
+    queueOptions.ordered = true;
+
+    auto ringSink = std::make_shared<sink::AsyncSink>(poller, memorySink, queueOptions);
+    ringSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, ringSink);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < Threads; ++t)
+    {
+        threads.emplace_back([&logger, t] {
+            for (size_t i = 0; i < CountPerThread; ++i)
+                logger->info("Test message", logpp::field("thread", t), logpp::field("index", i));
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    auto entries = waitForEntries(Threads * CountPerThread, std::chrono::milliseconds(500));
+    ASSERT_EQ(entries.size(), Threads * CountPerThread);
+}
+
+TEST_F(AsyncSinkTest, should_drop_newest_events_when_full)
+{
+    static constexpr size_t Count = 100;
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.size               = 4;
+    queueOptions.backpressure       = sink::AsyncSink::Backpressure::DropNewest;
+    queueOptions.dropReportInterval = std::chrono::seconds(0);
+
+    auto gateSink  = std::make_shared<GateSink>(memorySink);
+    auto asyncSink = std::make_shared<sink::AsyncSink>(poller, gateSink, queueOptions);
+    asyncSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, asyncSink);
+    for (size_t i = 0; i < Count; ++i)
+        logger->info("Test message", logpp::field("index", i));
+
+    auto dropped = asyncSink->droppedCount();
+    ASSERT_GT(dropped, 0);
+
+    gateSink->open();
+
+    // Every event that has not been dropped, along with the report of dropped events
+    auto entries = waitForEntries(Count - dropped + 1, std::chrono::milliseconds(500));
+    ASSERT_EQ(entries.size(), Count - dropped + 1);
+
+    auto reportIt = std::find_if(std::begin(entries), std::end(entries), [](const auto& entry) {
+        return entry.name == sink::AsyncSink::DropReportLoggerName;
+    });
+    ASSERT_NE(reportIt, std::end(entries));
+
+    const auto& report = *reportIt;
+    ASSERT_EQ(report.level, LogLevel::Warning);
+
+    fmt::memory_buffer text;
+    report.buffer.formatText(text);
+    ASSERT_EQ(std::string_view(text.data(), text.size()), fmt::format("{} events dropped", dropped));
+}
+
+TEST_F(AsyncSinkTest, should_drop_oldest_events_when_full)
+{
+    static constexpr size_t Count = 100;
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.size         = 4;
+    queueOptions.backpressure = sink::AsyncSink::Backpressure::DropOldest;
+
+    auto gateSink  = std::make_shared<GateSink>(memorySink);
+    auto asyncSink = std::make_shared<sink::AsyncSink>(poller, gateSink, queueOptions);
+    asyncSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, asyncSink);
+    for (size_t i = 0; i < Count; ++i)
+        logger->info(logpp::format("Test message {}", i));
+
+    auto dropped = asyncSink->droppedCount();
+    ASSERT_GT(dropped, 0);
+
+    gateSink->open();
+
+    // Every event that has not been dropped, along with the report of dropped events
+    auto entries = waitForEntries(Count - dropped + 1, std::chrono::milliseconds(500));
+    ASSERT_EQ(entries.size(), Count - dropped + 1);
+
+    // The report is emitted after the batch it has been noticed in, which can hold the last event
+    auto last = std::find_if(entries.rbegin(), entries.rend(), [](const auto& entry) {
+        return entry.name != sink::AsyncSink::DropReportLoggerName;
+    });
+    ASSERT_NE(last, entries.rend());
+
+    fmt::memory_buffer text;
+    last->buffer.formatText(text);
+    ASSERT_EQ(std::string_view(text.data(), text.size()), fmt::format("Test message {}", Count - 1));
+}
+
+TEST_F(AsyncSinkTest, should_sink_synchronously_when_full)
+{
+    static constexpr size_t Count = 10'000;
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.size         = 4;
+    queueOptions.backpressure = sink::AsyncSink::Backpressure::Sync;
+
+    auto asyncSink = std::make_shared<sink::AsyncSink>(poller, memorySink, queueOptions);
+    asyncSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, asyncSink);
+    for (size_t i = 0; i < Count; ++i)
+        logger->info("Test message", logpp::field("index", i));
+
+    auto entries = waitForEntries(Count, std::chrono::milliseconds(500));
+    ASSERT_EQ(entries.size(), Count);
+    ASSERT_EQ(asyncSink->droppedCount(), 0);
+}
+
+TEST_F(AsyncSinkTest, should_reject_drop_oldest_for_ring_queue)
+{
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.type         = sink::AsyncSink::QueueType::Ring;
+    queueOptions.backpressure = sink::AsyncSink::Backpressure::DropOldest;
+
+    ASSERT_THROW(std::make_shared<sink::AsyncSink>(poller, memorySink, queueOptions), sink::ConfigurationError);
+}
+
+TEST_F(AsyncSinkTest, should_wake_up_blocking_poller)
+{
+    AsyncQueuePoller::Options options;
+    options.waitStrategy    = AsyncQueuePoller::WaitStrategy::Blocking;
+    options.maxParkDuration = std::chrono::hours(1);
+
+    auto blockingPoller = AsyncQueuePoller::create(options);
+    auto blockingSink   = std::make_shared<sink::AsyncSink>(blockingPoller, memorySink);
+
+    blockingPoller->start();
+    blockingSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, blockingSink);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        // Give the poller some time to park
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        logger->info("Test message");
+
+        auto entries = waitForEntries(i + 1, std::chrono::seconds(5));
+        ASSERT_EQ(entries.size(), i + 1);
+    }
+}
+
+TEST_F(AsyncSinkTest, should_sink_in_batches)
+{
+    static constexpr size_t Count     = 1'000;
+    static constexpr size_t BatchSize = 16;
+
+    auto batchSink = std::make_shared<BatchSink>(memorySink);
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.size      = 2048;
+    queueOptions.batchSize = BatchSize;
+
+    auto batchedSink = std::make_shared<sink::AsyncSink>(poller, batchSink, queueOptions);
+    batchedSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, batchedSink);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        logger->info(logpp::format("Test message {}", i));
+    }
+
+    auto entries = waitForEntries(Count, std::chrono::seconds(5));
+    ASSERT_EQ(entries.size(), Count);
+
+    ASSERT_FALSE(batchSink->batchSizes.empty());
+    for (auto batchSize : batchSink->batchSizes)
+        ASSERT_LE(batchSize, BatchSize);
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        fmt::memory_buffer text;
+        entries[i].buffer.formatText(text);
+        ASSERT_EQ(std::string_view(text.data(), text.size()), fmt::format("Test message {}", i));
+    }
+}
+
+TEST_F(AsyncSinkTest, should_take_batch_size_from_options)
+{
+    static constexpr size_t Count     = 1'000;
+    static constexpr size_t BatchSize = 16;
+
+    // Events pile up in the queue while the first one is held by the gate
+    auto gateSink  = std::make_shared<GateSink>(memorySink);
+    auto batchSink = std::make_shared<BatchSink>(gateSink);
+    LoggerRegistry::defaultRegistry().registerSink("AsyncSinkTest.BatchSink", batchSink);
+
+    sink::Options options;
+    options.add("sinks", sink::Options::Array { "AsyncSinkTest.BatchSink" });
+    options.add("queue", sink::Options::Dict { { "type", "bounded" }, { "size", "2048" }, { "batch_size", std::to_string(BatchSize) } });
+
+    auto configuredSink = std::make_shared<sink::AsyncSink>();
+    configuredSink->activateOptions(options);
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, configuredSink);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        logger->info(logpp::format("Test message {}", i));
+    }
+
+    gateSink->open();
+
+    auto entries = waitForEntries(Count, std::chrono::seconds(5));
+    ASSERT_EQ(entries.size(), Count);
+
+    configuredSink->stop();
+
+    ASSERT_EQ(*std::max_element(std::begin(batchSink->batchSizes), std::end(batchSink->batchSizes)), BatchSize);
+}
+
+TEST_F(AsyncSinkTest, should_format_in_parallel_and_write_in_order)
+{
+    static constexpr size_t Count         = 10'000;
+    static constexpr size_t BatchSize     = 8;
+    static constexpr size_t FormatThreads = 4;
+
+    auto textSink = std::make_shared<TextSink>();
+
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.size          = 2048;
+    queueOptions.batchSize     = BatchSize;
+    queueOptions.formatThreads = FormatThreads;
+
+    auto pipelinedSink = std::make_shared<sink::AsyncSink>(poller, textSink, queueOptions);
+    pipelinedSink->start();
+
+    auto logger = std::make_shared<Logger>("AsyncSinkTest", LogLevel::Debug, pipelinedSink);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        logger->info(logpp::format("Test message {}", i));
+    }
+
+    auto lines = textSink->waitForLines(Count, std::chrono::seconds(5));
+    ASSERT_EQ(lines.size(), Count);
+
+    for (size_t i = 0; i < Count; ++i)
+        ASSERT_EQ(lines[i], fmt::format("Test message {}", i));
+
+    pipelinedSink->stop();
+
+    ASSERT_LE(textSink->formatThreads.size(), FormatThreads);
+    ASSERT_EQ(textSink->writeThreads.size(), 1);
+}
+
+TEST_F(AsyncSinkTest, should_reject_format_threads_for_sink_that_cannot_format)
+{
+    sink::AsyncSink::QueueOptions queueOptions;
+    queueOptions.formatThreads = 2;
+
+    ASSERT_THROW(std::make_shared<sink::AsyncSink>(poller, memorySink, queueOptions), sink::ConfigurationError);
+}
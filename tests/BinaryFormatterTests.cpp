@@ -0,0 +1,217 @@
+#include "logpp/format/BinaryDecoder.h"
+#include "logpp/format/BinaryFormatter.h"
+#include "logpp/format/JsonFormatter.h"
+#include "logpp/format/PatternFormatter.h"
+#include "logpp/sinks/file/BinaryFileSink.h"
+
+#include "logpp/core/Logger.h"
+
+#include "TemporaryFile.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+using namespace logpp;
+
+namespace
+{
+    struct Event
+    {
+        std::string name;
+        LogLevel level;
+        EventLogBuffer buffer;
+    };
+
+    std::vector<std::string> formatEvents(const std::vector<Event>& events, Formatter& formatter)
+    {
+        std::vector<std::string> lines;
+        for (const auto& event : events)
+        {
+            fmt::memory_buffer out;
+            formatter.format(event.name, event.level, event.buffer, out);
+            lines.emplace_back(out.data(), out.size());
+        }
+        return lines;
+    }
+
+    std::vector<std::string> decodeEvents(const char* data, size_t size, Formatter& formatter)
+    {
+        std::vector<std::string> lines;
+
+        BinaryDecoder decoder;
+        auto decoded = decoder.decode(data, size, [&](std::string_view name, LogLevel level, const EventLogBuffer& buffer) {
+            fmt::memory_buffer out;
+            formatter.format(name, level, buffer, out);
+            lines.emplace_back(out.data(), out.size());
+        });
+
+        EXPECT_EQ(decoded, size);
+        return lines;
+    }
+
+    std::vector<Event> createEvents()
+    {
+        std::vector<Event> events(4);
+
+        events[0].name  = "BinaryTest";
+        events[0].level = LogLevel::Info;
+        events[0].buffer.writeTime(Clock::now());
+        events[0].buffer.writeText(logpp::format("Test {} of {} ({}, {}, {})", std::string("encoding"), 42u, -1, true, 0.5));
+        events[0].buffer.writeSourceLocation(SourceLocation { "BinaryFormatterTests.cpp", 42 });
+        events[0].buffer.writeFields(
+            logpp::field("test_name", "should_roundtrip"),
+            logpp::field("count", 3),
+            logpp::field("ratio", 1.5f),
+            logpp::field("letter", 'x'));
+
+        events[1].name  = "BinaryTest.Raw";
+        events[1].level = LogLevel::Warning;
+        events[1].buffer.writeTime(Clock::now());
+        events[1].buffer.writeText("Raw text");
+
+        events[2].name  = "BinaryTest";
+        events[2].level = LogLevel::Error;
+        events[2].buffer.writeTime(Clock::now());
+        events[2].buffer.writeFields(logpp::field("test_name", "no_text"));
+
+        events[3].name  = "BinaryTest";
+        events[3].level = LogLevel::Debug;
+        events[3].buffer.writeTime(Clock::now());
+        events[3].buffer.writeText(logpp::format("Test {} of {} ({}, {}, {})", std::string("decoding"), 43u, -2, false, 0.25));
+
+        return events;
+    }
+
+    std::string encode(const std::vector<Event>& events, BinaryFormatter& formatter)
+    {
+        fmt::memory_buffer out;
+        for (const auto& event : events)
+            formatter.format(event.name, event.level, event.buffer, out);
+        return std::string(out.data(), out.size());
+    }
+
+    size_t count(const std::string& str, std::string_view needle)
+    {
+        size_t n = 0;
+        for (auto pos = str.find(needle); pos != std::string::npos; pos = str.find(needle, pos + 1))
+            ++n;
+        return n;
+    }
+}
+
+TEST(BinaryFormatterTest, should_decode_events_as_formatted)
+{
+    auto events = createEvents();
+
+    BinaryFormatter formatter;
+    auto data = encode(events, formatter);
+
+    PatternFormatter pattern("%Y-%m-%d %H:%M:%S.%u [%l] (%n) %t %p:%o %v - %f");
+    ASSERT_EQ(decodeEvents(data.data(), data.size(), pattern), formatEvents(events, pattern));
+
+    JsonFormatter json;
+    ASSERT_EQ(decodeEvents(data.data(), data.size(), json), formatEvents(events, json));
+}
+
+TEST(BinaryFormatterTest, should_write_strings_once)
+{
+    auto events = createEvents();
+
+    BinaryFormatter formatter;
+    auto data = encode(events, formatter);
+
+    std::string_view magic(binary::Magic, sizeof(binary::Magic));
+    ASSERT_EQ(count(data, "Test {} of {}"), 1);
+    ASSERT_EQ(count(data, "test_name"), 1);
+    ASSERT_EQ(count(data, magic), 1);
+
+    formatter.reset();
+    data += encode(events, formatter);
+
+    ASSERT_EQ(count(data, "Test {} of {}"), 2);
+    ASSERT_EQ(count(data, magic), 2);
+
+    PatternFormatter pattern("%v - %f");
+    auto lines = formatEvents(events, pattern);
+    auto twice = lines;
+    lines.insert(lines.end(), twice.begin(), twice.end());
+
+    ASSERT_EQ(decodeEvents(data.data(), data.size(), pattern), lines);
+}
+
+TEST(BinaryFormatterTest, should_not_decode_partial_records)
+{
+    auto events = createEvents();
+
+    BinaryFormatter formatter;
+    auto data = encode(events, formatter);
+
+    PatternFormatter pattern("%v - %f");
+
+    std::vector<std::string> lines;
+    auto onEvent = [&](std::string_view name, LogLevel level, const EventLogBuffer& buffer) {
+        fmt::memory_buffer out;
+        pattern.format(name, level, buffer, out);
+        lines.emplace_back(out.data(), out.size());
+    };
+
+    // Feed the data byte by byte, keeping what has not been decoded yet
+    BinaryDecoder decoder;
+    std::string pending;
+    for (char c : data)
+    {
+        pending.push_back(c);
+        auto decoded = decoder.decode(pending.data(), pending.size(), onEvent);
+        pending.erase(0, decoded);
+    }
+
+    ASSERT_TRUE(pending.empty());
+    ASSERT_EQ(lines, formatEvents(events, pattern));
+}
+
+TEST(BinaryFormatterTest, should_throw_on_invalid_data)
+{
+    auto onEvent = [](std::string_view, LogLevel, const EventLogBuffer&) {};
+
+    std::string text = "2021-01-08 15:20:10 [info] This is not a binary log\n";
+    ASSERT_THROW(BinaryDecoder().decode(text.data(), text.size(), onEvent), BinaryFormatError);
+
+    auto events = createEvents();
+
+    BinaryFormatter formatter;
+    auto data = encode(events, formatter);
+
+    // Corrupt the size of the first string record so that its id is read past the record
+    auto stringIndex = binary::RecordHeaderSize + sizeof(binary::Magic) + sizeof(binary::Version);
+    binary::encodeLE(data.data() + stringIndex + sizeof(uint8_t), uint32_t { 1 });
+    ASSERT_THROW(BinaryDecoder().decode(data.data(), data.size(), onEvent), BinaryFormatError);
+}
+
+TEST(BinaryFileSinkTest, should_write_decodable_file)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.bin", directory);
+    auto events   = createEvents();
+
+    for (size_t run = 0; run < 2; ++run)
+    {
+        sink::BinaryFileSink sink(filePath);
+        for (const auto& event : events)
+            sink.sink(event.name, event.level, event.buffer);
+        sink.close();
+    }
+
+    std::ifstream ifs(filePath, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    PatternFormatter pattern("%l %n %v - %f");
+    auto lines = formatEvents(events, pattern);
+    auto twice = lines;
+    lines.insert(lines.end(), twice.begin(), twice.end());
+
+    ASSERT_EQ(decodeEvents(data.data(), data.size(), pattern), lines);
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+
+#include "logpp/queue/ByteRingBuffer.h"
+
+#include <thread>
+#include <vector>
+
+using namespace logpp;
+
+namespace
+{
+    template <typename Ring>
+    bool writeValue(Ring& ring, uint64_t value)
+    {
+        return ring.tryWrite(sizeof(value), [&](char* dest) {
+            std::memcpy(dest, &value, sizeof(value));
+        });
+    }
+
+    template <typename Ring>
+    std::vector<uint64_t> readValues(Ring& ring)
+    {
+        std::vector<uint64_t> values;
+        ring.read([&](const char* data, size_t) {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            values.push_back(value);
+        });
+        return values;
+    }
+}
+
+TEST(ByteRingBuffer, should_read_records_in_write_order)
+{
+    ByteRingBuffer<true> ring(4096);
+
+    for (uint64_t i = 0; i < 10; ++i)
+        ASSERT_TRUE(writeValue(ring, i));
+
+    auto values = readValues(ring);
+    ASSERT_EQ(values.size(), 10);
+    for (uint64_t i = 0; i < 10; ++i)
+        ASSERT_EQ(values[i], i);
+
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(ByteRingBuffer, should_fail_to_write_when_full)
+{
+    ByteRingBuffer<false> ring(4096);
+
+    size_t count = 0;
+    while (writeValue(ring, count))
+        ++count;
+
+    // Every record takes 8 bytes of header and 8 bytes of payload
+    ASSERT_EQ(count, ring.capacity() / 16);
+
+    readValues(ring);
+    ASSERT_TRUE(writeValue(ring, 0));
+}
+
+TEST(ByteRingBuffer, should_reject_records_bigger_than_max_record_size)
+{
+    ByteRingBuffer<true> ring(4096);
+
+    ASSERT_FALSE(ring.tryWrite(ring.maxRecordSize() + 1, [](char*) {}));
+    ASSERT_TRUE(ring.tryWrite(ring.maxRecordSize(), [](char*) {}));
+}
+
+TEST(ByteRingBuffer, should_wrap_variable_length_records)
+{
+    ByteRingBuffer<false> ring(4096);
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        std::string str(i % 300, static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(ring.tryWrite(str.size(), [&](char* dest) {
+            std::memcpy(dest, str.data(), str.size());
+        }));
+
+        size_t count = ring.read([&](const char* data, size_t size) {
+            ASSERT_GE(size, str.size());
+            ASSERT_EQ(std::string_view(data, str.size()), str);
+        });
+        ASSERT_EQ(count, 1);
+    }
+}
+
+TEST(ByteRingBuffer, should_read_records_from_multiple_producers)
+{
+    static constexpr size_t Producers        = 4;
+    static constexpr uint64_t CountPerThread = 100'000;
+
+    ByteRingBuffer<true> ring(4096);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < Producers; ++p)
+    {
+        producers.emplace_back([&ring, p] {
+            for (uint64_t i = 0; i < CountPerThread; ++i)
+            {
+                uint64_t value = (p << 32) | i;
+                ring.write(sizeof(value), [&](char* dest) {
+                    std::memcpy(dest, &value, sizeof(value));
+                });
+            }
+        });
+    }
+
+    std::vector<uint64_t> nextValue(Producers, 0);
+    size_t total = 0;
+    while (total < Producers * CountPerThread)
+    {
+        for (auto value : readValues(ring))
+        {
+            auto producer = value >> 32;
+            ASSERT_EQ(value & 0xFFFFFFFF, nextValue[producer]);
+            ++nextValue[producer];
+            ++total;
+        }
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+}
@@ -0,0 +1,171 @@
+#include "logpp/logpp.h"
+
+#include "gtest/gtest.h"
+
+using namespace logpp;
+
+class TextSink : public sink::Sink
+{
+public:
+    void activateOptions(const sink::Options&) override
+    { }
+
+    void sink(std::string_view, LogLevel, const EventLogBuffer& buffer) override
+    {
+        fmt::memory_buffer text;
+        buffer.formatText(text);
+        texts.emplace_back(text.data(), text.size());
+    }
+
+    std::vector<std::string> texts;
+};
+
+// Sites are registered for the whole process and must thus have static storage duration
+CallSite serverSite { "src/net/Server.cpp", 42, LogLevel::Debug, "\"Request handled\"" };
+CallSite otherServerSite { "src/net/Server.cpp", 51, LogLevel::Debug, "\"Request failed\"" };
+CallSite clientSite { "src/net/Client.cpp", 42, LogLevel::Debug, "\"Request sent\"" };
+CallSite suffixSite { "src/net/HttpServer.cpp", 42, LogLevel::Debug, "\"Request handled\"" };
+
+static const size_t DebugLine = __LINE__ + 3;
+void logDebug(const std::shared_ptr<Logger>& logger, int index)
+{
+    LOGPP_LOGGER_LOG(logger, LOGPP_FORMAT("Debug message {}", index), LogLevel::Debug, LOGPP_FIELD("index", index));
+}
+
+static const size_t ErrorLine = __LINE__ + 3;
+void logError(const std::shared_ptr<Logger>& logger, int index)
+{
+    LOGPP_LOGGER_LOG(logger, LOGPP_FORMAT("Error message {}", index), LogLevel::Error, LOGPP_FIELD("index", index));
+}
+
+static const size_t TraceLine = __LINE__ + 3;
+void logTrace(int index)
+{
+    LOGPP_TRACE(LOGPP_FORMAT("Trace message {}", index), LOGPP_FIELD("index", index));
+}
+
+struct CallSiteTest : public ::testing::Test
+{
+    void SetUp() override
+    {
+        sink   = std::make_shared<TextSink>();
+        logger = std::make_shared<Logger>("CallSiteTest", LogLevel::Info, sink);
+
+        // Register the sites
+        for (auto* site : { &serverSite, &otherServerSite, &clientSite, &suffixSite })
+            site->state();
+    }
+
+    void TearDown() override
+    {
+        registry().clearRules();
+    }
+
+    static CallSiteRegistry& registry()
+    {
+        return CallSiteRegistry::instance();
+    }
+
+    std::shared_ptr<TextSink> sink;
+    std::shared_ptr<Logger> logger;
+};
+
+TEST_F(CallSiteTest, should_follow_logger_level_by_default)
+{
+    ASSERT_EQ(serverSite.state(), CallSiteState::Default);
+
+    logDebug(logger, 1);
+    logError(logger, 2);
+    ASSERT_EQ(sink->texts, (std::vector<std::string> { "Error message 2" }));
+}
+
+TEST_F(CallSiteTest, should_match_whole_path_components)
+{
+    ASSERT_EQ(registry().enable("Server.cpp"), 2);
+    ASSERT_EQ(serverSite.state(), CallSiteState::Enabled);
+    ASSERT_EQ(otherServerSite.state(), CallSiteState::Enabled);
+    ASSERT_EQ(clientSite.state(), CallSiteState::Default);
+    ASSERT_EQ(suffixSite.state(), CallSiteState::Default);
+
+    ASSERT_EQ(registry().enable("net/Server.cpp", 42), 1);
+    ASSERT_EQ(registry().enable("src/net/Client.cpp"), 1);
+    ASSERT_EQ(registry().enable("et/Client.cpp"), 0);
+}
+
+TEST_F(CallSiteTest, should_prefer_line_rules_over_file_rules)
+{
+    registry().disable("Server.cpp", 42);
+    registry().enable("Server.cpp");
+
+    ASSERT_EQ(serverSite.state(), CallSiteState::Disabled);
+    ASSERT_EQ(otherServerSite.state(), CallSiteState::Enabled);
+
+    ASSERT_TRUE(registry().removeRule("Server.cpp", 42));
+    ASSERT_FALSE(registry().removeRule("Server.cpp", 42));
+    ASSERT_EQ(serverSite.state(), CallSiteState::Enabled);
+
+    registry().clearRules();
+    ASSERT_EQ(serverSite.state(), CallSiteState::Default);
+    ASSERT_TRUE(registry().rules().empty());
+}
+
+TEST_F(CallSiteTest, should_replace_rule_for_same_site)
+{
+    registry().enable("Server.cpp", 42);
+    registry().disable("Server.cpp", 42);
+
+    ASSERT_EQ(registry().rules().size(), 1);
+    ASSERT_EQ(serverSite.state(), CallSiteState::Disabled);
+}
+
+TEST_F(CallSiteTest, should_log_enabled_site_below_logger_level)
+{
+    registry().enable("CallSiteTests.cpp", DebugLine);
+
+    logDebug(logger, 1);
+    ASSERT_EQ(sink->texts, (std::vector<std::string> { "Debug message 1" }));
+}
+
+TEST_F(CallSiteTest, should_not_log_disabled_site)
+{
+    registry().disable("CallSiteTests.cpp", ErrorLine);
+
+    logError(logger, 1);
+    ASSERT_TRUE(sink->texts.empty());
+}
+
+TEST_F(CallSiteTest, should_apply_rules_to_sites_registered_afterwards)
+{
+    static CallSite lateSite { "src/Late.cpp", 10, LogLevel::Trace, "\"Late\"" };
+
+    registry().enable("Late.cpp");
+    ASSERT_EQ(lateSite.state(), CallSiteState::Enabled);
+}
+
+TEST_F(CallSiteTest, should_list_registered_sites)
+{
+    logDebug(logger, 1);
+
+    std::vector<const CallSite*> sites;
+    registry().forEachSite([&](const CallSite& site) {
+        if (site.line() == DebugLine && site.text() == "LOGPP_FORMAT(\"Debug message {}\", index)")
+            sites.push_back(&site);
+    });
+
+    ASSERT_EQ(sites.size(), 1);
+    ASSERT_EQ(sites[0]->level(), LogLevel::Debug);
+}
+
+TEST_F(CallSiteTest, should_keep_text_of_statement_as_written_with_level_macros)
+{
+    logTrace(1);
+
+    std::vector<const CallSite*> sites;
+    registry().forEachSite([&](const CallSite& site) {
+        if (site.line() == TraceLine && site.file() == __FILE__)
+            sites.push_back(&site);
+    });
+
+    ASSERT_EQ(sites.size(), 1);
+    ASSERT_EQ(sites[0]->text(), "LOGPP_FORMAT(\"Trace message {}\", index)");
+}
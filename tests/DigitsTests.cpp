@@ -0,0 +1,58 @@
+#include "gtest/gtest.h"
+
+#include "logpp/format/Digits.h"
+
+#include <limits>
+
+using namespace logpp;
+
+namespace
+{
+    template <typename Func>
+    std::string write(Func&& func)
+    {
+        fmt::memory_buffer out;
+        func(out);
+        return fmt::to_string(out);
+    }
+}
+
+TEST(DigitsTests, should_append_padded_integers)
+{
+    for (int value : { 0, 7, 10, 42, 99, 100, 999, 1000, 2021, 9999, 10000, 123456 })
+    {
+        ASSERT_EQ(write([&](auto& out) { digits::appendPadded<2>(out, value); }), fmt::format("{:02}", value));
+        ASSERT_EQ(write([&](auto& out) { digits::appendPadded<3>(out, value); }), fmt::format("{:03}", value));
+        ASSERT_EQ(write([&](auto& out) { digits::appendPadded<4>(out, value); }), fmt::format("{:04}", value));
+        ASSERT_EQ(write([&](auto& out) { digits::appendPadded<4>(out, static_cast<unsigned>(value)); }), fmt::format("{:04}", value));
+    }
+
+    ASSERT_EQ(write([](auto& out) { digits::appendPadded<4>(out, -12); }), fmt::format("{:04}", -12));
+    ASSERT_EQ(write([](auto& out) { digits::appendPadded<2>(out, int64_t { 59 }); }), "59");
+}
+
+TEST(DigitsTests, should_append_decimal_integers)
+{
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, 0u); }), "0");
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, uint8_t { 9 }); }), "9");
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, uint16_t { 42 }); }), "42");
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, 4242u); }), "4242");
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, int8_t { -8 }); }), "-8");
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, std::numeric_limits<int64_t>::min()); }),
+              fmt::format("{}", std::numeric_limits<int64_t>::min()));
+    ASSERT_EQ(write([](auto& out) { digits::appendDecimal(out, std::numeric_limits<uint64_t>::max()); }),
+              fmt::format("{}", std::numeric_limits<uint64_t>::max()));
+}
+
+TEST(DigitsTests, should_append_thread_ids)
+{
+    // Ids that map to the same cache entry
+    auto first  = static_cast<thread_utils::id>(1234);
+    auto second = static_cast<thread_utils::id>(1234 + 16);
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(write([&](auto& out) { digits::appendThreadId(out, first); }), "1234");
+        ASSERT_EQ(write([&](auto& out) { digits::appendThreadId(out, second); }), "1250");
+    }
+}
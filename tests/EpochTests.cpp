@@ -0,0 +1,241 @@
+#include "gtest/gtest.h"
+
+#include "logpp/core/Epoch.h"
+#include "logpp/core/Logger.h"
+
+#include "logpp/sinks/Sink.h"
+
+#include <condition_variable>
+#include <thread>
+
+using namespace logpp;
+
+namespace
+{
+    // Sets a flag when destroyed
+    struct Tracked
+    {
+        explicit Tracked(std::atomic<bool>& destroyed)
+            : destroyed(destroyed)
+        { }
+
+        ~Tracked()
+        {
+            destroyed.store(true);
+        }
+
+        std::atomic<bool>& destroyed;
+    };
+
+    class CountingSink : public sink::Sink
+    {
+    public:
+        explicit CountingSink(std::atomic<bool>* destroyed = nullptr)
+            : m_destroyed(destroyed)
+        { }
+
+        ~CountingSink() override
+        {
+            if (m_destroyed)
+                m_destroyed->store(true);
+        }
+
+        void activateOptions(const sink::Options&) override { }
+
+        void sink(std::string_view, LogLevel, const EventLogBuffer&) override
+        {
+            m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        size_t count() const
+        {
+            return m_count.load();
+        }
+
+    private:
+        std::atomic<bool>* m_destroyed;
+        std::atomic<size_t> m_count { 0 };
+    };
+
+    // Blocks the thread sinking an event until it is opened
+    class GateSink : public sink::Sink
+    {
+    public:
+        explicit GateSink(std::atomic<bool>& destroyed)
+            : m_destroyed(destroyed)
+        { }
+
+        ~GateSink() override
+        {
+            m_destroyed.store(true);
+        }
+
+        void activateOptions(const sink::Options&) override { }
+
+        void sink(std::string_view, LogLevel, const EventLogBuffer&) override
+        {
+            std::unique_lock lock(m_mutex);
+            m_entered = true;
+            m_cv.notify_all();
+            m_cv.wait(lock, [&] { return m_open; });
+        }
+
+        void waitEntered()
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [&] { return m_entered; });
+        }
+
+        void open()
+        {
+            std::lock_guard guard(m_mutex);
+            m_open = true;
+            m_cv.notify_all();
+        }
+
+    private:
+        std::atomic<bool>& m_destroyed;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_entered { false };
+        bool m_open { false };
+    };
+}
+
+TEST(EpochTest, should_destroy_retired_object_when_no_reader_is_active)
+{
+    std::atomic<bool> destroyed { false };
+    Epoch::retire(std::make_shared<Tracked>(destroyed));
+
+    ASSERT_TRUE(destroyed.load());
+}
+
+TEST(EpochTest, should_defer_destruction_until_readers_leave)
+{
+    std::atomic<bool> destroyed { false };
+    std::atomic<bool> entered { false };
+    std::atomic<bool> leave { false };
+
+    std::thread reader([&] {
+        Epoch::Guard guard;
+        entered.store(true);
+        while (!leave.load())
+            std::this_thread::yield();
+    });
+
+    while (!entered.load())
+        std::this_thread::yield();
+
+    Epoch::retire(std::make_shared<Tracked>(destroyed));
+    ASSERT_FALSE(destroyed.load());
+    ASSERT_EQ(Epoch::reclaim(), 1);
+
+    leave.store(true);
+    reader.join();
+
+    Epoch::synchronize();
+    ASSERT_TRUE(destroyed.load());
+}
+
+TEST(EpochTest, should_defer_destruction_when_retired_inside_a_guard)
+{
+    std::atomic<bool> destroyed { false };
+
+    {
+        Epoch::Guard guard;
+        Epoch::Guard nested;
+
+        // Retiring from inside a guard keeps the object alive until the guard is left
+        Epoch::retire(std::make_shared<Tracked>(destroyed));
+        ASSERT_FALSE(destroyed.load());
+    }
+
+    Epoch::synchronize();
+    ASSERT_TRUE(destroyed.load());
+}
+
+TEST(EpochTest, should_keep_replaced_sink_alive_while_an_event_is_being_sunk)
+{
+    std::atomic<bool> destroyed { false };
+    auto gate   = std::make_shared<GateSink>(destroyed);
+    auto logger = std::make_shared<Logger>("test", LogLevel::Info, gate);
+
+    std::thread writer([&] {
+        logger->info("blocked");
+    });
+
+    gate->waitEntered();
+
+    auto* blocked = gate.get();
+    gate.reset();
+
+    logger->setSink(std::make_shared<CountingSink>());
+    ASSERT_FALSE(destroyed.load());
+
+    blocked->open();
+    writer.join();
+
+    Epoch::synchronize();
+    ASSERT_TRUE(destroyed.load());
+}
+
+TEST(EpochTest, should_destroy_replaced_sink_when_the_last_reader_leaves)
+{
+    std::atomic<bool> destroyed { false };
+    auto gate   = std::make_shared<GateSink>(destroyed);
+    auto logger = std::make_shared<Logger>("test", LogLevel::Info, gate);
+
+    std::thread writer([&] {
+        logger->info("blocked");
+    });
+
+    gate->waitEntered();
+
+    auto* blocked = gate.get();
+    gate.reset();
+
+    logger->setSink(std::make_shared<CountingSink>());
+    ASSERT_FALSE(destroyed.load());
+
+    // Nothing is retired or reclaimed anymore, the writer leaving its guard destroys the sink
+    blocked->open();
+    writer.join();
+
+    ASSERT_TRUE(destroyed.load());
+}
+
+TEST(EpochTest, should_swap_sinks_while_logging)
+{
+    // Outlives the logger, the last sink is destroyed with it
+    std::vector<std::unique_ptr<std::atomic<bool>>> destroyed;
+
+    auto logger = std::make_shared<Logger>("test", LogLevel::Info, std::make_shared<CountingSink>());
+
+    std::atomic<bool> stop { false };
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 4; ++i)
+    {
+        writers.emplace_back([&] {
+            while (!stop.load())
+                logger->info("event");
+        });
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        destroyed.push_back(std::make_unique<std::atomic<bool>>(false));
+        logger->setSink(std::make_shared<CountingSink>(destroyed.back().get()));
+    }
+
+    stop.store(true);
+    for (auto& writer : writers)
+        writer.join();
+
+    Epoch::synchronize();
+
+    // Every replaced sink has been destroyed, the current one is still alive
+    for (size_t i = 0; i + 1 < destroyed.size(); ++i)
+        ASSERT_TRUE(destroyed[i]->load());
+    ASSERT_FALSE(destroyed.back()->load());
+}
@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+
+#include "logpp/core/EventLogBufferPool.h"
+
+#include <thread>
+
+using namespace logpp;
+
+TEST(EventLogBufferPool, should_reuse_released_buffer_on_same_thread)
+{
+    auto* node = EventLogBufferPool::acquire();
+    EventLogBufferPool::release(node);
+
+    auto* other = EventLogBufferPool::acquire();
+    ASSERT_EQ(node, other);
+
+    EventLogBufferPool::release(other);
+}
+
+TEST(EventLogBufferPool, should_acquire_empty_buffer)
+{
+    std::string text(1024, 'A');
+
+    auto* node = EventLogBufferPool::acquire();
+    auto emptySize = node->buffer().size();
+
+    node->buffer().writeText(text);
+    ASSERT_GT(node->buffer().size(), text.size());
+
+    EventLogBufferPool::release(node);
+
+    auto* other = EventLogBufferPool::acquire();
+    ASSERT_EQ(other->buffer().size(), emptySize);
+
+    fmt::memory_buffer formatBuf;
+    other->buffer().formatText(formatBuf);
+    ASSERT_EQ(formatBuf.size(), 0);
+
+    EventLogBufferPool::release(other);
+}
+
+TEST(EventLogBufferPool, should_return_buffer_released_from_another_thread_to_its_owner)
+{
+    auto* node = EventLogBufferPool::acquire();
+    node->buffer().writeText("Released from another thread");
+
+    std::thread thread([&] {
+        EventLogBufferPool::release(node);
+    });
+    thread.join();
+
+    auto* other = EventLogBufferPool::acquire();
+    ASSERT_EQ(node, other);
+
+    EventLogBufferPool::release(other);
+}
+
+TEST(EventLogBufferPool, should_release_buffer_after_owner_thread_exited)
+{
+    EventLogBufferPool::Node* node = nullptr;
+
+    std::thread thread([&] {
+        node = EventLogBufferPool::acquire();
+        node->buffer().writeText("Owner thread exited");
+    });
+    thread.join();
+
+    fmt::memory_buffer formatBuf;
+    node->buffer().formatText(formatBuf);
+    ASSERT_EQ(std::string_view(formatBuf.data(), formatBuf.size()), "Owner thread exited");
+
+    EventLogBufferPool::release(node);
+}
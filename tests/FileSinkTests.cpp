@@ -1,13 +1,27 @@
 #include "gtest/gtest.h"
 
+#include "logpp/core/Logger.h"
+#include "logpp/sinks/AsyncSink.h"
 #include "logpp/sinks/file/FileSink.h"
 #include "logpp/utils/file.h"
 
 #include "TemporaryFile.h"
 
+#include <fstream>
+#include <thread>
+
 using namespace logpp;
 using namespace logpp::sink;
 
+namespace
+{
+    std::string readFile(const std::string& filePath)
+    {
+        std::ifstream ifs(filePath);
+        return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+}
+
 TEST(FileSink, should_raise_configuration_error_when_missing_file_option)
 {
     auto sink = std::make_shared<FileSink>();
@@ -33,3 +47,115 @@ TEST(FileSink, should_create_directory_if_does_not_exist)
     ASSERT_NO_THROW(sink->activateOptions(options));
     ASSERT_TRUE(file_utils::exists(filePath));
 }
+
+TEST(FileSink, should_write_batch)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+    auto sink     = std::make_shared<FileSink>(filePath, std::make_shared<PatternFormatter>("%v"));
+
+    EventLogBuffer first;
+    first.writeText("First");
+
+    EventLogBuffer second;
+    second.writeText("Second");
+
+    EventRecord records[] = {
+        { "FileSinkTest", LogLevel::Info, &first },
+        { "FileSinkTest", LogLevel::Info, &second }
+    };
+
+    sink->sinkBatch(Span<const EventRecord>(records, std::size(records)));
+    sink->close();
+
+    ASSERT_EQ(readFile(filePath), "First\nSecond\n");
+}
+
+TEST(FileSink, should_buffer_until_flushed)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+    auto sink     = std::make_shared<FileSink>(filePath, std::make_shared<PatternFormatter>("%v"));
+
+    FlushPolicy policy;
+    policy.interval = std::chrono::milliseconds(0);
+    sink->setFlushPolicy(policy);
+
+    EventLogBuffer buffer;
+    buffer.writeText("Buffered");
+
+    sink->sink("FileSinkTest", LogLevel::Info, buffer);
+    ASSERT_EQ(readFile(filePath), "");
+
+    sink->flush();
+    ASSERT_EQ(readFile(filePath), "Buffered\n");
+}
+
+TEST(FileSink, should_flush_according_to_policy)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+    auto sink     = std::make_shared<FileSink>(filePath, std::make_shared<PatternFormatter>("%v"));
+
+    FlushPolicy policy;
+    policy.bytes    = 16;
+    policy.interval = std::chrono::milliseconds(0);
+    policy.level    = LogLevel::Error;
+    sink->setFlushPolicy(policy);
+
+    EventLogBuffer buffer;
+    buffer.writeText("Message");
+
+    sink->sink("FileSinkTest", LogLevel::Info, buffer);
+    ASSERT_EQ(readFile(filePath), "");
+
+    sink->sink("FileSinkTest", LogLevel::Info, buffer);
+    ASSERT_EQ(readFile(filePath), "Message\nMessage\n");
+
+    sink->sink("FileSinkTest", LogLevel::Error, buffer);
+    ASSERT_EQ(readFile(filePath), "Message\nMessage\nMessage\n");
+}
+
+TEST(FileSink, should_flush_idle_file_behind_async_sink)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+    auto sink     = std::make_shared<FileSink>(filePath, std::make_shared<PatternFormatter>("%v"));
+
+    FlushPolicy policy;
+    policy.interval = std::chrono::milliseconds(50);
+    sink->setFlushPolicy(policy);
+
+    AsyncQueuePoller::Options options;
+    options.waitStrategy    = AsyncQueuePoller::WaitStrategy::Blocking;
+    options.maxParkDuration = std::chrono::milliseconds(10);
+
+    auto poller    = AsyncQueuePoller::create(options);
+    auto asyncSink = std::make_shared<AsyncSink>(poller, sink);
+    poller->start();
+    asyncSink->start();
+
+    Logger logger("FileSinkTest", LogLevel::Info, asyncSink);
+    logger.info("Idle");
+
+    // No other event is logged, the poller flushes the file once the interval elapsed
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (readFile(filePath).empty() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    ASSERT_EQ(readFile(filePath), "Idle\n");
+
+    asyncSink->stop();
+}
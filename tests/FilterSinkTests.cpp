@@ -0,0 +1,351 @@
+#include "gtest/gtest.h"
+
+#include "logpp/core/LoggerRegistry.h"
+
+#include "logpp/sinks/DedupSink.h"
+#include "logpp/sinks/RateLimitSink.h"
+#include "logpp/sinks/SampleSink.h"
+
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+using namespace logpp;
+
+class RecordSink : public sink::Sink
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        LogLevel level;
+        std::string text;
+    };
+
+    void activateOptions(const sink::Options&) override { }
+
+    void sink(std::string_view name, LogLevel level, const EventLogBuffer& buffer) override
+    {
+        fmt::memory_buffer text;
+        buffer.formatText(text);
+
+        std::lock_guard guard(m_mutex);
+        m_entries.push_back(Entry { std::string(name), level, fmt::to_string(text) });
+    }
+
+    void sinkBatch(Span<const logpp::sink::EventRecord> records) override
+    {
+        ++m_batches;
+        logpp::sink::Sink::sinkBatch(records);
+    }
+
+    std::vector<Entry> entries() const
+    {
+        std::lock_guard guard(m_mutex);
+        return m_entries;
+    }
+
+    std::vector<std::string> texts() const
+    {
+        std::vector<std::string> texts;
+        for (const auto& entry : entries())
+            texts.push_back(entry.text);
+
+        return texts;
+    }
+
+    size_t batches() const
+    {
+        return m_batches;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+    size_t m_batches { 0 };
+};
+
+namespace
+{
+    EventLogBuffer event(std::string_view text, TimePoint time = TimePoint {})
+    {
+        EventLogBuffer buffer;
+        buffer.writeTime(time);
+        buffer.writeText(text);
+        return buffer;
+    }
+
+    TimePoint at(std::chrono::milliseconds ms)
+    {
+        return TimePoint(std::chrono::duration_cast<TimePoint::duration>(ms));
+    }
+
+    void log(sink::Sink& sink, std::string_view text, TimePoint time = TimePoint {},
+             std::string_view name = "test", LogLevel level = LogLevel::Info)
+    {
+        auto buffer = event(text, time);
+        sink.sink(name, level, buffer);
+    }
+}
+
+TEST(RateLimitSinkTest, should_let_bursts_through_and_drop_the_rest)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::RateLimitSink sink(inner, { 10, std::chrono::seconds(1), 3 });
+
+    for (int i = 0; i < 5; ++i)
+        log(sink, fmt::format("event {}", i));
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "event 0", "event 1", "event 2" }));
+    ASSERT_EQ(sink.droppedCount(), 2);
+}
+
+TEST(RateLimitSinkTest, should_refill_over_time_and_report_suppressed_events)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::RateLimitSink sink(inner, { 10, std::chrono::seconds(1), 1 });
+
+    log(sink, "first", at(std::chrono::milliseconds(0)));
+    log(sink, "dropped", at(std::chrono::milliseconds(50)));
+    log(sink, "dropped", at(std::chrono::milliseconds(80)));
+    log(sink, "second", at(std::chrono::milliseconds(100)));
+
+    auto entries = inner->entries();
+    ASSERT_EQ(entries.size(), 3);
+    ASSERT_EQ(entries[0].text, "first");
+    ASSERT_EQ(entries[1].text, "2 events suppressed by rate limit");
+    ASSERT_EQ(entries[1].level, LogLevel::Warning);
+    ASSERT_EQ(entries[2].text, "second");
+}
+
+TEST(RateLimitSinkTest, should_keep_a_budget_per_logger)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::RateLimitSink sink(inner, { 1, std::chrono::seconds(1), 1 }, sink::RateLimitSink::Key::Logger);
+
+    log(sink, "first", {}, "a");
+    log(sink, "second", {}, "a");
+    log(sink, "third", {}, "b");
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "first", "third" }));
+}
+
+TEST(RateLimitSinkTest, should_keep_a_budget_per_call_site)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::RateLimitSink sink(inner, { 1, std::chrono::seconds(1), 1 }, sink::RateLimitSink::Key::CallSite);
+
+    for (size_t line : { 10, 10, 20 })
+    {
+        auto buffer = event(fmt::format("line {}", line));
+        buffer.writeSourceLocation(SourceLocation { __FILE__, line });
+        sink.sink("test", LogLevel::Info, buffer);
+    }
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "line 10", "line 20" }));
+}
+
+TEST(RateLimitSinkTest, should_report_suppressed_events_in_order_within_a_batch)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::RateLimitSink sink(inner, { 10, std::chrono::seconds(1), 1 });
+
+    std::vector<EventLogBuffer> buffers;
+    buffers.push_back(event("first", at(std::chrono::milliseconds(0))));
+    buffers.push_back(event("dropped", at(std::chrono::milliseconds(10))));
+    buffers.push_back(event("second", at(std::chrono::milliseconds(100))));
+    buffers.push_back(event("third", at(std::chrono::milliseconds(200))));
+
+    std::vector<sink::EventRecord> records;
+    for (const auto& buffer : buffers)
+        records.push_back(sink::EventRecord { "test", LogLevel::Info, &buffer });
+
+    sink.sinkBatch(records);
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "first", "1 events suppressed by rate limit", "second", "third" }));
+}
+
+TEST(RateLimitSinkTest, should_not_let_more_than_the_burst_through_concurrently)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::RateLimitSink sink(inner, { 100, std::chrono::seconds(1), 100 }, sink::RateLimitSink::Key::Global);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 1000; ++j)
+                log(sink, "event");
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(inner->entries().size(), 100);
+    ASSERT_EQ(sink.droppedCount(), 8 * 1000 - 100);
+}
+
+TEST(SampleSinkTest, should_let_one_event_out_of_every_through)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::SampleSink sink(inner, sink::SampleEvery { 10 });
+
+    for (int i = 0; i < 100; ++i)
+        log(sink, fmt::format("event {}", i));
+
+    auto texts = inner->texts();
+    ASSERT_EQ(texts.size(), 10);
+    ASSERT_EQ(texts[0], "event 0");
+    ASSERT_EQ(texts[1], "event 10");
+}
+
+TEST(SampleSinkTest, should_sample_with_a_probability)
+{
+    auto none = std::make_shared<RecordSink>();
+    auto all  = std::make_shared<RecordSink>();
+    auto half = std::make_shared<RecordSink>();
+
+    sink::SampleSink noneSink(none, sink::SampleProbability { 0.0 });
+    sink::SampleSink allSink(all, sink::SampleProbability { 1.0 });
+    sink::SampleSink halfSink(half, sink::SampleProbability { 0.5 });
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        log(noneSink, "event");
+        log(allSink, "event");
+        log(halfSink, "event");
+    }
+
+    ASSERT_EQ(none->entries().size(), 0);
+    ASSERT_EQ(all->entries().size(), 10000);
+    ASSERT_GT(half->entries().size(), 4000);
+    ASSERT_LT(half->entries().size(), 6000);
+}
+
+TEST(SampleSinkTest, should_let_everything_through_with_a_probability_just_below_one)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::SampleSink sink(inner, sink::SampleProbability { std::nextafter(1.0, 0.0) });
+
+    for (int i = 0; i < 10000; ++i)
+        log(sink, "event");
+
+    ASSERT_EQ(inner->entries().size(), 10000);
+}
+
+TEST(SampleSinkTest, should_forward_the_sampled_events_as_a_single_batch)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::SampleSink sink(inner, sink::SampleEvery { 2 });
+
+    std::vector<EventLogBuffer> buffers;
+    for (int i = 0; i < 6; ++i)
+        buffers.push_back(event(fmt::format("event {}", i)));
+
+    std::vector<sink::EventRecord> records;
+    for (const auto& buffer : buffers)
+        records.push_back(sink::EventRecord { "test", LogLevel::Info, &buffer });
+
+    sink.sinkBatch(records);
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "event 0", "event 2", "event 4" }));
+    ASSERT_EQ(inner->batches(), 1);
+}
+
+TEST(DedupSinkTest, should_collapse_identical_consecutive_events)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::DedupSink sink(inner);
+
+    log(sink, "connection lost", {}, "net", LogLevel::Error);
+    log(sink, "connection lost", {}, "net", LogLevel::Error);
+    log(sink, "connection lost", {}, "net", LogLevel::Error);
+    log(sink, "connection restored", {}, "net", LogLevel::Info);
+
+    auto entries = inner->entries();
+    ASSERT_EQ(entries.size(), 3);
+    ASSERT_EQ(entries[0].text, "connection lost");
+    ASSERT_EQ(entries[1].text, "Last message repeated 2 times");
+    ASSERT_EQ(entries[1].level, LogLevel::Error);
+    ASSERT_EQ(entries[2].text, "connection restored");
+    ASSERT_EQ(sink.repeatedCount(), 2);
+}
+
+TEST(DedupSinkTest, should_compare_the_logger_and_the_level_of_events)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::DedupSink sink(inner);
+
+    log(sink, "event", {}, "a", LogLevel::Info);
+    log(sink, "event", {}, "b", LogLevel::Info);
+    log(sink, "event", {}, "b", LogLevel::Warning);
+    log(sink, "other", {}, "b", LogLevel::Warning);
+
+    ASSERT_EQ(inner->entries().size(), 4);
+    ASSERT_EQ(sink.repeatedCount(), 0);
+}
+
+TEST(DedupSinkTest, should_compare_formatted_text)
+{
+    auto inner = std::make_shared<RecordSink>();
+    sink::DedupSink sink(inner);
+
+    for (int i : { 1, 1, 2 })
+    {
+        EventLogBuffer buffer;
+        buffer.writeText(logpp::format("value {}", i));
+        sink.sink("test", LogLevel::Info, buffer);
+    }
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "value 1", "Last message repeated 1 times", "value 2" }));
+}
+
+TEST(FilterSinkTest, should_forward_to_the_sinks_of_the_registry)
+{
+    auto& registry = LoggerRegistry::defaultRegistry();
+
+    auto inner = std::make_shared<RecordSink>();
+    ASSERT_TRUE(registry.registerSink("filter_test_inner", inner));
+
+    auto sink = registry.createSink("Sample");
+    ASSERT_NE(sink, nullptr);
+
+    sink::Options options;
+    options.add("sinks", sink::Options::Array { "filter_test_inner" });
+    options.add("every", std::string("2"));
+    sink->activateOptions(options);
+
+    for (int i = 0; i < 4; ++i)
+        log(*sink, fmt::format("event {}", i));
+
+    ASSERT_EQ(inner->texts(), (std::vector<std::string> { "event 0", "event 2" }));
+}
+
+TEST(FilterSinkTest, should_raise_on_invalid_options)
+{
+    auto& registry = LoggerRegistry::defaultRegistry();
+    ASSERT_TRUE(registry.registerSink("filter_test_invalid", std::make_shared<RecordSink>()));
+
+    auto options = [](std::vector<std::pair<std::string, std::string>> values) {
+        sink::Options options;
+        options.add("sinks", sink::Options::Array { "filter_test_invalid" });
+        for (auto& [key, value] : values)
+            options.add(key, value);
+
+        return options;
+    };
+
+    ASSERT_THROW(registry.createSink("RateLimit")->activateOptions(options({})), sink::ConfigurationError);
+    ASSERT_THROW(registry.createSink("RateLimit")->activateOptions(options({ { "rate", "0" } })), sink::ConfigurationError);
+    ASSERT_THROW(registry.createSink("RateLimit")->activateOptions(options({ { "rate", "10" }, { "key", "thread" } })), sink::ConfigurationError);
+    ASSERT_NO_THROW(registry.createSink("RateLimit")->activateOptions(options({ { "rate", "10" }, { "period", "1m" }, { "key", "level" } })));
+
+    ASSERT_THROW(registry.createSink("Sample")->activateOptions(options({})), sink::ConfigurationError);
+    ASSERT_THROW(registry.createSink("Sample")->activateOptions(options({ { "probability", "1.5" } })), sink::ConfigurationError);
+    ASSERT_THROW(registry.createSink("Sample")->activateOptions(options({ { "every", "2" }, { "probability", "0.5" } })), sink::ConfigurationError);
+    ASSERT_NO_THROW(registry.createSink("Sample")->activateOptions(options({ { "probability", "0.25" } })));
+
+    ASSERT_THROW(registry.createSink("Dedup")->activateOptions(sink::Options {}), sink::ConfigurationError);
+    ASSERT_NO_THROW(registry.createSink("Dedup")->activateOptions(options({})));
+}
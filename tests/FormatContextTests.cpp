@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+
+#include "logpp/format/FormatContext.h"
+
+#include <string>
+
+using namespace logpp;
+
+TEST(FormatContextTests, should_reuse_thread_context)
+{
+    const char* data = nullptr;
+    {
+        auto context = FormatContext::acquireScoped();
+        auto& out    = context->out();
+
+        std::string large(FormatContext::DefaultCapacity * 2, 'a');
+        out.append(large.data(), large.data() + large.size());
+        data = out.data();
+    }
+
+    auto context = FormatContext::acquireScoped();
+    auto& out    = context->out();
+
+    ASSERT_EQ(out.size(), 0);
+    ASSERT_EQ(out.data(), data);
+    ASSERT_GE(out.capacity(), FormatContext::DefaultCapacity * 2);
+}
+
+TEST(FormatContextTests, should_create_context_when_thread_context_is_in_use)
+{
+    auto context = FormatContext::acquireScoped();
+    auto& out    = context->out();
+    out.push_back('a');
+
+    {
+        auto nested = FormatContext::acquireScoped();
+        ASSERT_NE(&*nested, &*context);
+
+        nested->out().push_back('b');
+    }
+
+    out.push_back('c');
+    ASSERT_EQ(fmt::to_string(out), "ac");
+}
+
+TEST(FormatContextTests, should_release_large_buffers_when_trimmed)
+{
+    FormatContext context;
+
+    auto& out = context.out();
+    out.resize(FormatContext::MaxRetainedCapacity * 2);
+
+    context.trim();
+
+    ASSERT_LE(context.out().capacity(), FormatContext::MaxRetainedCapacity);
+    ASSERT_GE(context.out().capacity(), FormatContext::DefaultCapacity);
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include "logpp/core/Logger.h"
+#include "logpp/sinks/file/IoUringFile.h"
+#include "logpp/sinks/file/IoUringFileSink.h"
+
+#include "TemporaryFile.h"
+
+#include <fstream>
+
+using namespace logpp;
+using namespace logpp::sink;
+
+namespace
+{
+    std::string readFile(const std::string& filePath)
+    {
+        std::ifstream ifs(filePath);
+        return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+}
+
+TEST(IoUringFileSink, should_write_events_in_order)
+{
+    static constexpr size_t Count = 10'000;
+
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+
+    // Small buffers to keep several writes in flight
+    auto sink = std::make_shared<IoUringFileSink>();
+    sink->setFormatter(std::make_shared<PatternFormatter>("%v"));
+    sink->setBufferSize(100);
+    sink->setBufferCount(3);
+    ASSERT_TRUE(sink->open(filePath));
+
+    std::string expected;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        EventLogBuffer buffer;
+        buffer.writeText(logpp::format("Test message {}", i));
+        sink->sink("IoUringFileSinkTest", LogLevel::Info, buffer);
+
+        expected += fmt::format("Test message {}\n", i);
+    }
+
+    sink->close();
+    ASSERT_EQ(readFile(filePath), expected);
+}
+
+TEST(IoUringFileSink, should_append_to_existing_file)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+
+    for (auto text : { "First", "Second" })
+    {
+        IoUringFileSink sink(filePath, std::make_shared<PatternFormatter>("%v"));
+
+        EventLogBuffer buffer;
+        buffer.writeText(text);
+        sink.sink("IoUringFileSinkTest", LogLevel::Info, buffer);
+    }
+
+    ASSERT_EQ(readFile(filePath), "First\nSecond\n");
+}
+
+TEST(IoUringFileSink, should_append_after_content_written_by_others)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+
+    IoUringFile file(filePath, 100, 3);
+    file.write("First\n", 6);
+    file.flush();
+    file.wait();
+
+    // Truncated by logrotate copytruncate, then written by another process
+    {
+        std::ofstream ofs(filePath, std::ios::trunc);
+        ofs << "Other\n";
+    }
+
+    file.write("Second\n", 7);
+    file.close();
+
+    ASSERT_EQ(readFile(filePath), "Other\nSecond\n");
+}
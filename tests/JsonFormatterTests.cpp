@@ -0,0 +1,112 @@
+#include "logpp/format/JsonFormatter.h"
+
+#include "logpp/core/Clock.h"
+#include "logpp/core/Logger.h"
+
+#include "logpp/utils/date.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace logpp;
+using namespace date;
+
+struct JsonFormatterTest : public ::testing::Test
+{
+    std::unique_ptr<JsonFormatter> formatter = std::make_unique<JsonFormatter>();
+
+    void format(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
+    {
+        m_out.clear();
+        formatter->format(name, level, buffer, m_out);
+    }
+
+    void setKeys(JsonFormatter::Keys keys)
+    {
+        formatter = std::make_unique<JsonFormatter>(std::move(keys));
+    }
+
+    std::string data() const
+    {
+        return std::string(m_out.data(), m_out.size());
+    }
+
+private:
+    fmt::memory_buffer m_out;
+};
+
+TEST_F(JsonFormatterTest, should_format_event)
+{
+    using namespace std::chrono;
+
+    auto ymd     = jan / 8 / 2021;
+    TimePoint tp = sys_days(ymd) + hours { 15 } + minutes { 20 } + seconds { 10 } + microseconds { 42007 };
+
+    EventLogBuffer buffer;
+    buffer.writeTime(tp);
+    buffer.writeText(logpp::format("Test result: {} ({})", std::string("Pass"), 0));
+
+    format("MyLogger", LogLevel::Info, buffer);
+
+    ASSERT_EQ(
+        data(),
+        fmt::format(R"json({{"ts":"2021-01-08T15:20:10.042007Z","lvl":"{}","logger":"MyLogger","msg":"Test result: Pass (0)"}})json",
+                    levelString(LogLevel::Info)));
+}
+
+TEST_F(JsonFormatterTest, should_format_fields)
+{
+    setKeys({ "", "", "", "msg", "", "" });
+
+    EventLogBuffer buffer;
+    buffer.writeText("Test message");
+    buffer.writeFields(
+        logpp::field("test_name", "should_format_fields"),
+        logpp::field("test_success", true),
+        logpp::field("count", -12),
+        logpp::field("ratio", 0.5),
+        logpp::field("invalid", std::numeric_limits<double>::quiet_NaN()));
+
+    format("", LogLevel::Info, buffer);
+
+    ASSERT_EQ(
+        data(),
+        R"json({"msg":"Test message","test_name":"should_format_fields","test_success":true,"count":-12,"ratio":0.5,"invalid":null})json");
+}
+
+TEST_F(JsonFormatterTest, should_escape_strings)
+{
+    setKeys({ "", "", "logger", "msg", "", "" });
+
+    EventLogBuffer buffer;
+    buffer.writeText("Said \"hello\"\n\tC:\\logs");
+    buffer.writeFields(logpp::field("key \"quoted\"", "a\x01"));
+
+    format("My\"Logger", LogLevel::Info, buffer);
+
+    ASSERT_EQ(
+        data(),
+        R"json({"logger":"My\"Logger","msg":"Said \"hello\"\n\tC:\\logs","key \"quoted\"":"a\u0001"})json");
+}
+
+TEST_F(JsonFormatterTest, should_format_source_location_with_custom_keys)
+{
+    JsonFormatter::Keys keys;
+    keys.time    = "";
+    keys.level   = "severity";
+    keys.logger  = "";
+    keys.message = "";
+    keys.file    = "source_file";
+    keys.line    = "source_line";
+    setKeys(keys);
+
+    EventLogBuffer buffer;
+    buffer.writeSourceLocation(SourceLocation { "my/test/directory/JsonFormatterTests.cpp", 124 });
+
+    format("", LogLevel::Error, buffer);
+
+    ASSERT_EQ(
+        data(),
+        fmt::format(R"json({{"severity":"{}","source_file":"JsonFormatterTests.cpp","source_line":124}})json", levelString(LogLevel::Error)));
+}
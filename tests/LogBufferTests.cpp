@@ -125,4 +125,21 @@ TEST(LogBuffer, should_move_and_keep_offsets_after_growing)
     ASSERT_EQ(off2.get(view), 0xBEEF);
     ASSERT_EQ(off3.get(view), 0xDEADBEEF);
     ASSERT_EQ(off4.get(view), "The beef is dead");
-}
\ No newline at end of file
+}
+TEST(LogBuffer, should_copy_assign_and_keep_offsets)
+{
+    LogBuffer<8> buffer;
+
+    auto off1 = buffer.write(static_cast<uint64_t>(0xDEADBEEF));
+    auto off2 = buffer.write("The beef is dead");
+
+    LogBuffer<8> bufferCopy;
+    bufferCopy.write("Previous content that should be overwritten");
+    bufferCopy = buffer;
+
+    LogBufferView view { bufferCopy };
+
+    ASSERT_EQ(bufferCopy.size(), buffer.size());
+    ASSERT_EQ(off1.get(view), 0xDEADBEEF);
+    ASSERT_EQ(off2.get(view), "The beef is dead");
+}
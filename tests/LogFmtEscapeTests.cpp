@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "logpp/format/LogFmtEscape.h"
+
+#include <vector>
+
+using namespace logpp;
+
+namespace
+{
+    std::vector<logfmt::SimdLevel> supportedLevels()
+    {
+        std::vector<logfmt::SimdLevel> levels { logfmt::SimdLevel::Scalar };
+        if (logfmt::simdLevel() != logfmt::SimdLevel::Scalar)
+            levels.push_back(logfmt::SimdLevel::Sse2);
+        if (logfmt::simdLevel() == logfmt::SimdLevel::Avx2)
+            levels.push_back(logfmt::SimdLevel::Avx2);
+
+        return levels;
+    }
+
+    std::string appendValue(std::string_view value)
+    {
+        fmt::memory_buffer out;
+        logfmt::appendValue(out, value);
+        return fmt::to_string(out);
+    }
+
+    std::string quoteInPlace(std::string_view value)
+    {
+        fmt::memory_buffer out;
+        out.append(std::string_view("key="));
+        out.append(value);
+
+        logfmt::quoteInPlace(out, 4);
+        return fmt::to_string(out).substr(4);
+    }
+}
+
+TEST(LogFmtEscapeTests, should_escape_values)
+{
+    struct TestCase
+    {
+        std::string_view name;
+
+        std::string_view value;
+        std::string_view expected;
+    } testCases[] = {
+        { "Empty value", "", "" },
+        { "Plain value", "value", "value" },
+        { "Value with space", "my value", "\"my value\"" },
+        { "Value with equal", "a=b", "\"a=b\"" },
+        { "Value with quote", "say \"hi\"", "\"say \\\"hi\\\"\"" },
+        { "Value with backslash", "C:\\logs", "\"C:\\\\logs\"" },
+        { "Value with newline", "line\nbreak", "\"line\\nbreak\"" },
+        { "Value with tab and carriage return", "a\tb\r", "\"a\\tb\\r\"" },
+        { "Value with control character", std::string_view("a\x01", 2), "\"a\\u0001\"" },
+        { "Value with utf-8", "caf\xc3\xa9", "caf\xc3\xa9" },
+    };
+
+    for (const auto& testCase : testCases)
+    {
+        ASSERT_EQ(appendValue(testCase.value), testCase.expected) << testCase.name;
+        ASSERT_EQ(quoteInPlace(testCase.value), testCase.expected) << testCase.name;
+        ASSERT_EQ(logfmt::needsQuoting(testCase.value), testCase.value != testCase.expected) << testCase.name;
+    }
+}
+
+TEST(LogFmtEscapeTests, should_find_characters_at_any_position)
+{
+    const std::string_view specials[] = { " ", "=", "\"", "\\", "\n", "\x7f" };
+
+    for (auto level : supportedLevels())
+    {
+        for (size_t size : { 1, 15, 16, 17, 31, 32, 33, 64, 100 })
+        {
+            for (size_t pos = 0; pos < size; ++pos)
+            {
+                for (auto special : specials)
+                {
+                    std::string value(size, 'a');
+                    value[pos] = special[0];
+
+                    auto quotable = logfmt::details::findQuotable(level, value.data(), value.size());
+                    ASSERT_EQ(quotable, pos) << "level " << static_cast<int>(level) << " size " << size;
+
+                    auto escapable         = logfmt::details::findEscapable(level, value.data(), value.size());
+                    auto expectedEscapable = (special == " " || special == "=") ? size : pos;
+                    ASSERT_EQ(escapable, expectedEscapable) << "level " << static_cast<int>(level) << " size " << size;
+                }
+            }
+
+            std::string value(size, '\xe9');
+            ASSERT_EQ(logfmt::details::findQuotable(level, value.data(), value.size()), size);
+        }
+    }
+}
+
+TEST(LogFmtEscapeTests, should_escape_large_values_in_place)
+{
+    std::string value;
+    std::string expected = "\"";
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        value += "some text ";
+        expected += "some text ";
+        if (i % 7 == 0)
+        {
+            value += "\"quoted\"\n";
+            expected += "\\\"quoted\\\"\\n";
+        }
+    }
+    expected += "\"";
+
+    ASSERT_EQ(appendValue(value), expected);
+    ASSERT_EQ(quoteInPlace(value), expected);
+}
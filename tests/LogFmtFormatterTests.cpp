@@ -170,3 +170,18 @@ TEST_F(LogFmtFormatterTest, should_format_constant_fields)
 
     ASSERT_EQ(data(), fmt::format("lvl={} region=eu-west-3", levelString(LogLevel::Info)));
 }
+
+TEST_F(LogFmtFormatterTest, should_escape_values)
+{
+    setPattern("msg=%v%f");
+
+    EventLogBuffer buffer;
+    buffer.writeText("Said \"hello\"\non two lines");
+    buffer.writeFields(
+        logpp::field("path", "C:\\logs"),
+        logpp::field("query", "a=b"));
+
+    format("", LogLevel::Info, buffer);
+
+    ASSERT_EQ(data(), "msg=\"Said \\\"hello\\\"\\non two lines\" path=\"C:\\\\logs\" query=\"a=b\"");
+}
@@ -3,6 +3,9 @@
 #include "logpp/core/LoggerRegistry.h"
 #include "logpp/sinks/Sink.h"
 
+#include <future>
+#include <thread>
+
 using namespace logpp;
 
 class NoopSink : public sink::Sink
@@ -97,3 +100,175 @@ TEST(LoggerRegistry, should_retrieve_child_logger)
     auto logger = registry.get("My.Namespace.Class");
     ASSERT_EQ(logger, childLogger);
 }
+
+TEST(LoggerRegistry, should_return_same_logger_when_retrieved_again)
+{
+    LoggerRegistry registry;
+    auto parentLogger = createLogger("My.Namespace");
+    ASSERT_TRUE(registry.registerLogger(parentLogger));
+
+    auto logger = registry.get("My.Namespace.Class");
+    ASSERT_EQ(registry.get("My.Namespace.Class"), logger);
+    ASSERT_EQ(registry.get("My.Namespace.Class"), parentLogger);
+}
+
+TEST(LoggerRegistry, should_retrieve_child_of_retrieved_logger_without_locking)
+{
+    LoggerRegistry registry;
+    auto parentLogger = createLogger("My.Namespace");
+    ASSERT_TRUE(registry.registerLogger(parentLogger));
+
+    ASSERT_EQ(registry.get("My.Namespace"), parentLogger);
+    ASSERT_EQ(registry.get("My.Namespace.Class"), parentLogger);
+
+    // Retrieve the child again from another thread, while the registry is locked
+    std::promise<std::shared_ptr<Logger>> retrieved;
+    auto future = retrieved.get_future();
+
+    std::thread reader;
+    bool ready = false;
+    registry.forEachLogger([&](const std::string& name, const std::shared_ptr<Logger>&) {
+        if (name != "My.Namespace")
+            return;
+
+        reader = std::thread([&] {
+            retrieved.set_value(registry.get("My.Namespace.Class"));
+        });
+        ready = future.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    });
+
+    reader.join();
+    ASSERT_TRUE(ready);
+    ASSERT_EQ(future.get(), parentLogger);
+}
+
+TEST(LoggerRegistry, should_resolve_child_again_after_registering_logger)
+{
+    LoggerRegistry registry;
+    auto parentLogger = createLogger("My.Namespace");
+    ASSERT_TRUE(registry.registerLogger(parentLogger));
+
+    ASSERT_EQ(registry.get("My.Namespace"), parentLogger);
+    ASSERT_EQ(registry.get("My.Namespace.Class"), parentLogger);
+
+    auto childLogger = createLogger("My.Namespace.Class");
+    ASSERT_TRUE(registry.registerLogger(childLogger));
+    ASSERT_EQ(registry.get("My.Namespace.Class"), childLogger);
+}
+
+TEST(LoggerRegistry, should_return_default_logger)
+{
+    LoggerRegistry registry;
+    ASSERT_NE(registry.defaultLogger(), nullptr);
+
+    auto defaultLogger = createLogger("Default");
+    registry.setDefaultLogger(defaultLogger);
+    ASSERT_EQ(registry.defaultLogger(), defaultLogger);
+
+    auto otherLogger = createLogger("Other");
+    registry.setDefaultLogger(otherLogger);
+    ASSERT_EQ(registry.defaultLogger(), otherLogger);
+}
+
+TEST(LoggerRegistry, should_not_share_cached_loggers_between_registries)
+{
+    LoggerRegistry first;
+    LoggerRegistry second;
+
+    auto firstLogger  = createLogger("TestLogger");
+    auto secondLogger = createLogger("TestLogger");
+    ASSERT_TRUE(first.registerLogger(firstLogger, true));
+    ASSERT_TRUE(second.registerLogger(secondLogger, true));
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(first.get("TestLogger"), firstLogger);
+        ASSERT_EQ(second.get("TestLogger"), secondLogger);
+
+        ASSERT_EQ(first.defaultLogger(), firstLogger);
+        ASSERT_EQ(second.defaultLogger(), secondLogger);
+    }
+}
+
+TEST(LoggerRegistry, should_keep_default_logger_of_each_registry)
+{
+    LoggerRegistry first;
+    LoggerRegistry second;
+
+    auto firstLogger  = createLogger("First");
+    auto secondLogger = createLogger("Second");
+    first.setDefaultLogger(firstLogger);
+    second.setDefaultLogger(secondLogger);
+
+    auto logger = first.defaultLogger();
+    second.defaultLogger();
+    ASSERT_EQ(logger, firstLogger);
+
+    {
+        Epoch::Guard guard;
+        ASSERT_EQ(first.guardedDefaultLogger(), firstLogger.get());
+        ASSERT_EQ(second.guardedDefaultLogger(), secondLogger.get());
+    }
+}
+
+TEST(LoggerRegistry, should_replace_default_logger_when_setting_default_logger_func)
+{
+    LoggerRegistry registry;
+    auto defaultLogger = createLogger("Default");
+    registry.setDefaultLogger(defaultLogger);
+
+    auto factoryLogger = createLogger("Factory");
+    registry.setDefaultLoggerFunc([=](std::string) {
+        return factoryLogger;
+    });
+
+    ASSERT_EQ(registry.defaultLogger(), factoryLogger);
+    ASSERT_EQ(registry.get("Any"), factoryLogger);
+
+    Epoch::Guard guard;
+    ASSERT_EQ(registry.guardedDefaultLogger(), factoryLogger.get());
+}
+
+TEST(LoggerRegistry, should_retrieve_loggers_from_multiple_threads)
+{
+    static constexpr size_t Threads = 8;
+    static constexpr size_t Names   = 64;
+    static constexpr size_t Rounds  = 100;
+
+    LoggerRegistry registry;
+    ASSERT_TRUE(registry.registerLogger(createLogger("My.Namespace")));
+
+    std::vector<std::vector<std::shared_ptr<Logger>>> loggers(Threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < Threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (size_t round = 0; round < Rounds; ++round)
+            {
+                for (size_t i = 0; i < Names; ++i)
+                {
+                    auto logger = registry.get(fmt::format("Component{}", i));
+                    if (round == 0)
+                        loggers[t].push_back(logger);
+                    else if (loggers[t][i] != logger)
+                        loggers[t][i] = nullptr;
+                }
+
+                registry.get("My.Namespace.Class");
+                registry.defaultLogger();
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < Names; ++i)
+    {
+        auto logger = registry.get(fmt::format("Component{}", i));
+        ASSERT_NE(logger, nullptr);
+
+        for (size_t t = 0; t < Threads; ++t)
+            ASSERT_EQ(loggers[t][i], logger);
+    }
+}
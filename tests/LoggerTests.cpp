@@ -322,3 +322,101 @@ TEST_F(LoggerTest, should_log_big_message_with_fields)
     auto* entry = checkEntry(message, LogLevel::Info);
     checkField(entry, "message_size",  message.size());
 }
+
+TEST_F(LoggerTest, should_log_formatted_message)
+{
+    std::string formatStr = "Formatted message {} {}";
+    char mutableFormatStr[] = "Formatted mutable message {} {}";
+
+    logger->info(logpp::format("Formatted literal message {} {}", 42, std::string("text")));
+    logger->info(logpp::format(formatStr, 42, "text"));
+    logger->info(logpp::format(mutableFormatStr, 42, "text"));
+
+    checkEntry("Formatted literal message 42 text", LogLevel::Info);
+    checkEntry("Formatted message 42 text", LogLevel::Info);
+    checkEntry("Formatted mutable message 42 text", LogLevel::Info);
+}
+
+namespace
+{
+    class RecordingVisitor final : public LogFieldVisitor
+    {
+    public:
+        void visitStart(size_t count) override
+        {
+            m_fields.push_back(fmt::format("start:{}", count));
+        }
+
+#define DEFINE_VISIT(ValueType)                                          \
+    void visit(std::string_view key, ValueType value) override           \
+    {                                                                    \
+        m_fields.push_back(fmt::format("{}:{}={}", #ValueType, key, value)); \
+    }
+
+        DEFINE_VISIT(std::string_view)
+        DEFINE_VISIT(char)
+        DEFINE_VISIT(uint8_t)
+        DEFINE_VISIT(uint16_t)
+        DEFINE_VISIT(uint32_t)
+        DEFINE_VISIT(uint64_t)
+        DEFINE_VISIT(int8_t)
+        DEFINE_VISIT(int16_t)
+        DEFINE_VISIT(int32_t)
+        DEFINE_VISIT(int64_t)
+        DEFINE_VISIT(bool)
+        DEFINE_VISIT(float)
+        DEFINE_VISIT(double)
+
+#undef DEFINE_VISIT
+
+        void visitEnd() override
+        {
+            m_fields.push_back("end");
+        }
+
+        const std::vector<std::string>& fields() const
+        {
+            return m_fields;
+        }
+
+    private:
+        std::vector<std::string> m_fields;
+    };
+}
+
+TEST(LogFieldVisitorTest, should_visit_fields_statically_as_through_virtual_calls)
+{
+    std::string str = "string";
+
+    EventLogBuffer buffer;
+    buffer.writeFields(
+        logpp::field("str", str),
+        logpp::field("literal", "literal"),
+        logpp::field("char", 'c'),
+        logpp::field("u8", uint8_t { 8 }),
+        logpp::field("u16", uint16_t { 16 }),
+        logpp::field("u32", uint32_t { 32 }),
+        logpp::field("u64", uint64_t { 64 }),
+        logpp::field("i8", int8_t { -8 }),
+        logpp::field("i16", int16_t { -16 }),
+        logpp::field("i32", int32_t { -32 }),
+        logpp::field("i64", int64_t { -64 }),
+        logpp::field("bool", true),
+        logpp::field("float", 1.5f),
+        logpp::field("double", 2.5),
+        logpp::field("int", 17),
+        logpp::field("unsigned", 18u),
+        logpp::field("size", size_t { 19 }),
+        logpp::field("view", std::string_view("view")),
+        logpp::field("short", short { 20 }),
+        logpp::field("last", 21));
+
+    RecordingVisitor virtualVisitor;
+    buffer.visitFields(virtualVisitor);
+
+    RecordingVisitor staticVisitor;
+    buffer.visitFieldsStatic(staticVisitor);
+
+    ASSERT_EQ(virtualVisitor.fields().size(), 22);
+    ASSERT_EQ(staticVisitor.fields(), virtualVisitor.fields());
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include "logpp/sinks/file/MmapFileSink.h"
+#include "logpp/utils/file.h"
+
+#include "TemporaryFile.h"
+
+#include <fstream>
+
+#if defined(LOGPP_HAS_MMAP_FILE)
+
+using namespace logpp;
+using namespace logpp::sink;
+
+namespace
+{
+    std::string readFile(const std::string& filePath)
+    {
+        std::ifstream ifs(filePath);
+        return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+
+    void sinkText(Sink& sink, std::string_view text)
+    {
+        EventLogBuffer buffer;
+        buffer.writeText(text);
+        sink.sink("MmapFileSinkTest", LogLevel::Info, buffer);
+    }
+}
+
+TEST(MmapFileSink, should_truncate_file_to_content_when_closed)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+
+    for (auto text : { "First", "Second" })
+    {
+        MmapFileSink sink(filePath, std::make_shared<PatternFormatter>("%v"));
+        sinkText(sink, text);
+        sink.close();
+    }
+
+    ASSERT_EQ(readFile(filePath), "First\nSecond\n");
+}
+
+TEST(MmapFileSink, should_write_across_chunks)
+{
+    static constexpr size_t Count = 10'000;
+
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+
+    MmapFileSink sink;
+    sink.setFormatter(std::make_shared<PatternFormatter>("%v"));
+    sink.setChunkSize(1);
+    ASSERT_TRUE(sink.open(filePath));
+
+    std::string expected;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        auto text = fmt::format("Test message {}", i);
+        sinkText(sink, text);
+
+        expected += text;
+        expected += '\n';
+    }
+
+    sink.close();
+    ASSERT_EQ(readFile(filePath), expected);
+}
+
+TEST(MmapFileSink, should_roll_at_chunk_boundaries)
+{
+    auto directory = createTemporaryDirectory();
+
+    RemoveDirectoryOnExit rmDir(directory);
+
+    auto filePath = fmt::format("{}/test.log", directory);
+
+    MmapFileSink sink;
+    sink.setFormatter(std::make_shared<PatternFormatter>("%v"));
+    sink.setChunkSize(1);
+    sink.setRolling(RollBySize { 1 }, ArchiveIncremental {});
+    ASSERT_TRUE(sink.open(filePath));
+
+    // The rolling threshold is rounded up to a page
+    const std::string text(99, 'a');
+    const auto chunkSize = MmapFile(1).chunkSize();
+    const auto perFile   = chunkSize / (text.size() + 1);
+
+    for (size_t i = 0; i < perFile + 1; ++i)
+        sinkText(sink, text);
+
+    sink.close();
+
+    auto archivePath = fmt::format("{}.0", filePath);
+    ASSERT_TRUE(file_utils::exists(archivePath));
+    ASSERT_EQ(readFile(archivePath).size(), perFile * (text.size() + 1));
+    ASSERT_EQ(readFile(filePath), text + '\n');
+}
+
+#endif
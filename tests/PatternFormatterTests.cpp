@@ -8,12 +8,21 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 using namespace logpp;
 using namespace date;
 
+namespace
+{
+    constexpr char DateTimePattern[] = "%Y-%m-%d %H:%M:%S.%i%u [%l] %v";
+    constexpr char FullPattern[]     = "%+";
+    constexpr char LocationPattern[] = "%p:%o (%t)";
+}
+
 struct PatternFormatterTest : public ::testing::Test
 {
-    std::unique_ptr<PatternFormatter> formatter;
+    std::shared_ptr<Formatter> formatter;
 
     void format(std::string_view name, LogLevel level, const EventLogBuffer& buffer)
     {
@@ -22,7 +31,18 @@ struct PatternFormatterTest : public ::testing::Test
 
     void setPattern(std::string pattern)
     {
-        formatter = std::make_unique<PatternFormatter>(std::move(pattern));
+        formatter = std::make_shared<PatternFormatter>(std::move(pattern));
+    }
+
+    template <const char* Pattern>
+    void compilePattern()
+    {
+        formatter = PatternFormatter::compile<Pattern>();
+    }
+
+    void clear()
+    {
+        m_out.clear();
     }
 
     std::string_view data() const
@@ -64,6 +84,93 @@ TEST_F(PatternFormatterTest, should_format_time)
     ASSERT_EQ(data(), "15:20:10");
 }
 
+TEST_F(PatternFormatterTest, should_render_timestamp_again_when_second_changes)
+{
+    using namespace std::chrono;
+    setPattern("%H:%M:%S.%i");
+
+    auto time    = make_time(hours { 15 } + minutes { 20 } + seconds { 10 });
+    TimePoint tp = TimePoint { seconds(time) };
+
+    auto formatAt = [&](TimePoint eventTime) {
+        EventLogBuffer buffer;
+        buffer.writeTime(eventTime);
+
+        clear();
+        format("", LogLevel::Debug, buffer);
+        return std::string(data());
+    };
+
+    ASSERT_EQ(formatAt(tp + milliseconds { 100 }), "15:20:10.100");
+    ASSERT_EQ(formatAt(tp + milliseconds { 250 }), "15:20:10.250");
+    ASSERT_EQ(formatAt(tp + seconds { 1 } + milliseconds { 5 }), "15:20:11.005");
+    ASSERT_EQ(formatAt(tp + hours { 1 }), "16:20:10.000");
+}
+
+TEST_F(PatternFormatterTest, should_cache_timestamps_per_formatter_and_thread)
+{
+    using namespace std::chrono;
+    setPattern("%H:%M:%S");
+    auto other = std::make_shared<PatternFormatter>("%Y-%m-%d");
+
+    auto time    = make_time(hours { 15 } + minutes { 20 } + seconds { 10 });
+    TimePoint tp = sys_days(jan / 8 / 2021) + seconds(time);
+
+    auto formatWith = [&](Formatter& f, TimePoint eventTime) {
+        EventLogBuffer buffer;
+        buffer.writeTime(eventTime);
+
+        fmt::memory_buffer out;
+        f.format("", LogLevel::Debug, buffer, out);
+        return fmt::to_string(out);
+    };
+
+    std::vector<std::thread> threads;
+    std::atomic<size_t> mismatches { 0 };
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto eventTime = tp + seconds { (i / 10) * t };
+                auto expected  = date::format("%H:%M:%S", floor<seconds>(eventTime));
+                if (formatWith(*formatter, eventTime) != expected)
+                    ++mismatches;
+                if (formatWith(*other, tp) != "2021-01-08")
+                    ++mismatches;
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(mismatches.load(), 0);
+}
+
+TEST_F(PatternFormatterTest, should_format_local_time)
+{
+    using namespace std::chrono;
+    setPattern("%L%Y-%m-%d %H:%M:%S.%i");
+
+    auto ymd     = jan / 8 / 2021;
+    TimePoint tp = sys_days(ymd) + hours { 15 } + minutes { 20 } + seconds { 10 } + milliseconds { 42 };
+
+    EventLogBuffer buffer;
+    buffer.writeTime(tp);
+
+    format("", LogLevel::Debug, buffer);
+
+    auto tt = Clock::to_time_t(tp);
+    std::tm tm;
+    date_utils::localtime(&tt, &tm);
+
+    ASSERT_EQ(
+        data(),
+        fmt::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}.042",
+                    tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec));
+}
+
 TEST_F(PatternFormatterTest, should_format_text)
 {
     setPattern("%v");
@@ -159,3 +266,51 @@ TEST_F(PatternFormatterTest, should_format_full)
         data(),
         fmt::format("2021-01-08 15:20:10 [{}] (MyLogger) Test result: Pass (0)", levelString(LogLevel::Info)));
 }
+
+TEST_F(PatternFormatterTest, should_format_compiled_pattern)
+{
+    using namespace std::chrono;
+    compilePattern<DateTimePattern>();
+
+    auto ymd     = jan / 8 / 2021;
+    TimePoint tp = sys_days(ymd) + hours { 15 } + minutes { 20 } + seconds { 10 } + milliseconds { 42 } + microseconds { 7 };
+
+    EventLogBuffer buffer;
+    buffer.writeTime(tp);
+    buffer.writeText(logpp::format("Test result: {} ({})", std::string("Pass"), 0));
+
+    format("MyLogger", LogLevel::Info, buffer);
+
+    ASSERT_EQ(
+        data(),
+        fmt::format("2021-01-08 15:20:10.042007 [{}] Test result: Pass (0)", levelString(LogLevel::Info)));
+}
+
+TEST_F(PatternFormatterTest, should_format_compiled_pattern_like_runtime_pattern)
+{
+    using namespace std::chrono;
+
+    auto ymd     = dec / 31 / 1999;
+    TimePoint tp = sys_days(ymd) + hours { 23 } + minutes { 59 } + seconds { 59 } + milliseconds { 999 };
+
+    EventLogBuffer buffer;
+    buffer.writeTime(tp);
+    buffer.writeSourceLocation(SourceLocation { "my/test/directory/PatternFormatterTests.cpp", 124 });
+    buffer.writeText(logpp::format("Test result: {} ({})", std::string("Pass"), 0));
+
+    auto check = [&](std::string pattern, auto compile) {
+        setPattern(pattern);
+        format("MyLogger", LogLevel::Warning, buffer);
+        auto expected = std::string(data());
+        clear();
+
+        compile();
+        format("MyLogger", LogLevel::Warning, buffer);
+        ASSERT_EQ(data(), expected) << pattern;
+        clear();
+    };
+
+    check(FullPattern, [this] { compilePattern<FullPattern>(); });
+    check(DateTimePattern, [this] { compilePattern<DateTimePattern>(); });
+    check(LocationPattern, [this] { compilePattern<LocationPattern>(); });
+}
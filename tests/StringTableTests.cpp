@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+
+#include "logpp/core/EventLogBuffer.h"
+#include "logpp/core/Logger.h"
+#include "logpp/core/StringTable.h"
+#include "logpp/format/PatternFormatter.h"
+
+#include <thread>
+#include <vector>
+
+using namespace logpp;
+
+TEST(StringTableTests, should_intern_strings_once)
+{
+    StringTable table;
+
+    auto first  = table.intern("first");
+    auto second = table.intern("second");
+
+    ASSERT_NE(first, StringTable::InvalidId);
+    ASSERT_NE(second, StringTable::InvalidId);
+    ASSERT_NE(first, second);
+
+    ASSERT_EQ(table.intern(std::string("first")), first);
+    ASSERT_EQ(table.find("second"), second);
+    ASSERT_EQ(table.find("third"), std::nullopt);
+
+    ASSERT_EQ(table.get(first), "first");
+    ASSERT_EQ(table.get(second), "second");
+    ASSERT_EQ(table.get(StringTable::InvalidId), "");
+    ASSERT_EQ(table.size(), 2);
+}
+
+TEST(StringTableTests, should_return_invalid_id_when_full)
+{
+    StringTable table(2);
+
+    auto first  = table.intern("first");
+    auto second = table.intern("second");
+
+    ASSERT_EQ(table.intern("third"), StringTable::InvalidId);
+    ASSERT_EQ(table.intern("first"), first);
+    ASSERT_EQ(table.intern("second"), second);
+    ASSERT_EQ(table.size(), 2);
+}
+
+TEST(StringTableTests, should_intern_across_chunks)
+{
+    static constexpr size_t Count = 5000;
+
+    StringTable table(Count);
+
+    std::vector<StringId> ids;
+    for (size_t i = 0; i < Count; ++i)
+        ids.push_back(table.intern(fmt::format("string_{}", i)));
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        ASSERT_EQ(table.get(ids[i]), fmt::format("string_{}", i));
+        ASSERT_EQ(table.intern(fmt::format("string_{}", i)), ids[i]);
+    }
+}
+
+TEST(StringTableTests, should_intern_concurrently)
+{
+    static constexpr size_t Threads = 4;
+    static constexpr size_t Count   = 2000;
+
+    StringTable table(Threads * Count);
+
+    std::vector<std::vector<StringId>> ids(Threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < Threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < Count; ++i)
+                ids[t].push_back(table.intern(fmt::format("string_{}", i)));
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < Count; ++i)
+    {
+        for (size_t t = 1; t < Threads; ++t)
+            ASSERT_EQ(ids[t][i], ids[0][i]);
+
+        ASSERT_EQ(table.get(ids[0][i]), fmt::format("string_{}", i));
+    }
+}
+
+TEST(StringTableTests, should_write_interned_strings_as_ids)
+{
+    EventLogBuffer interned;
+    interned.writeText(logpp::format(LOGPP_INTERN("Interned text with a fairly long format string {}"), 42));
+    interned.writeFields(logpp::field(LOGPP_INTERN("interned_key"), 1));
+
+    std::string key = "interned_key";
+
+    EventLogBuffer copied;
+    copied.writeText(logpp::format(std::string_view("Interned text with a fairly long format string {}"), 42));
+    copied.writeFields(logpp::field(key, 1));
+
+    ASSERT_LT(interned.size(), copied.size());
+
+    PatternFormatter formatter("%v - %f");
+
+    fmt::memory_buffer internedOut;
+    formatter.format("StringTableTests", LogLevel::Info, interned, internedOut);
+
+    fmt::memory_buffer copiedOut;
+    formatter.format("StringTableTests", LogLevel::Info, copied, copiedOut);
+
+    ASSERT_EQ(fmt::to_string(internedOut), "Interned text with a fairly long format string 42 - interned_key=1");
+    ASSERT_EQ(fmt::to_string(internedOut), fmt::to_string(copiedOut));
+}
+
+TEST(StringTableTests, should_not_intern_strings_implicitly)
+{
+    Logger logger("StringTableTests.NotInterned", LogLevel::Info, nullptr);
+
+    ASSERT_FALSE(StringTable::instance().find(logger.name()).has_value());
+}
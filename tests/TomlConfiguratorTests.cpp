@@ -39,6 +39,23 @@ namespace
         }
     };
 
+    // Keeps the options it has been configured with
+    class OptionsSink : public sink::Sink
+    {
+    public:
+        static constexpr std::string_view Name = "OptionsSink";
+
+        void activateOptions(const sink::Options& opts) override
+        {
+            options = opts;
+        }
+
+        void sink(std::string_view, LogLevel, const EventLogBuffer&) override
+        { }
+
+        sink::Options options;
+    };
+
     template <typename... Checks>
     void checkLogger(LoggerRegistry& registry, std::string_view name, Checks&&... checks)
     {
@@ -429,3 +446,96 @@ TEST(TomlConfigurator, should_expand_environment_variable_from_file)
     checkLogger(registry, "My.Namespace.Class", HasLevel(LogLevel::Debug), HasSink<sink::FileSink>());
     checkLogger(registry, "My.Other", HasLevel(LogLevel::Debug), HasSink<sink::ColoredOutputConsole>());
 }
+
+TEST(TomlConfigurator, should_configure_call_site_rules)
+{
+    static constexpr auto Config = R"TOML(
+        [sinks]
+        [sinks.console]
+           type = "ColoredOutputConsole"
+
+        [loggers]
+        [loggers.default]
+           name = "default"
+           sinks = [ "console" ]
+           level = "info"
+           default = true
+
+        [[call_sites]]
+           file = "net/Server.cpp"
+
+        [[call_sites]]
+           file = "net/Server.cpp"
+           line = 42
+           state = "disabled"
+    )TOML"sv;
+
+    LoggerRegistry registry;
+    auto err = TomlConfigurator::configure(Config, registry);
+    ASSERT_FALSE(err) << *err;
+
+    auto rules = CallSiteRegistry::instance().rules();
+    ASSERT_EQ(rules.size(), 2);
+
+    ASSERT_EQ(rules[0].file, "net/Server.cpp");
+    ASSERT_FALSE(rules[0].line);
+    ASSERT_EQ(rules[0].state, CallSiteState::Enabled);
+
+    ASSERT_EQ(rules[1].line, 42);
+    ASSERT_EQ(rules[1].state, CallSiteState::Disabled);
+
+    CallSiteRegistry::instance().clearRules();
+}
+
+TEST(TomlConfigurator, should_error_on_unknown_call_site_state)
+{
+    static constexpr auto Config = R"TOML(
+        [sinks]
+        [sinks.console]
+           type = "ColoredOutputConsole"
+
+        [loggers]
+        [loggers.default]
+           name = "default"
+           sinks = [ "console" ]
+           level = "info"
+
+        [[call_sites]]
+           file = "net/Server.cpp"
+           state = "verbose"
+    )TOML"sv;
+
+    LoggerRegistry registry;
+    ASSERT_TRUE(TomlConfigurator::configure(Config, registry));
+}
+
+TEST(TomlConfigurator, should_keep_precision_of_float_sink_options)
+{
+    static constexpr auto Config = R"TOML(
+        [sinks]
+        [sinks.options]
+           type = "OptionsSink"
+           options = { probability = 1e-7, ratio = 0.1, sizes = [ 2.5e-9 ] }
+    )TOML"sv;
+
+    LoggerRegistry registry;
+    registry.registerSinkFactory<OptionsSink>();
+
+    auto err = TomlConfigurator::configure(Config, registry);
+    ASSERT_FALSE(err) << *err;
+
+    auto sink = std::dynamic_pointer_cast<OptionsSink>(registry.findSink("options"));
+    ASSERT_TRUE(sink);
+
+    auto probability = sink->options.tryGet("probability");
+    ASSERT_TRUE(probability);
+    ASSERT_EQ(std::stod(*probability->asString()), 1e-7);
+
+    auto ratio = sink->options.tryGet("ratio");
+    ASSERT_TRUE(ratio);
+    ASSERT_EQ(std::stod(*ratio->asString()), 0.1);
+
+    auto sizes = sink->options.tryGet("sizes");
+    ASSERT_TRUE(sizes);
+    ASSERT_EQ(std::stod(sizes->asArray()->at(0)), 2.5e-9);
+}